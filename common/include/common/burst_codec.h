@@ -0,0 +1,54 @@
+// Burst Codec - Delta/varint compression for IMPACT_BURST chunks
+// The wearable quantizes samples to int16 counts (IMPACT_BURST_xxx_LSB) and
+// packs as many as fit into one chunk: the first sample verbatim, the rest as
+// zigzag-mapped per-channel deltas in LEB128 varints. Slowly changing signals
+// take 1 byte per channel instead of 2. Shared by the wearable (encode) and
+// the hub firmware / BeagleBoard daemon (decode).
+
+#ifndef _BURST_CODEC_H_
+#define _BURST_CODEC_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "protocol.h"
+
+// Header bytes sent before data[] in every chunk
+#define BURST_HEADER_SIZE offsetof(impact_burst_t, data)
+
+/**
+ * Quantize one sample to burst counts (saturating)
+ * @param accel Acceleration x, y, z (m/s²)
+ * @param gyro Angular rate x, y, z (rad/s)
+ * @param out Counts in channel order ax, ay, az, gx, gy, gz
+ */
+void burst_quantize(const float accel[3], const float gyro[3], int16_t out[IMPACT_BURST_CHANNELS]);
+
+/**
+ * Convert burst counts back to SI units
+ * @param counts Counts in channel order
+ * @param accel Output acceleration (m/s²)
+ * @param gyro Output angular rate (rad/s)
+ */
+void burst_dequantize(const int16_t counts[IMPACT_BURST_CHANNELS], float accel[3], float gyro[3]);
+
+/**
+ * Pack samples into a chunk's base/samples/data_len/data fields
+ * @param samples Quantized samples
+ * @param count Number of samples available
+ * @param chunk Chunk to fill (header fields other than base/samples/data_len untouched)
+ * @return Samples packed (at least 1 if count > 0, at most 255)
+ */
+int burst_encode(const int16_t (*samples)[IMPACT_BURST_CHANNELS], int count, impact_burst_t *chunk);
+
+/**
+ * Unpack a received chunk
+ * @param chunk Chunk payload
+ * @param len Payload bytes received
+ * @param out Output samples
+ * @param max Capacity of out
+ * @return Samples decoded, or -1 if the chunk is malformed or out is too small
+ */
+int burst_decode(const impact_burst_t *chunk, size_t len,
+                 int16_t (*out)[IMPACT_BURST_CHANNELS], int max);
+
+#endif // _BURST_CODEC_H_
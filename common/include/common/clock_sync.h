@@ -0,0 +1,96 @@
+// Clock Sync - NTP-style offset and drift estimate for one ESP-NOW peer
+// The hub sends TIME_SYNC with its send time t0; the wearable echoes it with
+// its receive time t1 and reply time t2; the hub notes the arrival time t3.
+// Each exchange gives an offset sample ((t1 - t0) + (t2 - t3)) / 2 and a
+// round trip (t3 - t0) - (t2 - t1). The estimate anchors on the window's
+// fastest exchange (least queuing, so the least asymmetric) and extrapolates
+// with the drift fitted over the window's clean exchanges. Used by the ESP32
+// hub firmware, one estimate per paired wearable.
+
+#ifndef _CLOCK_SYNC_H_
+#define _CLOCK_SYNC_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Exchanges kept for the estimate
+#define CLOCK_SYNC_WINDOW 32
+
+// Exchanges slower than the fastest in the window by more than this are
+// left out of the drift fit (queued behind other traffic)
+#define CLOCK_SYNC_MAX_EXTRA_DELAY_US 2000
+
+// Minimum span of the fitted exchanges before drift is estimated
+#define CLOCK_SYNC_MIN_DRIFT_SPAN_US 10000000LL
+
+// One exchange
+typedef struct {
+    int64_t local_us;       // Local midpoint of the exchange
+    int64_t offset_us;      // Remote minus local clock
+    int64_t delay_us;       // Round trip without the remote's turnaround
+} clock_sync_sample_t;
+
+typedef struct {
+    clock_sync_sample_t samples[CLOCK_SYNC_WINDOW];
+    int count;
+    int next;
+    bool valid;                 // At least one exchange accepted
+    int64_t ref_local_us;       // Anchor exchange (fastest in the window)
+    int64_t ref_offset_us;
+    double drift;               // Remote seconds gained per local second
+    int64_t last_delay_us;
+    uint32_t exchanges;
+    uint32_t rejected;          // Inconsistent timestamps
+} clock_sync_t;
+
+/**
+ * Initialize an estimator
+ * @param cs Estimator
+ */
+void clock_sync_init(clock_sync_t *cs);
+
+/**
+ * Add one exchange and update the estimate
+ * @param cs Estimator
+ * @param t0_us Local send time
+ * @param t1_us Remote receive time
+ * @param t2_us Remote reply time
+ * @param t3_us Local receive time
+ * @return true if accepted (round trip in cs->last_delay_us)
+ */
+bool clock_sync_add(clock_sync_t *cs, int64_t t0_us, int64_t t1_us, int64_t t2_us, int64_t t3_us);
+
+/**
+ * Estimated remote minus local clock at a local time
+ * @param cs Estimator
+ * @param local_us Local time
+ * @return Offset (us), 0 before the first exchange
+ */
+int64_t clock_sync_offset(const clock_sync_t *cs, int64_t local_us);
+
+/**
+ * Convert a remote time to the local clock
+ * @param cs Estimator
+ * @param remote_us Remote time
+ * @return Local time
+ */
+int64_t clock_sync_to_local(const clock_sync_t *cs, int64_t remote_us);
+
+/**
+ * Convert a 32-bit remote millis() timestamp (e.g. sensor_data_t::timestamp)
+ * to the local clock, resolving its wrap against the present
+ * @param cs Estimator
+ * @param remote_ms Remote timestamp (ms, wraps after ~49 days)
+ * @param local_now_us Local time close to when the timestamp was taken
+ * @return Local time (us)
+ */
+int64_t clock_sync_remote_ms_to_local(const clock_sync_t *cs, uint32_t remote_ms, int64_t local_now_us);
+
+/**
+ * Get the drift estimate
+ * @param cs Estimator
+ * @return Remote clock rate error relative to the local clock (ppm)
+ */
+float clock_sync_drift_ppm(const clock_sync_t *cs);
+
+#endif // _CLOCK_SYNC_H_
@@ -0,0 +1,198 @@
+// Deferred Log - Compile-time filtered binary logging for radio hot paths
+// DLOG_xxx(fmt, ...) below the build's DLOG_LEVEL compiles to nothing. Enabled
+// calls store a fixed-size record (32-bit FNV-1a hash of the format string,
+// timestamp, up to DLOG_MAX_ARGS 32-bit arguments) in a lock-free ring; no
+// formatting or UART output happens at the call site. loop() drains the ring
+// with dlog_flush() as compact binary frames, decoded on the host by
+// common/tools/dlog_decode.cpp, or with dlog_flush_text() when a readable
+// serial monitor matters more than UART time. Shared by the wearable and the
+// ESP32 hub firmware.
+//
+// Arguments are integers (stored as 32 bits) and floats; strings are not
+// supported. Format strings must be literals so the decoder can find them in
+// the sources.
+
+#ifndef _DLOG_H_
+#define _DLOG_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+
+// Levels (DLOG_LEVEL selects the highest one compiled in)
+#define DLOG_LEVEL_NONE     0
+#define DLOG_LEVEL_ERROR    1
+#define DLOG_LEVEL_WARN     2
+#define DLOG_LEVEL_INFO     3
+#define DLOG_LEVEL_DEBUG    4
+
+#ifndef DLOG_LEVEL
+#define DLOG_LEVEL DLOG_LEVEL_INFO
+#endif
+
+// Records buffered between flushes (power of two)
+#ifndef DLOG_RING_SIZE
+#define DLOG_RING_SIZE 64
+#endif
+
+#define DLOG_MAX_ARGS 4
+
+// Binary frame: magic, header (id, time, seq, level << 4 | argc, lost), argc
+// words, XOR checksum of header and words
+#define DLOG_FRAME_MAGIC0   0xD1
+#define DLOG_FRAME_MAGIC1   0x06
+#define DLOG_FRAME_HEADER   12
+#define DLOG_FRAME_MAX      (2 + DLOG_FRAME_HEADER + DLOG_MAX_ARGS * 4 + 1)
+
+typedef struct {
+    uint32_t id;                    // FNV-1a hash of the format string
+    uint32_t time_us;               // Capture time (wraps after ~71 minutes)
+    uint16_t seq;                   // Ring position; gaps mean frames lost on the wire
+    uint8_t level;                  // DLOG_LEVEL_xxx
+    uint8_t argc;
+    uint8_t lost;                   // Records dropped (ring full) just before this one
+    uint32_t args[DLOG_MAX_ARGS];   // Integers, or float bit patterns
+    const char *fmt;                // Format string (device-side text output only)
+} dlog_record_t;
+
+// Ring counters
+typedef struct {
+    uint32_t written;
+    uint32_t dropped;               // Ring full at the call site
+    uint32_t flushed;
+} dlog_stats_t;
+
+// Output callback for dlog_flush()/dlog_flush_text()
+typedef void (*dlog_sink_t)(const uint8_t *data, size_t len);
+
+/**
+ * Hash a format string (FNV-1a, evaluated at compile time by DLOG_xxx)
+ * @param s Format string
+ * @param h Running hash
+ * @return 32-bit hash
+ */
+constexpr uint32_t dlog_hash(const char *s, uint32_t h = 2166136261u)
+{
+    return (*s != '\0') ? dlog_hash(s + 1, (h ^ (uint8_t)*s) * 16777619u) : h;
+}
+
+/**
+ * Store one record (lock-free, callable from any task or callback)
+ * @param level DLOG_LEVEL_xxx
+ * @param id Format string hash
+ * @param fmt Format string
+ * @param args Argument words
+ * @param argc Number of arguments (at most DLOG_MAX_ARGS)
+ * @return true if stored, false if the ring was full (counted as dropped)
+ */
+bool dlog_write(uint8_t level, uint32_t id, const char *fmt, const uint32_t *args, int argc);
+
+/**
+ * Drain records as binary frames (single consumer, e.g. loop())
+ * @param sink Output for each frame
+ * @param max Maximum records to drain
+ * @return Records drained
+ */
+int dlog_flush(dlog_sink_t sink, int max);
+
+/**
+ * Drain records as formatted text lines (single consumer)
+ * @param sink Output for each line
+ * @param max Maximum records to drain
+ * @return Records drained
+ */
+int dlog_flush_text(dlog_sink_t sink, int max);
+
+/**
+ * Encode a record as a binary frame
+ * @param record Record
+ * @param out Buffer of at least DLOG_FRAME_MAX bytes
+ * @return Frame length
+ */
+size_t dlog_encode(const dlog_record_t *record, uint8_t *out);
+
+/**
+ * Decode a binary frame starting at the magic bytes
+ * @param data Bytes
+ * @param len Bytes available
+ * @param record Output record (fmt is NULL)
+ * @return Frame length, 0 if more bytes are needed, -1 if this is not a valid frame
+ */
+int dlog_decode(const uint8_t *data, size_t len, dlog_record_t *record);
+
+/**
+ * Format a record as one text line ("   12.345678 WARN  message\n")
+ * @param record Record
+ * @param fmt Its format string, or NULL if unknown
+ * @param out Output buffer
+ * @param size Buffer size
+ * @return Length written (truncated to size - 1)
+ */
+int dlog_format(const dlog_record_t *record, const char *fmt, char *out, size_t size);
+
+/**
+ * Get ring counters
+ * @param stats Pointer to store the counters
+ */
+void dlog_get_stats(dlog_stats_t *stats);
+
+// ===== Call-site helpers =====
+
+static inline uint32_t dlog_word(float value)
+{
+    uint32_t word;
+    memcpy(&word, &value, sizeof(word));
+    return word;
+}
+
+static inline uint32_t dlog_word(double value)
+{
+    return dlog_word((float)value);
+}
+
+template <typename T>
+static inline uint32_t dlog_word(T value)
+{
+    static_assert(std::is_integral<T>::value || std::is_enum<T>::value,
+                  "dlog arguments must be integers or floats");
+    return (uint32_t)value;  // 'long' is 64-bit on the host; values are truncated
+}
+
+template <typename... Args>
+static inline void dlog_emit(uint8_t level, uint32_t id, const char *fmt, Args... args)
+{
+    static_assert(sizeof...(Args) <= DLOG_MAX_ARGS, "too many dlog arguments");
+    const uint32_t words[sizeof...(Args) + 1] = { dlog_word(args)..., 0 };
+    dlog_write(level, id, fmt, words, (int)sizeof...(Args));
+}
+
+// Forces the hash to a compile-time constant
+#define DLOG_ID(fmt) (std::integral_constant<uint32_t, dlog_hash(fmt)>::value)
+#define DLOG_EMIT(level, fmt, ...) dlog_emit((level), DLOG_ID(fmt), (fmt), ##__VA_ARGS__)
+
+#if DLOG_LEVEL >= DLOG_LEVEL_ERROR
+#define DLOG_ERROR(fmt, ...) DLOG_EMIT(DLOG_LEVEL_ERROR, fmt, ##__VA_ARGS__)
+#else
+#define DLOG_ERROR(fmt, ...) do { } while (0)
+#endif
+
+#if DLOG_LEVEL >= DLOG_LEVEL_WARN
+#define DLOG_WARN(fmt, ...) DLOG_EMIT(DLOG_LEVEL_WARN, fmt, ##__VA_ARGS__)
+#else
+#define DLOG_WARN(fmt, ...) do { } while (0)
+#endif
+
+#if DLOG_LEVEL >= DLOG_LEVEL_INFO
+#define DLOG_INFO(fmt, ...) DLOG_EMIT(DLOG_LEVEL_INFO, fmt, ##__VA_ARGS__)
+#else
+#define DLOG_INFO(fmt, ...) do { } while (0)
+#endif
+
+#if DLOG_LEVEL >= DLOG_LEVEL_DEBUG
+#define DLOG_DEBUG(fmt, ...) DLOG_EMIT(DLOG_LEVEL_DEBUG, fmt, ##__VA_ARGS__)
+#else
+#define DLOG_DEBUG(fmt, ...) do { } while (0)
+#endif
+
+#endif // _DLOG_H_
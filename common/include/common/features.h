@@ -0,0 +1,370 @@
+// Feature Kernels - Streaming fall-detection features over fixed windows
+// Header-only kernels templated on the window length N (samples) and the
+// sample type T (float in SI units, or int16_t counts such as quantized burst
+// samples). Each kernel keeps its window in a ring inside its state, so there
+// is no allocation, and a push costs O(1): running sums are updated with the
+// entering and leaving sample. Peaks scan the window with a loop of
+// compile-time length, which the compiler unrolls. The BeagleBoard fall
+// classifier (fall_classifier.h) takes its jerk and stillness features from
+// them; common/tools/feature_bench.cpp measures the cost per sample.
+//
+//   feature_svm_t         Signal vector magnitude |a|: window mean and peak
+//   feature_jerk_t        |a[t] - a[t-1]| per sample: window peak
+//   feature_sma_t         Signal magnitude area: mean of |x| + |y| + |z|
+//   feature_tilt_t        Angle between the mean acceleration of this window
+//                         and of the previous one (degrees)
+//   feature_still_t       Variance of |a| over the window (stillness test)
+//
+// Usage:
+//   feature_sma_t<50, float> sma;
+//   feature_sma_init(&sma);
+//   float area = feature_sma_push(&sma, ax, ay, az);
+// Results are in the sample's units. They are valid once the window has been
+// filled; before that the missing samples count as zero.
+
+#ifndef _FEATURES_H_
+#define _FEATURES_H_
+
+#include <math.h>
+#include <stdint.h>
+#include <type_traits>
+
+// Running-sum type per sample type: exact integer sums for counts
+template <typename T> struct feature_traits;
+template <> struct feature_traits<float> { typedef float accum_t; };
+template <> struct feature_traits<int16_t> { typedef int32_t accum_t; };
+
+// Window slot after 'pos' (N need not be a power of two)
+template <int N>
+static inline int feature_next(int pos)
+{
+    return (pos + 1 == N) ? 0 : pos + 1;
+}
+
+/**
+ * Signal vector magnitude of one sample
+ * @param x, y, z Axis values
+ * @return sqrt(x^2 + y^2 + z^2)
+ */
+template <typename T>
+static inline float feature_magnitude(T x, T y, T z)
+{
+    float fx = (float)x, fy = (float)y, fz = (float)z;
+    return sqrtf(fx * fx + fy * fy + fz * fz);
+}
+
+/**
+ * Largest value in a window
+ * Four independent running maxima, so the compare chain is not one long
+ * dependency and the compiler can keep them in one vector register.
+ */
+template <int N>
+static inline float feature_peak(const float *ring)
+{
+    float m[4] = { ring[0], ring[0], ring[0], ring[0] };
+    int i = 0;
+    for (; i + 4 <= N; i += 4) {
+        for (int l = 0; l < 4; l++) {
+            m[l] = (ring[i + l] > m[l]) ? ring[i + l] : m[l];
+        }
+    }
+    for (; i < N; i++) {
+        m[0] = (ring[i] > m[0]) ? ring[i] : m[0];
+    }
+    float a = (m[0] > m[1]) ? m[0] : m[1];
+    float b = (m[2] > m[3]) ? m[2] : m[3];
+    return (a > b) ? a : b;
+}
+
+// ===== Signal vector magnitude =====
+
+template <int N, typename T>
+struct feature_svm_t {
+    static_assert(N > 0, "window must hold at least one sample");
+    float ring[N];              // |a| per sample
+    float sum;
+    int pos;
+};
+
+template <int N, typename T>
+static inline void feature_svm_init(feature_svm_t<N, T> *k)
+{
+    for (int i = 0; i < N; i++) {
+        k->ring[i] = 0.0f;
+    }
+    k->sum = 0.0f;
+    k->pos = 0;
+}
+
+/**
+ * Add one sample
+ * @return Mean |a| over the window
+ */
+template <int N, typename T>
+static inline float feature_svm_push(feature_svm_t<N, T> *k, T x, T y, T z)
+{
+    float m = feature_magnitude(x, y, z);
+    k->sum += m - k->ring[k->pos];
+    k->ring[k->pos] = m;
+    k->pos = feature_next<N>(k->pos);
+    if (k->pos == 0) {
+        // Once per window: drop the rounding error the running sum collected
+        float sum = 0.0f;
+        for (int i = 0; i < N; i++) {
+            sum += k->ring[i];
+        }
+        k->sum = sum;
+    }
+    return k->sum * (1.0f / N);
+}
+
+/**
+ * Largest |a| in the window
+ */
+template <int N, typename T>
+static inline float feature_svm_peak(const feature_svm_t<N, T> *k)
+{
+    return feature_peak<N>(k->ring);
+}
+
+// ===== Jerk =====
+
+template <int N, typename T>
+struct feature_jerk_t {
+    static_assert(N > 0, "window must hold at least one sample");
+    float ring[N];              // |a[t] - a[t-1]| per sample
+    T last[3];
+    bool primed;                // A previous sample exists
+    int pos;
+};
+
+template <int N, typename T>
+static inline void feature_jerk_init(feature_jerk_t<N, T> *k)
+{
+    for (int i = 0; i < N; i++) {
+        k->ring[i] = 0.0f;
+    }
+    k->last[0] = k->last[1] = k->last[2] = 0;
+    k->primed = false;
+    k->pos = 0;
+}
+
+/**
+ * Add one sample
+ * @return |a[t] - a[t-1]| (per sample; multiply by the rate for units/s)
+ */
+template <int N, typename T>
+static inline float feature_jerk_push(feature_jerk_t<N, T> *k, T x, T y, T z)
+{
+    float j = 0.0f;
+    if (k->primed) {
+        j = feature_magnitude((float)x - (float)k->last[0], (float)y - (float)k->last[1],
+                              (float)z - (float)k->last[2]);
+    }
+    k->last[0] = x;
+    k->last[1] = y;
+    k->last[2] = z;
+    k->primed = true;
+    k->ring[k->pos] = j;
+    k->pos = feature_next<N>(k->pos);
+    return j;
+}
+
+/**
+ * Largest jerk in the window (per sample)
+ */
+template <int N, typename T>
+static inline float feature_jerk_peak(const feature_jerk_t<N, T> *k)
+{
+    return feature_peak<N>(k->ring);
+}
+
+// ===== Signal magnitude area =====
+
+template <int N, typename T>
+struct feature_sma_t {
+    static_assert(N > 0, "window must hold at least one sample");
+    typedef typename feature_traits<T>::accum_t accum_t;
+    accum_t ring[N];            // |x| + |y| + |z| per sample
+    accum_t sum;
+    int pos;
+};
+
+template <int N, typename T>
+static inline void feature_sma_init(feature_sma_t<N, T> *k)
+{
+    for (int i = 0; i < N; i++) {
+        k->ring[i] = 0;
+    }
+    k->sum = 0;
+    k->pos = 0;
+}
+
+/**
+ * Add one sample
+ * @return Mean of |x| + |y| + |z| over the window
+ */
+template <int N, typename T>
+static inline float feature_sma_push(feature_sma_t<N, T> *k, T x, T y, T z)
+{
+    typedef typename feature_traits<T>::accum_t accum_t;
+    accum_t a = (accum_t)(x < 0 ? -x : x) + (accum_t)(y < 0 ? -y : y) + (accum_t)(z < 0 ? -z : z);
+    k->sum += a - k->ring[k->pos];
+    k->ring[k->pos] = a;
+    k->pos = feature_next<N>(k->pos);
+    if (std::is_floating_point<accum_t>::value && k->pos == 0) {
+        accum_t sum = 0;
+        for (int i = 0; i < N; i++) {
+            sum += k->ring[i];
+        }
+        k->sum = sum;
+    }
+    return (float)k->sum * (1.0f / N);
+}
+
+// ===== Tilt change =====
+
+template <int N, typename T>
+struct feature_tilt_t {
+    static_assert(N > 0, "window must hold at least one sample");
+    typedef typename feature_traits<T>::accum_t accum_t;
+    T ring[2 * N][3];           // This window and the previous one
+    accum_t current[3];         // Axis sums of the last N samples
+    accum_t previous[3];        // Axis sums of the N before them
+    int pos;
+};
+
+template <int N, typename T>
+static inline void feature_tilt_init(feature_tilt_t<N, T> *k)
+{
+    for (int i = 0; i < 2 * N; i++) {
+        k->ring[i][0] = k->ring[i][1] = k->ring[i][2] = 0;
+    }
+    for (int a = 0; a < 3; a++) {
+        k->current[a] = 0;
+        k->previous[a] = 0;
+    }
+    k->pos = 0;
+}
+
+/**
+ * Add one sample
+ * @return Angle between the mean acceleration of the last N samples and
+ *         that of the N before them (degrees, 0 while either is zero)
+ */
+template <int N, typename T>
+static inline float feature_tilt_push(feature_tilt_t<N, T> *k, T x, T y, T z)
+{
+    typedef typename feature_traits<T>::accum_t accum_t;
+    // The sample leaving this window enters the previous one
+    int middle = (k->pos + N < 2 * N) ? k->pos + N : k->pos - N;
+    T *oldest = k->ring[k->pos];
+    T *moving = k->ring[middle];
+    const T in[3] = { x, y, z };
+    for (int a = 0; a < 3; a++) {
+        k->previous[a] += moving[a] - oldest[a];
+        k->current[a] += in[a] - moving[a];
+        oldest[a] = in[a];
+    }
+    k->pos = feature_next<2 * N>(k->pos);
+    if (std::is_floating_point<accum_t>::value && (k->pos == 0 || k->pos == N)) {
+        // Once per window: drop the rounding error the running sums collected
+        int start = k->pos;
+        for (int a = 0; a < 3; a++) {
+            k->previous[a] = 0;
+            k->current[a] = 0;
+        }
+        for (int i = 0; i < N; i++) {
+            for (int a = 0; a < 3; a++) {
+                k->previous[a] += k->ring[start + i][a];
+                k->current[a] += k->ring[(start + N + i) % (2 * N)][a];
+            }
+        }
+    }
+
+    float c[3], p[3];
+    for (int a = 0; a < 3; a++) {
+        c[a] = (float)k->current[a];
+        p[a] = (float)k->previous[a];
+    }
+    float dot = c[0] * p[0] + c[1] * p[1] + c[2] * p[2];
+    float norms = sqrtf((c[0] * c[0] + c[1] * c[1] + c[2] * c[2]) *
+                        (p[0] * p[0] + p[1] * p[1] + p[2] * p[2]));
+    if (norms <= 0.0f) {
+        return 0.0f;
+    }
+    float cosine = dot / norms;
+    cosine = (cosine > 1.0f) ? 1.0f : (cosine < -1.0f ? -1.0f : cosine);
+    return acosf(cosine) * 57.29578f;
+}
+
+// ===== Stillness =====
+
+template <int N, typename T>
+struct feature_still_t {
+    static_assert(N > 1, "variance needs at least two samples");
+    float ring[N];              // |a| per sample
+    float mean;
+    float m2;                   // Sum of squared deviations from the mean
+    int pos;
+};
+
+template <int N, typename T>
+static inline void feature_still_init(feature_still_t<N, T> *k)
+{
+    for (int i = 0; i < N; i++) {
+        k->ring[i] = 0.0f;
+    }
+    k->mean = 0.0f;
+    k->m2 = 0.0f;
+    k->pos = 0;
+}
+
+/**
+ * Add one sample (sliding Welford update, stable for small variances
+ * around a large mean such as gravity)
+ * @return Variance of |a| over the window
+ */
+template <int N, typename T>
+static inline float feature_still_push(feature_still_t<N, T> *k, T x, T y, T z)
+{
+    float in = feature_magnitude(x, y, z);
+    float out = k->ring[k->pos];
+    k->ring[k->pos] = in;
+    k->pos = feature_next<N>(k->pos);
+
+    float mean = k->mean + (in - out) * (1.0f / N);
+    k->m2 += (in - out) * (in - mean + out - k->mean);
+    k->mean = mean;
+    if (k->pos == 0) {
+        // Once per window: recompute both from the samples (two passes)
+        float sum = 0.0f;
+        for (int i = 0; i < N; i++) {
+            sum += k->ring[i];
+        }
+        k->mean = sum * (1.0f / N);
+        float m2 = 0.0f;
+        for (int i = 0; i < N; i++) {
+            float d = k->ring[i] - k->mean;
+            m2 += d * d;
+        }
+        k->m2 = m2;
+    }
+    if (k->m2 < 0.0f) {
+        k->m2 = 0.0f;
+    }
+    return k->m2 * (1.0f / N);
+}
+
+/**
+ * Whether the window is still
+ * @param k Kernel
+ * @param max_variance Largest variance of |a| that counts as still
+ */
+template <int N, typename T>
+static inline bool feature_still(const feature_still_t<N, T> *k, float max_variance)
+{
+    return k->m2 * (1.0f / N) <= max_variance;
+}
+
+#endif // _FEATURES_H_
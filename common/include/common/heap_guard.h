@@ -0,0 +1,31 @@
+// Heap Guard - Detect heap allocations on hot-path threads after warm-up
+// A thread calls heap_guard_arm() once its pools and tables are set up; every
+// later heap allocation on that thread is counted as a violation. operator new
+// is always hooked; with glibc, malloc/calloc/realloc are hooked as well.
+// Building with -DHEAP_GUARD_STRICT aborts on the first violation instead.
+//
+// Linux only: on ESP32 the functions are no-ops (the Wi-Fi stack allocates
+// internally); track pool failures and minimum free heap there instead.
+
+#ifndef _HEAP_GUARD_H_
+#define _HEAP_GUARD_H_
+
+#include <stdint.h>
+
+/**
+ * Arm the guard for the calling thread (call after warm-up)
+ */
+void heap_guard_arm(void);
+
+/**
+ * Disarm the guard for the calling thread
+ */
+void heap_guard_disarm(void);
+
+/**
+ * Number of heap allocations made by armed threads
+ * @return Violation count (always 0 on ESP32)
+ */
+uint32_t heap_guard_violations(void);
+
+#endif // _HEAP_GUARD_H_
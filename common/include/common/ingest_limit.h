@@ -0,0 +1,107 @@
+// Ingest Limit - Per-peer token buckets and load shedding at frame ingestion
+// Decides, before a received frame takes a queue slot, whether the hub
+// accepts it:
+//   - alerts (FALL_DETECTED, IMPACT_BURST, USER_RESPONSE) are always admitted
+//     and take no tokens
+//   - every other frame takes one token from its peer's bucket, which holds
+//     up to 'burst' frames and refills at 'rate_per_s'. With the bucket empty
+//     SENSOR_DATA is downsampled (one frame in 'downsample' still gets
+//     through, so the hub keeps a coarse view of the peer) and other frames
+//     are shed.
+//   - while the caller reports the hub saturated (e.g. its receive queue is
+//     down to the slots kept for alerts), every non-alert frame from every
+//     peer is shed, so only alerts can take the reserved slots
+// A misbehaving wearable thus only loses its own excess traffic, and a burst
+// from many wearables costs sensor samples rather than alerts. Tokens are
+// integer micro-frames over caller-supplied microseconds; the peer table is
+// fixed, with one shared bucket for peers beyond it. One thread decides;
+// counters may be read from another.
+
+#ifndef _INGEST_LIMIT_H_
+#define _INGEST_LIMIT_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Peers with their own bucket (later peers share the overflow bucket)
+#define INGEST_LIMIT_MAX_PEERS 16
+
+typedef struct {
+    uint32_t rate_per_s;        // Sustained frames per second per peer
+    uint32_t burst;             // Bucket depth (frames)
+    uint16_t downsample;        // Over budget: keep one SENSOR_DATA in this many (0 = shed all)
+} ingest_limit_config_t;
+
+// Frame counters
+typedef struct {
+    uint32_t admitted;          // All admitted frames, alerts included
+    uint32_t alerts;            // Admitted alert frames
+    uint32_t downsampled;       // SENSOR_DATA admitted over budget (one in 'downsample')
+    uint32_t shed_budget;       // Shed because the peer's bucket was empty
+    uint32_t shed_saturated;    // Non-alert frames shed because the hub was saturated
+} ingest_limit_counts_t;
+
+typedef struct {
+    bool used;
+    uint8_t mac[6];
+    uint64_t tokens;            // Micro-frames available
+    uint64_t last_us;           // Time of the last refill
+    uint16_t skipped;           // Excess SENSOR_DATA since the last downsampled one
+    ingest_limit_counts_t counts;
+} ingest_peer_t;
+
+typedef struct {
+    ingest_limit_config_t config;
+    ingest_peer_t peers[INGEST_LIMIT_MAX_PEERS];
+    ingest_peer_t overflow;     // Shared by peers beyond the table
+    ingest_limit_counts_t total;
+} ingest_limit_t;
+
+/**
+ * Default limits: 120 frames/s per peer (100 Hz SENSOR_DATA plus control
+ * traffic), bursts of 60, one in 4 frames kept over budget
+ * @param config Limits to fill in
+ */
+void ingest_limit_default_config(ingest_limit_config_t *config);
+
+/**
+ * Reset all buckets and counters
+ * @param limit Limiter state
+ * @param config Limits (NULL for the defaults)
+ */
+void ingest_limit_init(ingest_limit_t *limit, const ingest_limit_config_t *config);
+
+/**
+ * Whether a packet type is an alert (never shed)
+ * @param type PKT_xxx
+ */
+bool ingest_limit_is_alert(uint8_t type);
+
+/**
+ * Decide on one received frame
+ * @param limit Limiter state
+ * @param mac Sender MAC
+ * @param type PKT_xxx
+ * @param now_us Current time (microseconds, monotonic)
+ * @param saturated true while the hub cannot keep up
+ * @return true to accept the frame, false to shed it
+ */
+bool ingest_limit_admit(ingest_limit_t *limit, const uint8_t mac[6], uint8_t type,
+                        uint64_t now_us, bool saturated);
+
+/**
+ * Per-peer state for reports
+ * @param limit Limiter state
+ * @param index 0 to INGEST_LIMIT_MAX_PEERS-1, or INGEST_LIMIT_MAX_PEERS for the overflow bucket
+ * @return Peer, or NULL if the slot is unused
+ */
+const ingest_peer_t *ingest_limit_peer(const ingest_limit_t *limit, int index);
+
+/**
+ * Copy the totals over all peers
+ * @param limit Limiter state
+ * @param counts Output counters
+ */
+void ingest_limit_get_totals(const ingest_limit_t *limit, ingest_limit_counts_t *counts);
+
+#endif // _INGEST_LIMIT_H_
@@ -0,0 +1,55 @@
+// Latency Histogram - Fixed-size log-linear latency distribution
+// Each power of two is split into 2^LATENCY_SUB_BITS linear buckets, so any
+// recorded latency is known to within 12.5% from 8 us to ~16 s in 704 bytes,
+// with O(1) insertion and no allocation. Percentiles report the upper edge of
+// their bucket (capped at the largest value seen), so they never understate
+// a latency bound. Used by the ESP32 hub firmware and the wearable host
+// simulator (wearable-sensor-module/host).
+
+#ifndef _LATENCY_HIST_H_
+#define _LATENCY_HIST_H_
+
+#include <stdint.h>
+
+#define LATENCY_SUB_BITS 3
+#define LATENCY_MAX_EXP 23          // Largest tracked power of two (values above share the top bucket)
+#define LATENCY_BUCKETS ((LATENCY_MAX_EXP - LATENCY_SUB_BITS + 2) << LATENCY_SUB_BITS)
+
+typedef struct {
+    uint32_t counts[LATENCY_BUCKETS];
+    uint32_t count;
+    uint32_t negative;          // Recorded as 0 (e.g. clock offset error)
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t sum_us;
+} latency_hist_t;
+
+/**
+ * Initialize (empty) a histogram
+ * @param hist Histogram
+ */
+void latency_hist_init(latency_hist_t *hist);
+
+/**
+ * Record one latency
+ * @param hist Histogram
+ * @param latency_us Latency (negative values count as 0 and in hist->negative)
+ */
+void latency_hist_add(latency_hist_t *hist, int64_t latency_us);
+
+/**
+ * Latency below which a fraction of the recorded values fall
+ * @param hist Histogram
+ * @param fraction 0.0 to 1.0 (e.g. 0.99)
+ * @return Upper bucket edge (us), 0 if empty
+ */
+uint32_t latency_hist_percentile(const latency_hist_t *hist, float fraction);
+
+/**
+ * Mean of the recorded latencies
+ * @param hist Histogram
+ * @return Mean (us), 0 if empty
+ */
+uint32_t latency_hist_mean(const latency_hist_t *hist);
+
+#endif // _LATENCY_HIST_H_
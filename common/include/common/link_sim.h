@@ -0,0 +1,141 @@
+// Link Simulator - Lossy ESP-NOW link model for host builds
+// Stands in for the radio between a wearable and the hub when their logic
+// runs on Linux. Each frame handed to link_sim_send() goes through:
+//   - loss: a two-state (Gilbert-Elliott) channel; the good state loses
+//     frames independently, the bad state models fades and interference
+//     bursts. Each transmission attempt also moves the channel state.
+//   - MAC retries: a lost attempt is retransmitted up to 'retries' times,
+//     each adding 'retry_us', as ESP-NOW unicast does before the send
+//     callback reports failure
+//   - delay: base latency plus uniform jitter; a 'reorder' fraction of frames
+//     is held back an extra 'reorder_us', so later frames overtake them
+//   - duplication: a 'duplicate' fraction of delivered frames arrives twice
+//     (the receiver's ACK was lost, so the sender retransmitted)
+// Time is supplied by the caller (virtual or real microseconds) and all
+// randomness comes from the seed, so a run is reproducible. No allocation:
+// frames in flight live in the link's fixed queue.
+
+#ifndef _LINK_SIM_H_
+#define _LINK_SIM_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "protocol.h"
+
+// Frames in flight per link (a full queue refuses sends, like the radio's TX queue)
+#define LINK_SIM_QUEUE_SIZE 64
+
+typedef struct {
+    float loss;                 // Per-attempt loss in the good state (0..1)
+    float burst_enter;          // Good -> bad transition probability per attempt
+    float burst_exit;           // Bad -> good transition probability per attempt
+    float burst_loss;           // Per-attempt loss in the bad state
+    uint8_t retries;            // Retransmissions after a lost attempt
+    uint32_t retry_us;          // Added per retransmission
+    uint32_t delay_us;          // Base one-way latency
+    uint32_t jitter_us;         // Uniform extra latency 0..jitter_us
+    float reorder;              // Fraction of frames held back
+    uint32_t reorder_us;        // Extra latency of a held-back frame
+    float duplicate;            // Fraction of delivered frames received twice
+} link_sim_config_t;
+
+// Delivery details of a received frame
+typedef struct {
+    uint64_t sent_us;           // link_sim_send() time
+    uint64_t deliver_us;        // Arrival time (may be before the receive call)
+    uint32_t seq;               // Send order (equal for a duplicate and its original)
+    uint8_t attempts;           // Transmissions until it got through
+    bool duplicate;
+} link_sim_info_t;
+
+typedef struct {
+    uint32_t sent;              // Frames handed to link_sim_send()
+    uint32_t delivered;         // Frames received (duplicates included)
+    uint32_t lost;              // Frames lost after all retries
+    uint32_t retransmissions;
+    uint32_t duplicates;
+    uint32_t reordered;         // Frames received after a later-sent frame
+    uint32_t refused;           // Sends refused (queue full or frame too long)
+    uint32_t burst_attempts;    // Attempts made in the bad state
+    uint64_t bytes_sent;
+    uint64_t bytes_delivered;   // Unique frames only
+} link_sim_stats_t;
+
+typedef struct {
+    bool used;
+    uint16_t len;
+    link_sim_info_t info;
+    uint8_t data[PROTOCOL_ESPNOW_MAX_FRAME];
+} link_sim_slot_t;
+
+typedef struct {
+    link_sim_config_t config;
+    uint32_t rng;
+    bool bad_state;
+    uint32_t next_seq;
+    uint32_t highest_received;  // Highest seq received + 1
+    link_sim_slot_t queue[LINK_SIM_QUEUE_SIZE];
+    link_sim_stats_t stats;
+} link_sim_t;
+
+/**
+ * Lossless defaults (2 ms latency, no jitter, 3 retries of 1 ms)
+ * @param config Parameters to fill in
+ */
+void link_sim_default_config(link_sim_config_t *config);
+
+/**
+ * Update parameters from "key=value,..." (loss, burst_enter, burst_exit,
+ * burst_loss, retries, retry_us, delay_us, jitter_us, reorder, reorder_us,
+ * duplicate), e.g. "loss=0.05,burst_enter=0.01,burst_exit=0.2,jitter_us=3000"
+ * @param config Parameters to update (unchanged keys keep their values)
+ * @param spec Specification
+ * @return true if every key was known and its value valid
+ */
+bool link_sim_parse(link_sim_config_t *config, const char *spec);
+
+/**
+ * Initialize a link (one direction)
+ * @param sim Link to initialize
+ * @param config Parameters, or NULL for the defaults
+ * @param seed Random seed
+ */
+void link_sim_init(link_sim_t *sim, const link_sim_config_t *config, uint32_t seed);
+
+/**
+ * Send one frame
+ * @param sim Link
+ * @param now_us Current time
+ * @param data Frame (PKT type byte + payload)
+ * @param len Frame length (at most PROTOCOL_ESPNOW_MAX_FRAME)
+ * @return Send-callback status: true if an attempt got through, false if
+ *         lost after all retries or refused
+ */
+bool link_sim_send(link_sim_t *sim, uint64_t now_us, const uint8_t *data, size_t len);
+
+/**
+ * Receive the earliest frame that has arrived by now_us
+ * @param sim Link
+ * @param now_us Current time
+ * @param out Frame buffer (PROTOCOL_ESPNOW_MAX_FRAME bytes)
+ * @param info Delivery details (may be NULL)
+ * @return Frame length, or 0 if nothing has arrived
+ */
+size_t link_sim_receive(link_sim_t *sim, uint64_t now_us, uint8_t *out, link_sim_info_t *info);
+
+/**
+ * Arrival time of the earliest frame in flight
+ * @param sim Link
+ * @return Time, or UINT64_MAX if nothing is in flight
+ */
+uint64_t link_sim_next_arrival(const link_sim_t *sim);
+
+/**
+ * Get link counters
+ * @param sim Link
+ * @param stats Pointer to store the counters
+ */
+void link_sim_get_stats(const link_sim_t *sim, link_sim_stats_t *stats);
+
+#endif // _LINK_SIM_H_
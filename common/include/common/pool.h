@@ -0,0 +1,88 @@
+// Fixed-Block Pool - Allocation without heap use on hot paths
+// Blocks come from caller-provided static storage and are recycled through a
+// lock-free free list, so frames, windows and snapshots can be allocated from
+// ISR-adjacent callbacks (ESP-NOW receive task) or worker threads without
+// malloc/free, heap fragmentation or lock contention. Shared by the ESP32 hub
+// firmware and the BeagleBoard daemon.
+
+#ifndef _POOL_H_
+#define _POOL_H_
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+// Maximum blocks per pool (indices are 16-bit)
+#define POOL_MAX_BLOCKS 0xFFFE
+
+typedef struct {
+    uint8_t *storage;               // block_count * block_size bytes
+    uint16_t *links;                // Free-list next index per block
+    size_t block_size;              // Rounded up to pointer alignment
+    uint16_t block_count;
+    std::atomic<uint32_t> head;     // (tag << 16) | index of first free block
+    std::atomic<uint32_t> allocs;
+    std::atomic<uint32_t> frees;
+    std::atomic<uint32_t> failures; // Allocations refused because the pool was empty
+    std::atomic<uint32_t> in_use;
+    std::atomic<uint32_t> high_water;
+} pool_t;
+
+// Counter snapshot
+typedef struct {
+    uint32_t allocs;
+    uint32_t frees;
+    uint32_t failures;
+    uint32_t in_use;
+    uint32_t high_water;
+    uint16_t block_count;
+} pool_stats_t;
+
+// Round a block size up so every block is pointer-aligned
+#define POOL_BLOCK_SIZE(size) \
+    (((size) + sizeof(void *) - 1) / sizeof(void *) * sizeof(void *))
+
+// Define static storage and a pool for 'count' objects of 'type'
+// Usage: POOL_DEFINE(frame_pool, hub_frame_t, 32); then pool_init_##name()
+#define POOL_DEFINE(name, type, count)                                          \
+    static_assert((count) <= POOL_MAX_BLOCKS, "pool too large");                \
+    alignas(void *) static uint8_t name##_storage[(count) * POOL_BLOCK_SIZE(sizeof(type))]; \
+    static uint16_t name##_links[(count)];                                       \
+    static pool_t name;                                                          \
+    static inline void pool_init_##name(void)                                    \
+    {                                                                            \
+        pool_init(&name, name##_storage, name##_links, sizeof(type), (count));   \
+    }
+
+/**
+ * Initialize a pool over caller-provided storage
+ * @param pool Pool to initialize
+ * @param storage count * POOL_BLOCK_SIZE(block_size) bytes, pointer-aligned
+ * @param links count entries of link storage
+ * @param block_size Size of one object
+ * @param count Number of blocks (at most POOL_MAX_BLOCKS)
+ */
+void pool_init(pool_t *pool, void *storage, uint16_t *links, size_t block_size, uint16_t count);
+
+/**
+ * Take a block from the pool (lock-free, O(1))
+ * @param pool Pool
+ * @return Block, or NULL if the pool is exhausted (counted in failures)
+ */
+void *pool_alloc(pool_t *pool);
+
+/**
+ * Return a block to the pool (lock-free, O(1))
+ * @param pool Pool the block came from
+ * @param block Block from pool_alloc() (NULL is ignored)
+ */
+void pool_free(pool_t *pool, void *block);
+
+/**
+ * Read the pool counters
+ * @param pool Pool
+ * @param stats Output counters
+ */
+void pool_get_stats(const pool_t *pool, pool_stats_t *stats);
+
+#endif // _POOL_H_
@@ -0,0 +1,103 @@
+// Burst Codec - Delta/varint compression for IMPACT_BURST chunks
+#include "common/burst_codec.h"
+#include <math.h>
+#include <string.h>
+
+// Worst case per sample: 6 channels x 3 bytes (17-bit delta, zigzagged)
+#define MAX_SAMPLE_BYTES (IMPACT_BURST_CHANNELS * 3)
+
+static int16_t to_counts(float value, float lsb)
+{
+    float counts = roundf(value / lsb);
+    if (counts > 32767.0f) return 32767;
+    if (counts < -32768.0f) return -32768;
+    return (int16_t)counts;
+}
+
+void burst_quantize(const float accel[3], const float gyro[3], int16_t out[IMPACT_BURST_CHANNELS])
+{
+    for (int i = 0; i < 3; i++) {
+        out[i] = to_counts(accel[i], IMPACT_BURST_ACCEL_LSB);
+        out[3 + i] = to_counts(gyro[i], IMPACT_BURST_GYRO_LSB);
+    }
+}
+
+void burst_dequantize(const int16_t counts[IMPACT_BURST_CHANNELS], float accel[3], float gyro[3])
+{
+    for (int i = 0; i < 3; i++) {
+        accel[i] = counts[i] * IMPACT_BURST_ACCEL_LSB;
+        gyro[i] = counts[3 + i] * IMPACT_BURST_GYRO_LSB;
+    }
+}
+
+int burst_encode(const int16_t (*samples)[IMPACT_BURST_CHANNELS], int count, impact_burst_t *chunk)
+{
+    if (count <= 0) {
+        chunk->samples = 0;
+        chunk->data_len = 0;
+        return 0;
+    }
+    memcpy(chunk->base, samples[0], sizeof(chunk->base));
+
+    int len = 0;
+    int n = 1;
+    while (n < count && n < 255) {
+        uint8_t bytes[MAX_SAMPLE_BYTES];
+        int used = 0;
+        for (int c = 0; c < IMPACT_BURST_CHANNELS; c++) {
+            int32_t delta = (int32_t)samples[n][c] - (int32_t)samples[n - 1][c];
+            uint32_t zz = ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31);
+            while (zz >= 0x80) {
+                bytes[used++] = (uint8_t)(zz | 0x80);
+                zz >>= 7;
+            }
+            bytes[used++] = (uint8_t)zz;
+        }
+        if (len + used > IMPACT_BURST_DATA_MAX) {
+            break;
+        }
+        memcpy(chunk->data + len, bytes, used);
+        len += used;
+        n++;
+    }
+
+    chunk->samples = (uint8_t)n;
+    chunk->data_len = (uint8_t)len;
+    return n;
+}
+
+int burst_decode(const impact_burst_t *chunk, size_t len,
+                 int16_t (*out)[IMPACT_BURST_CHANNELS], int max)
+{
+    if (len < BURST_HEADER_SIZE || chunk->data_len > IMPACT_BURST_DATA_MAX ||
+        len < BURST_HEADER_SIZE + chunk->data_len || chunk->samples > max) {
+        return -1;
+    }
+    if (chunk->samples == 0) {
+        return 0;
+    }
+    memcpy(out[0], chunk->base, sizeof(chunk->base));
+
+    const uint8_t *p = chunk->data;
+    const uint8_t *end = chunk->data + chunk->data_len;
+    for (int n = 1; n < chunk->samples; n++) {
+        for (int c = 0; c < IMPACT_BURST_CHANNELS; c++) {
+            uint32_t zz = 0;
+            int shift = 0;
+            while (true) {
+                if (p >= end || shift > 14) {
+                    return -1;
+                }
+                uint8_t byte = *p++;
+                zz |= (uint32_t)(byte & 0x7F) << shift;
+                shift += 7;
+                if ((byte & 0x80) == 0) {
+                    break;
+                }
+            }
+            int32_t delta = (int32_t)(zz >> 1) ^ -(int32_t)(zz & 1);
+            out[n][c] = (int16_t)(out[n - 1][c] + delta);
+        }
+    }
+    return chunk->samples;
+}
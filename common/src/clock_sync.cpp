@@ -0,0 +1,102 @@
+// Clock Sync - NTP-style offset and drift estimate for one ESP-NOW peer
+#include "common/clock_sync.h"
+#include <string.h>
+
+void clock_sync_init(clock_sync_t *cs)
+{
+    memset(cs, 0, sizeof(*cs));
+}
+
+// Re-anchor on the fastest exchange and fit drift over those close to it
+static void update_estimate(clock_sync_t *cs)
+{
+    int best = 0;
+    for (int i = 1; i < cs->count; i++) {
+        if (cs->samples[i].delay_us < cs->samples[best].delay_us) {
+            best = i;
+        }
+    }
+    const clock_sync_sample_t *ref = &cs->samples[best];
+    cs->ref_local_us = ref->local_us;
+    cs->ref_offset_us = ref->offset_us;
+
+    // Least squares slope of offset over local time, relative to the anchor
+    // so the sums stay small enough for doubles
+    double sx = 0.0, sy = 0.0, sxx = 0.0, sxy = 0.0;
+    int64_t first = INT64_MAX, last = INT64_MIN;
+    int n = 0;
+    for (int i = 0; i < cs->count; i++) {
+        const clock_sync_sample_t *s = &cs->samples[i];
+        if (s->delay_us > ref->delay_us + CLOCK_SYNC_MAX_EXTRA_DELAY_US) {
+            continue;
+        }
+        double x = (double)(s->local_us - ref->local_us);
+        double y = (double)(s->offset_us - ref->offset_us);
+        sx += x;
+        sy += y;
+        sxx += x * x;
+        sxy += x * y;
+        if (s->local_us < first) first = s->local_us;
+        if (s->local_us > last) last = s->local_us;
+        n++;
+    }
+
+    if (n < 3 || last - first < CLOCK_SYNC_MIN_DRIFT_SPAN_US) {
+        return;  // Keep the previous drift
+    }
+    double denom = n * sxx - sx * sx;
+    if (denom > 0.0) {
+        cs->drift = (n * sxy - sx * sy) / denom;
+    }
+}
+
+bool clock_sync_add(clock_sync_t *cs, int64_t t0_us, int64_t t1_us, int64_t t2_us, int64_t t3_us)
+{
+    int64_t delay = (t3_us - t0_us) - (t2_us - t1_us);
+    if (t3_us < t0_us || t2_us < t1_us || delay < 0) {
+        cs->rejected++;
+        return false;
+    }
+
+    clock_sync_sample_t *s = &cs->samples[cs->next];
+    s->local_us = t0_us + (t3_us - t0_us) / 2;
+    s->offset_us = ((t1_us - t0_us) + (t2_us - t3_us)) / 2;
+    s->delay_us = delay;
+    cs->next = (cs->next + 1) % CLOCK_SYNC_WINDOW;
+    if (cs->count < CLOCK_SYNC_WINDOW) {
+        cs->count++;
+    }
+
+    cs->last_delay_us = delay;
+    cs->exchanges++;
+    cs->valid = true;
+    update_estimate(cs);
+    return true;
+}
+
+int64_t clock_sync_offset(const clock_sync_t *cs, int64_t local_us)
+{
+    if (!cs->valid) {
+        return 0;
+    }
+    return cs->ref_offset_us + (int64_t)(cs->drift * (double)(local_us - cs->ref_local_us));
+}
+
+int64_t clock_sync_to_local(const clock_sync_t *cs, int64_t remote_us)
+{
+    // The offset changes by microseconds per second, so one refinement suffices
+    int64_t local = remote_us - clock_sync_offset(cs, cs->ref_local_us);
+    return remote_us - clock_sync_offset(cs, local);
+}
+
+int64_t clock_sync_remote_ms_to_local(const clock_sync_t *cs, uint32_t remote_ms, int64_t local_now_us)
+{
+    int64_t remote_now_ms = (local_now_us + clock_sync_offset(cs, local_now_us)) / 1000;
+    int32_t behind = (int32_t)((uint32_t)remote_now_ms - remote_ms);
+    return clock_sync_to_local(cs, (remote_now_ms - behind) * 1000);
+}
+
+float clock_sync_drift_ppm(const clock_sync_t *cs)
+{
+    return (float)(cs->drift * 1e6);
+}
@@ -0,0 +1,320 @@
+// Deferred Log - Compile-time filtered binary logging for radio hot paths
+#include "common/dlog.h"
+#include <atomic>
+#include <stdio.h>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <time.h>
+#endif
+
+static_assert((DLOG_RING_SIZE & (DLOG_RING_SIZE - 1)) == 0, "DLOG_RING_SIZE must be a power of two");
+
+#define RING_MASK (DLOG_RING_SIZE - 1)
+
+// Bounded MPMC ring: a slot is free for position p when its sequence is p and
+// holds the record for p when it is p + 1
+typedef struct {
+    std::atomic<uint32_t> sequence;
+    dlog_record_t record;
+} slot_t;
+
+static slot_t ring[DLOG_RING_SIZE];
+static std::atomic<uint32_t> enqueue_pos{0};
+static std::atomic<uint32_t> dequeue_pos{0};
+static std::atomic<uint32_t> lost_pending{0};   // Drops not yet reported in a record
+static std::atomic<uint32_t> written{0};
+static std::atomic<uint32_t> dropped{0};
+static std::atomic<uint32_t> flushed{0};
+
+// Slot sequences start at their index; set before any record is written
+static bool init_ring(void)
+{
+    for (uint32_t i = 0; i < DLOG_RING_SIZE; i++) {
+        ring[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    return true;
+}
+static const bool ring_ready = init_ring();
+
+static uint32_t now_us(void)
+{
+#ifdef ARDUINO
+    return (uint32_t)micros();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000);
+#endif
+}
+
+static const char *level_name(uint8_t level)
+{
+    switch (level) {
+    case DLOG_LEVEL_ERROR: return "ERROR";
+    case DLOG_LEVEL_WARN:  return "WARN ";
+    case DLOG_LEVEL_INFO:  return "INFO ";
+    case DLOG_LEVEL_DEBUG: return "DEBUG";
+    default:               return "?    ";
+    }
+}
+
+bool dlog_write(uint8_t level, uint32_t id, const char *fmt, const uint32_t *args, int argc)
+{
+    (void)ring_ready;
+
+    uint32_t pos = enqueue_pos.load(std::memory_order_relaxed);
+    slot_t *slot;
+    while (true) {
+        slot = &ring[pos & RING_MASK];
+        uint32_t sequence = slot->sequence.load(std::memory_order_acquire);
+        int32_t diff = (int32_t)(sequence - pos);
+        if (diff == 0) {
+            if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            lost_pending.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            pos = enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    dlog_record_t *r = &slot->record;
+    r->id = id;
+    r->time_us = now_us();
+    r->seq = (uint16_t)pos;
+    r->level = level;
+    r->argc = (uint8_t)(argc > DLOG_MAX_ARGS ? DLOG_MAX_ARGS : argc);
+    uint32_t lost = lost_pending.exchange(0, std::memory_order_relaxed);
+    r->lost = (uint8_t)(lost > 255 ? 255 : lost);
+    for (int i = 0; i < r->argc; i++) {
+        r->args[i] = args[i];
+    }
+    r->fmt = fmt;
+
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    written.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+// Take the oldest record (single consumer)
+static bool take(dlog_record_t *out)
+{
+    uint32_t pos = dequeue_pos.load(std::memory_order_relaxed);
+    slot_t *slot = &ring[pos & RING_MASK];
+    if (slot->sequence.load(std::memory_order_acquire) != pos + 1) {
+        return false;
+    }
+    *out = slot->record;
+    slot->sequence.store(pos + DLOG_RING_SIZE, std::memory_order_release);
+    dequeue_pos.store(pos + 1, std::memory_order_relaxed);
+    flushed.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+int dlog_flush(dlog_sink_t sink, int max)
+{
+    dlog_record_t record;
+    uint8_t frame[DLOG_FRAME_MAX];
+    int count = 0;
+    while (count < max && take(&record)) {
+        sink(frame, dlog_encode(&record, frame));
+        count++;
+    }
+    return count;
+}
+
+int dlog_flush_text(dlog_sink_t sink, int max)
+{
+    dlog_record_t record;
+    char line[160];
+    int count = 0;
+    while (count < max && take(&record)) {
+        int len = dlog_format(&record, record.fmt, line, sizeof(line));
+        sink((const uint8_t *)line, (size_t)len);
+        count++;
+    }
+    return count;
+}
+
+static void put_u32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t get_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+size_t dlog_encode(const dlog_record_t *record, uint8_t *out)
+{
+    uint8_t *p = out;
+    *p++ = DLOG_FRAME_MAGIC0;
+    *p++ = DLOG_FRAME_MAGIC1;
+    put_u32(p, record->id);
+    put_u32(p + 4, record->time_us);
+    p[8] = (uint8_t)record->seq;
+    p[9] = (uint8_t)(record->seq >> 8);
+    p[10] = (uint8_t)((record->level << 4) | record->argc);
+    p[11] = record->lost;
+    p += DLOG_FRAME_HEADER;
+    for (int i = 0; i < record->argc; i++) {
+        put_u32(p, record->args[i]);
+        p += 4;
+    }
+
+    uint8_t check = 0;
+    for (uint8_t *q = out + 2; q < p; q++) {
+        check ^= *q;
+    }
+    *p++ = check;
+    return (size_t)(p - out);
+}
+
+int dlog_decode(const uint8_t *data, size_t len, dlog_record_t *record)
+{
+    if (len < 2 + DLOG_FRAME_HEADER) {
+        return 0;
+    }
+    if (data[0] != DLOG_FRAME_MAGIC0 || data[1] != DLOG_FRAME_MAGIC1) {
+        return -1;
+    }
+    const uint8_t *h = data + 2;
+    uint8_t level = h[10] >> 4;
+    uint8_t argc = h[10] & 0x0F;
+    if (level < DLOG_LEVEL_ERROR || level > DLOG_LEVEL_DEBUG || argc > DLOG_MAX_ARGS) {
+        return -1;
+    }
+    size_t total = 2 + DLOG_FRAME_HEADER + (size_t)argc * 4 + 1;
+    if (len < total) {
+        return 0;
+    }
+
+    uint8_t check = 0;
+    for (size_t i = 2; i < total - 1; i++) {
+        check ^= data[i];
+    }
+    if (check != data[total - 1]) {
+        return -1;
+    }
+
+    record->id = get_u32(h);
+    record->time_us = get_u32(h + 4);
+    record->seq = (uint16_t)(h[8] | (h[9] << 8));
+    record->level = level;
+    record->argc = argc;
+    record->lost = h[11];
+    for (int i = 0; i < argc; i++) {
+        record->args[i] = get_u32(h + DLOG_FRAME_HEADER + i * 4);
+    }
+    record->fmt = NULL;
+    return (int)total;
+}
+
+// Format one conversion ("%-8.2f", "%lu", ...) with a 32-bit argument word
+static int format_arg(const char *spec, size_t spec_len, uint32_t word, char *out, size_t size)
+{
+    // Rebuild the spec without length modifiers; arguments are 32-bit
+    char clean[16];
+    size_t n = 0;
+    for (size_t i = 0; i < spec_len && n < sizeof(clean) - 1; i++) {
+        char c = spec[i];
+        if (c == 'l' || c == 'h' || c == 'z' || c == 'j' || c == 't' || c == 'L') {
+            continue;
+        }
+        clean[n++] = c;
+    }
+    clean[n] = '\0';
+
+    char conv = clean[n - 1];
+    switch (conv) {
+    case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A': {
+        float value;
+        memcpy(&value, &word, sizeof(value));
+        return snprintf(out, size, clean, (double)value);
+    }
+    case 'd': case 'i':
+        return snprintf(out, size, clean, (int)(int32_t)word);
+    case 'c': case 'u': case 'x': case 'X': case 'o':
+        return snprintf(out, size, clean, (unsigned)word);
+    default:
+        return snprintf(out, size, "<%%%c?>", conv);
+    }
+}
+
+int dlog_format(const dlog_record_t *record, const char *fmt, char *out, size_t size)
+{
+    if (size == 0) {
+        return 0;
+    }
+    size_t len = (size_t)snprintf(out, size, "%12.6f %s ", record->time_us / 1e6, level_name(record->level));
+    if (len >= size) {
+        return (int)(size - 1);
+    }
+
+    if (fmt == NULL) {
+        len += (size_t)snprintf(out + len, size - len, "<unknown format %08lX>",
+                                (unsigned long)record->id);
+        if (len >= size) {
+            len = size - 1;
+        }
+        for (int i = 0; i < record->argc && len < size - 1; i++) {
+            len += (size_t)snprintf(out + len, size - len, " %08lX", (unsigned long)record->args[i]);
+        }
+    } else {
+        int arg = 0;
+        const char *p = fmt;
+        while (*p != '\0' && len < size - 1) {
+            if (*p != '%') {
+                out[len++] = *p++;
+                continue;
+            }
+            if (p[1] == '%') {
+                out[len++] = '%';
+                p += 2;
+                continue;
+            }
+            // Flags, width, precision and length up to the conversion character
+            const char *start = p++;
+            while (*p != '\0' && strchr("-+ #0123456789.hlzjtL", *p) != NULL) {
+                p++;
+            }
+            if (*p == '\0') {
+                break;
+            }
+            p++;
+            if (arg < record->argc) {
+                len += (size_t)format_arg(start, (size_t)(p - start), record->args[arg++],
+                                          out + len, size - len);
+                if (len >= size) {
+                    len = size - 1;
+                }
+            }
+        }
+    }
+
+    if (len > size - 2) {
+        len = size - 2;
+    }
+    // One record per line; a trailing newline in the format is not doubled
+    if (len == 0 || out[len - 1] != '\n') {
+        out[len++] = '\n';
+    }
+    out[len] = '\0';
+    return (int)len;
+}
+
+void dlog_get_stats(dlog_stats_t *stats)
+{
+    stats->written = written.load(std::memory_order_relaxed);
+    stats->dropped = dropped.load(std::memory_order_relaxed);
+    stats->flushed = flushed.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,129 @@
+// Heap Guard - Detect heap allocations on hot-path threads after warm-up
+#include "common/heap_guard.h"
+
+#ifndef ARDUINO
+
+#include <atomic>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+
+// glibc lets the program replace malloc and friends and still reach its own
+// allocator, so C allocations (strdup, fopen, calloc, ...) are counted too
+#ifdef __GLIBC__
+#define HEAP_GUARD_C_HOOKS
+extern "C" void *__libc_malloc(size_t size);
+extern "C" void *__libc_calloc(size_t count, size_t size);
+extern "C" void *__libc_realloc(void *p, size_t size);
+#endif
+
+static thread_local bool is_armed = false;
+static std::atomic<uint32_t> violations{0};
+
+static void count_violation(size_t size)
+{
+    if (is_armed) {
+        violations.fetch_add(1, std::memory_order_relaxed);
+#ifdef HEAP_GUARD_STRICT
+        is_armed = false;   // fprintf may allocate
+        fprintf(stderr, "HeapGuard - %zu byte allocation on armed thread\n", size);
+        abort();
+#else
+        (void)size;
+#endif
+    }
+}
+
+#ifdef HEAP_GUARD_C_HOOKS
+extern "C" void *malloc(size_t size)
+{
+    count_violation(size);
+    return __libc_malloc(size);
+}
+
+extern "C" void *calloc(size_t count, size_t size)
+{
+    count_violation(count * size);
+    return __libc_calloc(count, size);
+}
+
+extern "C" void *realloc(void *p, size_t size)
+{
+    count_violation(size);
+    return __libc_realloc(p, size);
+}
+#endif
+
+static void *guarded_alloc(size_t size)
+{
+#ifndef HEAP_GUARD_C_HOOKS
+    count_violation(size);      // Otherwise counted by the malloc hook
+#endif
+    void *p = malloc(size ? size : 1);
+    if (p == NULL) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void *operator new(size_t size)
+{
+    return guarded_alloc(size);
+}
+
+void *operator new[](size_t size)
+{
+    return guarded_alloc(size);
+}
+
+void operator delete(void *p) noexcept
+{
+    free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    free(p);
+}
+
+void operator delete[](void *p, size_t) noexcept
+{
+    free(p);
+}
+
+void heap_guard_arm(void)
+{
+    is_armed = true;
+}
+
+void heap_guard_disarm(void)
+{
+    is_armed = false;
+}
+
+uint32_t heap_guard_violations(void)
+{
+    return violations.load(std::memory_order_relaxed);
+}
+
+#else
+
+void heap_guard_arm(void)
+{
+}
+
+void heap_guard_disarm(void)
+{
+}
+
+uint32_t heap_guard_violations(void)
+{
+    return 0;
+}
+
+#endif // ARDUINO
@@ -0,0 +1,121 @@
+// Ingest Limit - Per-peer token buckets and load shedding at frame ingestion
+#include "common/ingest_limit.h"
+#include "protocol.h"
+#include <string.h>
+
+// Micro-frames per frame
+#define TOKEN_UNIT 1000000ULL
+
+static const ingest_limit_config_t DEFAULT_CONFIG = {
+    120,    // rate_per_s
+    60,     // burst
+    4       // downsample
+};
+
+void ingest_limit_default_config(ingest_limit_config_t *config)
+{
+    *config = DEFAULT_CONFIG;
+}
+
+void ingest_limit_init(ingest_limit_t *limit, const ingest_limit_config_t *config)
+{
+    memset(limit, 0, sizeof(*limit));
+    limit->config = (config != NULL) ? *config : DEFAULT_CONFIG;
+    limit->overflow.used = true;
+    limit->overflow.tokens = (uint64_t)limit->config.burst * TOKEN_UNIT;
+}
+
+bool ingest_limit_is_alert(uint8_t type)
+{
+    return type == PKT_FALL_DETECTED || type == PKT_IMPACT_BURST || type == PKT_USER_RESPONSE;
+}
+
+// Bucket for a MAC, created full on first contact
+static ingest_peer_t *find_peer(ingest_limit_t *limit, const uint8_t mac[6], uint64_t now_us)
+{
+    ingest_peer_t *free_slot = NULL;
+    for (int i = 0; i < INGEST_LIMIT_MAX_PEERS; i++) {
+        ingest_peer_t *peer = &limit->peers[i];
+        if (peer->used && memcmp(peer->mac, mac, 6) == 0) {
+            return peer;
+        }
+        if (!peer->used && free_slot == NULL) {
+            free_slot = peer;
+        }
+    }
+    if (free_slot == NULL) {
+        return &limit->overflow;
+    }
+    free_slot->used = true;
+    memcpy(free_slot->mac, mac, 6);
+    free_slot->tokens = (uint64_t)limit->config.burst * TOKEN_UNIT;
+    free_slot->last_us = now_us;
+    return free_slot;
+}
+
+static void refill(const ingest_limit_config_t *config, ingest_peer_t *peer, uint64_t now_us)
+{
+    uint64_t cap = (uint64_t)config->burst * TOKEN_UNIT;
+    if (now_us > peer->last_us) {
+        // Elapsed us * frames/s is micro-frames; cap the span so it cannot overflow
+        uint64_t elapsed = now_us - peer->last_us;
+        uint64_t span_cap = (config->rate_per_s > 0) ? cap / config->rate_per_s + 1 : 0;
+        uint64_t added = ((elapsed < span_cap) ? elapsed : span_cap) * config->rate_per_s;
+        peer->tokens = (peer->tokens + added < cap) ? peer->tokens + added : cap;
+    }
+    peer->last_us = now_us;
+}
+
+// Count in both the peer's and the total counters
+#define COUNT(limit, peer, field) ((peer)->counts.field++, (limit)->total.field++)
+
+bool ingest_limit_admit(ingest_limit_t *limit, const uint8_t mac[6], uint8_t type,
+                        uint64_t now_us, bool saturated)
+{
+    ingest_peer_t *peer = find_peer(limit, mac, now_us);
+    if (ingest_limit_is_alert(type)) {
+        COUNT(limit, peer, alerts);
+        COUNT(limit, peer, admitted);
+        return true;
+    }
+
+    // Summaries, TIME_SYNC and ACKs would eat the alert reserve just as samples do
+    if (saturated) {
+        COUNT(limit, peer, shed_saturated);
+        return false;
+    }
+
+    refill(&limit->config, peer, now_us);
+    if (peer->tokens >= TOKEN_UNIT) {
+        peer->tokens -= TOKEN_UNIT;
+        COUNT(limit, peer, admitted);
+        return true;
+    }
+
+    // Over budget: keep one in 'downsample' of the excess SENSOR_DATA
+    uint16_t keep = limit->config.downsample;
+    if (type == PKT_SENSOR_DATA && keep > 0 && ++peer->skipped >= keep) {
+        peer->skipped = 0;
+        COUNT(limit, peer, downsampled);
+        COUNT(limit, peer, admitted);
+        return true;
+    }
+    COUNT(limit, peer, shed_budget);
+    return false;
+}
+
+const ingest_peer_t *ingest_limit_peer(const ingest_limit_t *limit, int index)
+{
+    if (index == INGEST_LIMIT_MAX_PEERS) {
+        return &limit->overflow;
+    }
+    if (index < 0 || index > INGEST_LIMIT_MAX_PEERS || !limit->peers[index].used) {
+        return NULL;
+    }
+    return &limit->peers[index];
+}
+
+void ingest_limit_get_totals(const ingest_limit_t *limit, ingest_limit_counts_t *counts)
+{
+    *counts = limit->total;
+}
@@ -0,0 +1,83 @@
+// Latency Histogram - Fixed-size log-linear latency distribution
+#include "common/latency_hist.h"
+#include <string.h>
+
+#define SUB_COUNT (1u << LATENCY_SUB_BITS)
+
+static uint32_t bucket_of(uint32_t value)
+{
+    if (value < SUB_COUNT) {
+        return value;
+    }
+    uint32_t exp = 31 - (uint32_t)__builtin_clz(value);
+    if (exp > LATENCY_MAX_EXP) {
+        return LATENCY_BUCKETS - 1;
+    }
+    uint32_t sub = (value >> (exp - LATENCY_SUB_BITS)) & (SUB_COUNT - 1);
+    return ((exp - LATENCY_SUB_BITS + 1) << LATENCY_SUB_BITS) + sub;
+}
+
+// Largest value that falls into a bucket
+static uint32_t bucket_upper(uint32_t bucket)
+{
+    if (bucket < SUB_COUNT) {
+        return bucket;
+    }
+    if (bucket == LATENCY_BUCKETS - 1) {
+        return UINT32_MAX;
+    }
+    uint32_t exp = (bucket >> LATENCY_SUB_BITS) + LATENCY_SUB_BITS - 1;
+    uint32_t sub = bucket & (SUB_COUNT - 1);
+    uint32_t width = 1u << (exp - LATENCY_SUB_BITS);
+    return ((SUB_COUNT + sub) << (exp - LATENCY_SUB_BITS)) + width - 1;
+}
+
+void latency_hist_init(latency_hist_t *hist)
+{
+    memset(hist, 0, sizeof(*hist));
+    hist->min_us = UINT32_MAX;
+}
+
+void latency_hist_add(latency_hist_t *hist, int64_t latency_us)
+{
+    uint32_t value;
+    if (latency_us < 0) {
+        hist->negative++;
+        value = 0;
+    } else {
+        value = (latency_us > (int64_t)UINT32_MAX) ? UINT32_MAX : (uint32_t)latency_us;
+    }
+
+    hist->counts[bucket_of(value)]++;
+    hist->count++;
+    hist->sum_us += value;
+    if (value < hist->min_us) hist->min_us = value;
+    if (value > hist->max_us) hist->max_us = value;
+}
+
+uint32_t latency_hist_percentile(const latency_hist_t *hist, float fraction)
+{
+    if (hist->count == 0) {
+        return 0;
+    }
+    // Rank of the requested value (1-based, rounded up)
+    uint32_t rank = (uint32_t)(fraction * hist->count);
+    if ((float)rank < fraction * hist->count) rank++;
+    if (rank < 1) rank = 1;
+    if (rank > hist->count) rank = hist->count;
+
+    uint32_t seen = 0;
+    for (uint32_t b = 0; b < LATENCY_BUCKETS; b++) {
+        seen += hist->counts[b];
+        if (seen >= rank) {
+            uint32_t upper = bucket_upper(b);
+            return (upper < hist->max_us) ? upper : hist->max_us;
+        }
+    }
+    return hist->max_us;
+}
+
+uint32_t latency_hist_mean(const latency_hist_t *hist)
+{
+    return (hist->count == 0) ? 0 : (uint32_t)(hist->sum_us / hist->count);
+}
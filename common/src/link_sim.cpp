@@ -0,0 +1,265 @@
+// Link Simulator - Lossy ESP-NOW link model for host builds
+#include "common/link_sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const link_sim_config_t DEFAULT_CONFIG = {
+    0.0f,       // loss
+    0.0f,       // burst_enter
+    1.0f,       // burst_exit
+    0.0f,       // burst_loss
+    3,          // retries
+    1000,       // retry_us
+    2000,       // delay_us
+    0,          // jitter_us
+    0.0f,       // reorder
+    0,          // reorder_us
+    0.0f        // duplicate
+};
+
+// xorshift32
+static uint32_t next_random(link_sim_t *sim)
+{
+    uint32_t x = sim->rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    sim->rng = x;
+    return x;
+}
+
+// Uniform in [0, 1)
+static float uniform(link_sim_t *sim)
+{
+    return (float)(next_random(sim) >> 8) * (1.0f / 16777216.0f);
+}
+
+static bool chance(link_sim_t *sim, float p)
+{
+    return p > 0.0f && uniform(sim) < p;
+}
+
+void link_sim_default_config(link_sim_config_t *config)
+{
+    *config = DEFAULT_CONFIG;
+}
+
+// Parse one "key=value" pair
+static bool parse_pair(link_sim_config_t *config, const char *key, const char *value)
+{
+    char *end;
+    double v = strtod(value, &end);
+    if (end == value || *end != '\0' || v < 0.0) {
+        return false;
+    }
+
+    float *probability = NULL;
+    uint32_t *time_us = NULL;
+    if (strcmp(key, "loss") == 0)               probability = &config->loss;
+    else if (strcmp(key, "burst_enter") == 0)   probability = &config->burst_enter;
+    else if (strcmp(key, "burst_exit") == 0)    probability = &config->burst_exit;
+    else if (strcmp(key, "burst_loss") == 0)    probability = &config->burst_loss;
+    else if (strcmp(key, "reorder") == 0)       probability = &config->reorder;
+    else if (strcmp(key, "duplicate") == 0)     probability = &config->duplicate;
+    else if (strcmp(key, "retry_us") == 0)      time_us = &config->retry_us;
+    else if (strcmp(key, "delay_us") == 0)      time_us = &config->delay_us;
+    else if (strcmp(key, "jitter_us") == 0)     time_us = &config->jitter_us;
+    else if (strcmp(key, "reorder_us") == 0)    time_us = &config->reorder_us;
+    else if (strcmp(key, "retries") == 0) {
+        if (v > 255.0) {
+            return false;
+        }
+        config->retries = (uint8_t)v;
+        return true;
+    }
+
+    if (probability != NULL) {
+        if (v > 1.0) {
+            return false;
+        }
+        *probability = (float)v;
+        return true;
+    }
+    if (time_us != NULL) {
+        *time_us = (uint32_t)v;
+        return true;
+    }
+    return false;
+}
+
+bool link_sim_parse(link_sim_config_t *config, const char *spec)
+{
+    char buf[256];
+    if (strlen(spec) >= sizeof(buf)) {
+        return false;
+    }
+    strcpy(buf, spec);
+
+    char *save = NULL;
+    for (char *pair = strtok_r(buf, ",", &save); pair != NULL; pair = strtok_r(NULL, ",", &save)) {
+        char *eq = strchr(pair, '=');
+        if (eq == NULL) {
+            printf("LinkSim - Expected key=value: %s\n", pair);
+            return false;
+        }
+        *eq = '\0';
+        if (!parse_pair(config, pair, eq + 1)) {
+            printf("LinkSim - Invalid setting: %s=%s\n", pair, eq + 1);
+            return false;
+        }
+    }
+    return true;
+}
+
+void link_sim_init(link_sim_t *sim, const link_sim_config_t *config, uint32_t seed)
+{
+    memset(sim, 0, sizeof(*sim));
+    sim->config = (config != NULL) ? *config : DEFAULT_CONFIG;
+    // Spread small seeds; xorshift must not start at zero
+    sim->rng = seed * 2654435761u + 0x6D2B79F5u;
+    if (sim->rng == 0) {
+        sim->rng = 1;
+    }
+}
+
+static link_sim_slot_t *free_slot(link_sim_t *sim)
+{
+    for (int i = 0; i < LINK_SIM_QUEUE_SIZE; i++) {
+        if (!sim->queue[i].used) {
+            return &sim->queue[i];
+        }
+    }
+    return NULL;
+}
+
+// One transmission attempt through the two-state channel
+static bool attempt_lost(link_sim_t *sim)
+{
+    const link_sim_config_t *c = &sim->config;
+    if (sim->bad_state) {
+        if (chance(sim, c->burst_exit)) {
+            sim->bad_state = false;
+        }
+    } else if (chance(sim, c->burst_enter)) {
+        sim->bad_state = true;
+    }
+    if (sim->bad_state) {
+        sim->stats.burst_attempts++;
+        return chance(sim, c->burst_loss);
+    }
+    return chance(sim, c->loss);
+}
+
+bool link_sim_send(link_sim_t *sim, uint64_t now_us, const uint8_t *data, size_t len)
+{
+    const link_sim_config_t *c = &sim->config;
+    link_sim_slot_t *slot = free_slot(sim);
+    if (slot == NULL || len == 0 || len > PROTOCOL_ESPNOW_MAX_FRAME) {
+        sim->stats.refused++;
+        return false;
+    }
+    sim->stats.sent++;
+    sim->stats.bytes_sent += len;
+    uint32_t seq = sim->next_seq++;
+
+    int attempts = 0;
+    bool through = false;
+    while (!through && attempts <= c->retries) {
+        if (attempts > 0) {
+            sim->stats.retransmissions++;
+        }
+        attempts++;
+        through = !attempt_lost(sim);
+    }
+    if (!through) {
+        sim->stats.lost++;
+        return false;
+    }
+
+    uint64_t delay = c->delay_us + (uint64_t)(attempts - 1) * c->retry_us;
+    if (c->jitter_us > 0) {
+        delay += next_random(sim) % (c->jitter_us + 1);
+    }
+    if (chance(sim, c->reorder)) {
+        delay += c->reorder_us;
+    }
+
+    slot->used = true;
+    slot->len = (uint16_t)len;
+    memcpy(slot->data, data, len);
+    slot->info.sent_us = now_us;
+    slot->info.deliver_us = now_us + delay;
+    slot->info.seq = seq;
+    slot->info.attempts = (uint8_t)attempts;
+    slot->info.duplicate = false;
+
+    // The sender missed the ACK and sent it again (skipped when the queue is full)
+    if (chance(sim, c->duplicate)) {
+        link_sim_slot_t *dup = free_slot(sim);
+        if (dup != NULL) {
+            *dup = *slot;
+            dup->info.deliver_us += c->retry_us;
+            dup->info.attempts++;
+            dup->info.duplicate = true;
+            sim->stats.retransmissions++;
+        }
+    }
+    return true;
+}
+
+// Earliest frame in flight (send order breaks ties)
+static link_sim_slot_t *earliest(const link_sim_t *sim)
+{
+    const link_sim_slot_t *best = NULL;
+    for (int i = 0; i < LINK_SIM_QUEUE_SIZE; i++) {
+        const link_sim_slot_t *s = &sim->queue[i];
+        if (!s->used) {
+            continue;
+        }
+        if (best == NULL || s->info.deliver_us < best->info.deliver_us ||
+            (s->info.deliver_us == best->info.deliver_us && s->info.seq < best->info.seq)) {
+            best = s;
+        }
+    }
+    return (link_sim_slot_t *)best;
+}
+
+size_t link_sim_receive(link_sim_t *sim, uint64_t now_us, uint8_t *out, link_sim_info_t *info)
+{
+    link_sim_slot_t *slot = earliest(sim);
+    if (slot == NULL || slot->info.deliver_us > now_us) {
+        return 0;
+    }
+
+    size_t len = slot->len;
+    memcpy(out, slot->data, len);
+    if (info != NULL) {
+        *info = slot->info;
+    }
+
+    sim->stats.delivered++;
+    if (slot->info.duplicate) {
+        sim->stats.duplicates++;
+    } else {
+        sim->stats.bytes_delivered += len;
+        if (slot->info.seq + 1 < sim->highest_received) {
+            sim->stats.reordered++;
+        } else {
+            sim->highest_received = slot->info.seq + 1;
+        }
+    }
+    slot->used = false;
+    return len;
+}
+
+uint64_t link_sim_next_arrival(const link_sim_t *sim)
+{
+    const link_sim_slot_t *slot = earliest(sim);
+    return (slot != NULL) ? slot->info.deliver_us : UINT64_MAX;
+}
+
+void link_sim_get_stats(const link_sim_t *sim, link_sim_stats_t *stats)
+{
+    *stats = sim->stats;
+}
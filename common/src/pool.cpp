@@ -0,0 +1,86 @@
+// Fixed-Block Pool - Allocation without heap use on hot paths
+#include "common/pool.h"
+#include <assert.h>
+
+#define POOL_EMPTY 0xFFFFu
+
+static inline uint32_t pack(uint32_t tag, uint32_t index)
+{
+    return (tag << 16) | (index & 0xFFFFu);
+}
+
+void pool_init(pool_t *pool, void *storage, uint16_t *links, size_t block_size, uint16_t count)
+{
+    assert(count <= POOL_MAX_BLOCKS);
+
+    pool->storage = (uint8_t *)storage;
+    pool->links = links;
+    pool->block_size = POOL_BLOCK_SIZE(block_size);
+    pool->block_count = count;
+
+    for (uint16_t i = 0; i < count; i++) {
+        links[i] = (i + 1 < count) ? (uint16_t)(i + 1) : (uint16_t)POOL_EMPTY;
+    }
+    pool->head.store(pack(0, count > 0 ? 0 : POOL_EMPTY));
+    pool->allocs.store(0);
+    pool->frees.store(0);
+    pool->failures.store(0);
+    pool->in_use.store(0);
+    pool->high_water.store(0);
+}
+
+void *pool_alloc(pool_t *pool)
+{
+    // The tag changes on every pop so a stale head cannot be swapped back in (ABA)
+    uint32_t head = pool->head.load(std::memory_order_acquire);
+    while (true) {
+        uint32_t index = head & 0xFFFFu;
+        if (index == POOL_EMPTY) {
+            pool->failures.fetch_add(1, std::memory_order_relaxed);
+            return NULL;
+        }
+        uint32_t next = pack((head >> 16) + 1, pool->links[index]);
+        if (pool->head.compare_exchange_weak(head, next, std::memory_order_acq_rel,
+                                             std::memory_order_acquire)) {
+            pool->allocs.fetch_add(1, std::memory_order_relaxed);
+            uint32_t used = pool->in_use.fetch_add(1, std::memory_order_relaxed) + 1;
+            uint32_t high = pool->high_water.load(std::memory_order_relaxed);
+            while (used > high &&
+                   !pool->high_water.compare_exchange_weak(high, used, std::memory_order_relaxed)) {
+            }
+            return pool->storage + (size_t)index * pool->block_size;
+        }
+    }
+}
+
+void pool_free(pool_t *pool, void *block)
+{
+    if (block == NULL) {
+        return;
+    }
+
+    size_t offset = (uint8_t *)block - pool->storage;
+    assert(offset % pool->block_size == 0 && offset / pool->block_size < pool->block_count);
+    uint16_t index = (uint16_t)(offset / pool->block_size);
+
+    uint32_t head = pool->head.load(std::memory_order_acquire);
+    uint32_t next;
+    do {
+        pool->links[index] = (uint16_t)(head & 0xFFFFu);
+        next = pack((head >> 16) + 1, index);
+    } while (!pool->head.compare_exchange_weak(head, next, std::memory_order_acq_rel,
+                                               std::memory_order_acquire));
+
+    pool->frees.fetch_add(1, std::memory_order_relaxed);
+    pool->in_use.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void pool_get_stats(const pool_t *pool, pool_stats_t *stats)
+{
+    stats->allocs = pool->allocs.load(std::memory_order_relaxed);
+    stats->frees = pool->frees.load(std::memory_order_relaxed);
+    stats->failures = pool->failures.load(std::memory_order_relaxed);
+    stats->in_use = pool->in_use.load(std::memory_order_relaxed);
+    stats->high_water = pool->high_water.load(std::memory_order_relaxed);
+    stats->block_count = pool->block_count;
+}
@@ -0,0 +1,157 @@
+// Protocol - START/LENGTH/TYPE/PAYLOAD/CRC16/END packet framing (protocol.h)
+#include "protocol.h"
+#include <string.h>
+
+// START + LENGTH + TYPE before the payload, CRC16 + END after it
+#define PACKET_HEADER_SIZE 3
+#define PACKET_TRAILER_SIZE 3
+
+uint16_t protocol_calculate_crc(const uint8_t* data, size_t length)
+{
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= (uint16_t)(data[i] << 8);
+        for (uint8_t j = 0; j < 8; j++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+// CRC over LENGTH, TYPE and the payload
+static uint16_t packet_crc(uint8_t length, uint8_t type, const uint8_t* payload)
+{
+    uint8_t buffer[2 + PROTOCOL_MAX_PAYLOAD];
+    buffer[0] = length;
+    buffer[1] = type;
+    memcpy(buffer + 2, payload, length);
+    return protocol_calculate_crc(buffer, 2 + (size_t)length);
+}
+
+bool protocol_validate_packet(const protocol_packet_t* packet)
+{
+    return packet->start == PROTOCOL_START_BYTE &&
+           packet->end == PROTOCOL_END_BYTE &&
+           packet->crc == packet_crc(packet->length, packet->type, packet->payload);
+}
+
+int protocol_encode_packet(uint8_t* buffer, uint8_t type,
+                           const uint8_t* payload, uint8_t length)
+{
+    if (buffer == NULL || (payload == NULL && length > 0)) {
+        return -1;
+    }
+    buffer[0] = PROTOCOL_START_BYTE;
+    buffer[1] = length;
+    buffer[2] = type;
+    if (length > 0) {
+        memcpy(buffer + PACKET_HEADER_SIZE, payload, length);
+    }
+    uint16_t crc = protocol_calculate_crc(buffer + 1, 2 + (size_t)length);
+    buffer[PACKET_HEADER_SIZE + length] = (uint8_t)(crc & 0xFF);
+    buffer[PACKET_HEADER_SIZE + length + 1] = (uint8_t)(crc >> 8);
+    buffer[PACKET_HEADER_SIZE + length + 2] = PROTOCOL_END_BYTE;
+    return PACKET_HEADER_SIZE + length + PACKET_TRAILER_SIZE;
+}
+
+int protocol_decode_packet(protocol_packet_t* packet,
+                           const uint8_t* buffer, size_t length)
+{
+    if (length < 1) {
+        return 0;
+    }
+    if (buffer[0] != PROTOCOL_START_BYTE) {
+        return -1;
+    }
+    if (length < PACKET_HEADER_SIZE) {
+        return 0;
+    }
+    size_t total = PACKET_HEADER_SIZE + (size_t)buffer[1] + PACKET_TRAILER_SIZE;
+    if (length < total) {
+        return 0;
+    }
+
+    const uint8_t* trailer = buffer + PACKET_HEADER_SIZE + buffer[1];
+    uint16_t crc = (uint16_t)(trailer[0] | (trailer[1] << 8));
+    if (trailer[2] != PROTOCOL_END_BYTE ||
+        crc != protocol_calculate_crc(buffer + 1, 2 + (size_t)buffer[1])) {
+        return -1;
+    }
+
+    packet->start = buffer[0];
+    packet->length = buffer[1];
+    packet->type = buffer[2];
+    memcpy(packet->payload, buffer + PACKET_HEADER_SIZE, packet->length);
+    packet->crc = crc;
+    packet->end = trailer[2];
+    return (int)total;
+}
+
+// ===== Typed Helpers =====
+
+int protocol_create_sensor_data(uint8_t* buffer, const sensor_data_t* data)
+{
+    return protocol_encode_packet(buffer, PKT_SENSOR_DATA, (const uint8_t*)data, sizeof(*data));
+}
+
+int protocol_create_fall_detected(uint8_t* buffer, const fall_detected_t* fall)
+{
+    return protocol_encode_packet(buffer, PKT_FALL_DETECTED, (const uint8_t*)fall, sizeof(*fall));
+}
+
+int protocol_create_heartrate(uint8_t* buffer, const heartrate_t* hr)
+{
+    return protocol_encode_packet(buffer, PKT_HEARTRATE, (const uint8_t*)hr, sizeof(*hr));
+}
+
+int protocol_create_ack(uint8_t* buffer, uint8_t ack_type, uint8_t seq_num)
+{
+    ack_t ack;
+    memset(&ack, 0, sizeof(ack));
+    ack.ack_type = ack_type;
+    ack.seq_num = seq_num;
+    ack.status = ACK_STATUS_OK;
+    return protocol_encode_packet(buffer, PKT_ACK, (const uint8_t*)&ack, sizeof(ack));
+}
+
+int protocol_create_status_request(uint8_t* buffer)
+{
+    return protocol_encode_packet(buffer, PKT_STATUS_REQUEST, NULL, 0);
+}
+
+int protocol_create_status_response(uint8_t* buffer, const status_response_t* status)
+{
+    return protocol_encode_packet(buffer, PKT_STATUS_RESPONSE, (const uint8_t*)status, sizeof(*status));
+}
+
+int protocol_create_user_response(uint8_t* buffer, const user_response_t* response)
+{
+    return protocol_encode_packet(buffer, PKT_USER_RESPONSE, (const uint8_t*)response, sizeof(*response));
+}
+
+bool protocol_parse_sensor_data(sensor_data_t* data, const protocol_packet_t* packet)
+{
+    if (packet->type != PKT_SENSOR_DATA || packet->length < sizeof(*data)) {
+        return false;
+    }
+    memcpy(data, packet->payload, sizeof(*data));
+    return true;
+}
+
+bool protocol_parse_fall_detected(fall_detected_t* fall, const protocol_packet_t* packet)
+{
+    if (packet->type != PKT_FALL_DETECTED || packet->length < sizeof(*fall)) {
+        return false;
+    }
+    memcpy(fall, packet->payload, sizeof(*fall));
+    return true;
+}
+
+bool protocol_parse_heartrate(heartrate_t* hr, const protocol_packet_t* packet)
+{
+    if (packet->type != PKT_HEARTRATE || packet->length < sizeof(*hr)) {
+        return false;
+    }
+    memcpy(hr, packet->payload, sizeof(*hr));
+    return true;
+}
@@ -0,0 +1,159 @@
+// Deferred Log Decoder - Turns captured serial output into readable log lines
+// Scans the given source trees for DLOG_xxx("format", ...) calls, hashes each
+// format string the way dlog.h does, then reads a serial capture and prints
+// every binary record as text. Bytes outside records (Serial.print output)
+// pass through unchanged. Records the device dropped (ring full) and frames
+// lost or corrupted on the wire (sequence gaps) are reported.
+//
+// Build: g++ -std=c++17 -O2 -I../include dlog_decode.cpp ../src/dlog.cpp -o dlog-decode
+// Usage: dlog-decode <capture|-> <source-dir>...
+//        (capture e.g. with: pio device monitor --raw > capture.bin)
+
+#include "common/dlog.h"
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <regex>
+#include <sstream>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// Undo C escapes in a string literal body
+static std::string unescape(const std::string &s)
+{
+    std::string out;
+    for (size_t i = 0; i < s.size(); i++) {
+        if (s[i] != '\\' || i + 1 >= s.size()) {
+            out += s[i];
+            continue;
+        }
+        char c = s[++i];
+        switch (c) {
+        case 'n': out += '\n'; break;
+        case 't': out += '\t'; break;
+        case 'r': out += '\r'; break;
+        case '0': out += '\0'; break;
+        default:  out += c; break;
+        }
+    }
+    return out;
+}
+
+// Collect format strings from DLOG_xxx calls under 'root'
+static void scan_sources(const fs::path &root, std::map<uint32_t, std::string> &formats)
+{
+    static const std::regex call("DLOG_(ERROR|WARN|INFO|DEBUG)\\s*\\(\\s*\"((?:[^\"\\\\]|\\\\.)*)\"");
+
+    for (const auto &entry : fs::recursive_directory_iterator(root)) {
+        if (!entry.is_regular_file()) {
+            continue;
+        }
+        std::string ext = entry.path().extension().string();
+        if (ext != ".cpp" && ext != ".h" && ext != ".c" && ext != ".ino") {
+            continue;
+        }
+        std::ifstream in(entry.path());
+        std::stringstream text;
+        text << in.rdbuf();
+        std::string source = text.str();
+
+        for (std::sregex_iterator it(source.begin(), source.end(), call), end; it != end; ++it) {
+            std::string fmt = unescape((*it)[2].str());
+            uint32_t id = dlog_hash(fmt.c_str());
+            auto found = formats.find(id);
+            if (found != formats.end() && found->second != fmt) {
+                fprintf(stderr, "DlogDecode - Hash collision: \"%s\" / \"%s\"\n",
+                        found->second.c_str(), fmt.c_str());
+            }
+            formats[id] = fmt;
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3) {
+        fprintf(stderr, "Usage: %s <capture|-> <source-dir>...\n", argv[0]);
+        return 1;
+    }
+
+    std::map<uint32_t, std::string> formats;
+    for (int i = 2; i < argc; i++) {
+        scan_sources(argv[i], formats);
+    }
+    fprintf(stderr, "DlogDecode - %zu format strings\n", formats.size());
+
+    FILE *in = (strcmp(argv[1], "-") == 0) ? stdin : fopen(argv[1], "rb");
+    if (in == NULL) {
+        fprintf(stderr, "DlogDecode - Cannot open %s\n", argv[1]);
+        return 1;
+    }
+
+    std::vector<uint8_t> buf;
+    uint8_t chunk[4096];
+    size_t got;
+    bool have_seq = false;
+    uint16_t expected_seq = 0;
+    uint32_t records = 0, dropped = 0, lost = 0, unknown = 0;
+    char line[256];
+
+    // Keep unconsumed bytes between reads so frames may span them
+    bool eof = false;
+    while (!eof) {
+        got = fread(chunk, 1, sizeof(chunk), in);
+        if (got == 0) {
+            eof = true;
+        }
+        buf.insert(buf.end(), chunk, chunk + got);
+
+        size_t pos = 0;
+        while (pos < buf.size()) {
+            if (buf[pos] != DLOG_FRAME_MAGIC0) {
+                fputc(buf[pos++], stdout);
+                continue;
+            }
+            dlog_record_t record;
+            int used = dlog_decode(&buf[pos], buf.size() - pos, &record);
+            if (used == 0 && !eof) {
+                break;  // Need more bytes
+            }
+            if (used <= 0) {
+                fputc(buf[pos++], stdout);
+                continue;
+            }
+
+            if (record.lost > 0) {
+                dropped += record.lost;
+                printf("-- %u records dropped on the device\n", record.lost);
+            }
+            if (have_seq && record.seq != expected_seq) {
+                uint16_t gap = (uint16_t)(record.seq - expected_seq);
+                lost += gap;
+                printf("-- %u records lost on the wire\n", gap);
+            }
+            have_seq = true;
+            expected_seq = (uint16_t)(record.seq + 1);
+
+            auto found = formats.find(record.id);
+            if (found == formats.end()) {
+                unknown++;
+            }
+            dlog_format(&record, found != formats.end() ? found->second.c_str() : NULL,
+                        line, sizeof(line));
+            fputs(line, stdout);
+            records++;
+            pos += (size_t)used;
+        }
+        buf.erase(buf.begin(), buf.begin() + pos);
+    }
+
+    if (in != stdin) {
+        fclose(in);
+    }
+    fprintf(stderr, "DlogDecode - %u records, %u dropped, %u lost, %u with unknown format\n",
+            records, dropped, lost, unknown);
+    return 0;
+}
@@ -0,0 +1,228 @@
+// Feature Kernel Benchmark - ns/sample of each streaming feature kernel
+// Feeds a synthetic accelerometer signal (gravity, walking-like oscillation,
+// noise and occasional impacts) through every kernel in common/features.h,
+// for float samples and int16_t counts, and reports the cost per sample.
+// Before timing, each kernel's output is checked against a direct
+// computation over the window.
+//
+// Build: g++ -std=c++17 -O2 -I../include feature_bench.cpp -o feature-bench
+// Usage: feature-bench [samples]
+
+#include "common/features.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <vector>
+
+// Window used for the report (0.5 s at 100 Hz)
+#define WINDOW 50
+
+// Counts per m/s^2 for the int16_t variant (+-16 g range)
+#define COUNTS_PER_MS2 208.8f
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// xorshift32 uniform in [-1, 1)
+static float noise(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return (float)(x >> 8) * (2.0f / 16777216.0f) - 1.0f;
+}
+
+typedef struct {
+    std::vector<float> x, y, z;
+    std::vector<int16_t> cx, cy, cz;
+} signal_t;
+
+static void make_signal(signal_t *s, int count)
+{
+    uint32_t seed = 12345;
+    s->x.resize(count);
+    s->y.resize(count);
+    s->z.resize(count);
+    s->cx.resize(count);
+    s->cy.resize(count);
+    s->cz.resize(count);
+    for (int i = 0; i < count; i++) {
+        float t = i * 0.01f;
+        float tilt = 0.3f * sinf(t * 0.05f);
+        float impact = (i % 5000 < 8) ? 30.0f : 0.0f;
+        s->x[i] = 9.81f * sinf(tilt) + 0.3f * noise(&seed);
+        s->y[i] = 1.5f * sinf(t * 11.0f) + 0.3f * noise(&seed);
+        s->z[i] = 9.81f * cosf(tilt) + 2.0f * sinf(t * 12.0f) + impact + 0.3f * noise(&seed);
+        s->cx[i] = (int16_t)lrintf(s->x[i] * COUNTS_PER_MS2);
+        s->cy[i] = (int16_t)lrintf(s->y[i] * COUNTS_PER_MS2);
+        s->cz[i] = (int16_t)lrintf(s->z[i] * COUNTS_PER_MS2);
+    }
+}
+
+// ===== Reference implementations over the window ending at sample i =====
+
+static float ref_magnitude(const signal_t *s, int i)
+{
+    return sqrtf(s->x[i] * s->x[i] + s->y[i] * s->y[i] + s->z[i] * s->z[i]);
+}
+
+static void reference(const signal_t *s, int i, float out[6])
+{
+    double svm = 0.0, sma = 0.0, mean = 0.0, m2 = 0.0, jerk = 0.0;
+    double cur[3] = { 0, 0, 0 }, prev[3] = { 0, 0, 0 };
+    for (int j = i - WINDOW + 1; j <= i; j++) {
+        svm += ref_magnitude(s, j);
+        sma += fabs(s->x[j]) + fabs(s->y[j]) + fabs(s->z[j]);
+        double d = sqrt(pow(s->x[j] - s->x[j - 1], 2) + pow(s->y[j] - s->y[j - 1], 2) +
+                        pow(s->z[j] - s->z[j - 1], 2));
+        jerk = (d > jerk) ? d : jerk;
+        cur[0] += s->x[j];
+        cur[1] += s->y[j];
+        cur[2] += s->z[j];
+        prev[0] += s->x[j - WINDOW];
+        prev[1] += s->y[j - WINDOW];
+        prev[2] += s->z[j - WINDOW];
+    }
+    mean = svm / WINDOW;
+    for (int j = i - WINDOW + 1; j <= i; j++) {
+        double d = ref_magnitude(s, j) - mean;
+        m2 += d * d;
+    }
+    double dot = cur[0] * prev[0] + cur[1] * prev[1] + cur[2] * prev[2];
+    double norms = sqrt((cur[0] * cur[0] + cur[1] * cur[1] + cur[2] * cur[2]) *
+                        (prev[0] * prev[0] + prev[1] * prev[1] + prev[2] * prev[2]));
+    double cosine = dot / norms;
+    cosine = cosine > 1.0 ? 1.0 : cosine;
+
+    out[0] = (float)mean;
+    out[1] = (float)jerk;
+    out[2] = (float)(sma / WINDOW);
+    out[3] = (float)(acos(cosine) * 57.29578);
+    out[4] = (float)(m2 / WINDOW);
+    out[5] = 0.0f;
+}
+
+// Largest difference between the float kernels and the reference
+static bool check(const signal_t *s, int count)
+{
+    feature_svm_t<WINDOW, float> svm;
+    feature_jerk_t<WINDOW, float> jerk;
+    feature_sma_t<WINDOW, float> sma;
+    feature_tilt_t<WINDOW, float> tilt;
+    feature_still_t<WINDOW, float> still;
+    feature_svm_init(&svm);
+    feature_jerk_init(&jerk);
+    feature_sma_init(&sma);
+    feature_tilt_init(&tilt);
+    feature_still_init(&still);
+
+    static const char *NAMES[5] = { "svm", "jerk", "sma", "tilt", "still" };
+    static const float TOLERANCE[5] = { 1e-3f, 1e-3f, 1e-3f, 0.05f, 1e-2f };
+    float worst[5] = { 0, 0, 0, 0, 0 };
+    for (int i = 0; i < count; i++) {
+        float got[5];
+        got[0] = feature_svm_push(&svm, s->x[i], s->y[i], s->z[i]);
+        feature_jerk_push(&jerk, s->x[i], s->y[i], s->z[i]);
+        got[1] = feature_jerk_peak(&jerk);
+        got[2] = feature_sma_push(&sma, s->x[i], s->y[i], s->z[i]);
+        got[3] = feature_tilt_push(&tilt, s->x[i], s->y[i], s->z[i]);
+        got[4] = feature_still_push(&still, s->x[i], s->y[i], s->z[i]);
+        if (i < 2 * WINDOW || i % 97 != 0) {
+            continue;
+        }
+        float want[6];
+        reference(s, i, want);
+        for (int k = 0; k < 5; k++) {
+            // Relative to the value's scale (|a| is ~10 m/s^2)
+            float err = fabsf(got[k] - want[k]) / (fabsf(want[k]) > 1.0f ? fabsf(want[k]) : 1.0f);
+            worst[k] = (err > worst[k]) ? err : worst[k];
+        }
+    }
+
+    bool ok = true;
+    for (int k = 0; k < 5; k++) {
+        bool pass = worst[k] <= TOLERANCE[k];
+        printf("FeatureBench - Check %-5s worst relative error %.2e %s\n", NAMES[k], worst[k], pass ? "ok" : "FAIL");
+        ok = ok && pass;
+    }
+    return ok;
+}
+
+// Time 'body' over every sample; returns ns per sample
+template <typename Body>
+static double time_kernel(int count, Body body)
+{
+    int passes = 0;
+    double start = now_s(), elapsed;
+    do {
+        for (int i = 0; i < count; i++) {
+            body(i);
+        }
+        passes++;
+        elapsed = now_s() - start;
+    } while (elapsed < 0.2);
+    return elapsed * 1e9 / ((double)count * passes);
+}
+
+template <typename T>
+static void bench(const char *type, const std::vector<T> &x, const std::vector<T> &y,
+                  const std::vector<T> &z, int count)
+{
+    static feature_svm_t<WINDOW, T> svm;
+    static feature_jerk_t<WINDOW, T> jerk;
+    static feature_sma_t<WINDOW, T> sma;
+    static feature_tilt_t<WINDOW, T> tilt;
+    static feature_still_t<WINDOW, T> still;
+    feature_svm_init(&svm);
+    feature_jerk_init(&jerk);
+    feature_sma_init(&sma);
+    feature_tilt_init(&tilt);
+    feature_still_init(&still);
+    volatile float sink = 0.0f;     // Keeps the results observable
+
+    double ns[7];
+    ns[0] = time_kernel(count, [&](int i) { sink = feature_svm_push(&svm, x[i], y[i], z[i]); });
+    ns[1] = time_kernel(count, [&](int i) { sink = feature_svm_peak(&svm); (void)i; });
+    ns[2] = time_kernel(count, [&](int i) { sink = feature_jerk_push(&jerk, x[i], y[i], z[i]); });
+    ns[3] = time_kernel(count, [&](int i) { sink = feature_sma_push(&sma, x[i], y[i], z[i]); });
+    ns[4] = time_kernel(count, [&](int i) { sink = feature_tilt_push(&tilt, x[i], y[i], z[i]); });
+    ns[5] = time_kernel(count, [&](int i) { sink = feature_still_push(&still, x[i], y[i], z[i]); });
+    ns[6] = time_kernel(count, [&](int i) {
+        float f = feature_svm_push(&svm, x[i], y[i], z[i]);
+        f += feature_jerk_push(&jerk, x[i], y[i], z[i]);
+        f += feature_sma_push(&sma, x[i], y[i], z[i]);
+        f += feature_tilt_push(&tilt, x[i], y[i], z[i]);
+        f += feature_still_push(&still, x[i], y[i], z[i]);
+        sink = f;
+    });
+    (void)sink;
+
+    printf("FeatureBench - %-7s svm %5.1f  svm-peak %5.1f  jerk %5.1f  sma %5.1f  tilt %5.1f  still %5.1f  all five %5.1f ns/sample\n",
+           type, ns[0], ns[1], ns[2], ns[3], ns[4], ns[5], ns[6]);
+}
+
+int main(int argc, char *argv[])
+{
+    int count = (argc > 1) ? atoi(argv[1]) : 1000000;
+    if (count < 4 * WINDOW) {
+        fprintf(stderr, "FeatureBench - Need at least %d samples\n", 4 * WINDOW);
+        return 1;
+    }
+
+    signal_t s;
+    make_signal(&s, count);
+    printf("FeatureBench - %d samples, window %d\n", count, WINDOW);
+    if (!check(&s, count)) {
+        return 1;
+    }
+    bench<float>("float", s.x, s.y, s.z, count);
+    bench<int16_t>("int16_t", s.cx, s.cy, s.cz, count);
+    return 0;
+}
@@ -0,0 +1,62 @@
+// Sensor Calibration - Per-wearable IMU bias/scale correction
+// Calibrations come from testing/sensor-calibration (six-orientation
+// session) as one line per MAC in config/calibration.csv:
+//   MAC,ax_bias,ay_bias,az_bias,gx_bias,gy_bias,gz_bias,
+//       ax_scale,ay_scale,az_scale,gx_scale,gy_scale,gz_scale
+// meaning true = (raw - bias) / scale. On load each entry is folded into one
+// multiply-add per channel, so correcting a batch costs six fused
+// multiply-adds per sample with no branches. Devices without an entry get
+// the identity correction.
+
+#ifndef _CALIBRATION_H_
+#define _CALIBRATION_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "protocol.h"
+
+// Corrected channels: ax, ay, az, gx, gy, gz
+#define CALIBRATION_CHANNELS 6
+
+// Maximum number of calibrated wearables
+#define CALIBRATION_TABLE_SIZE 64
+
+// Precomputed correction: value * gain + offset
+typedef struct {
+    float gain[CALIBRATION_CHANNELS];
+    float offset[CALIBRATION_CHANNELS];
+    bool calibrated;            // false for the identity correction
+} calibration_t;
+
+/**
+ * Load the calibration table (replaces any previous table)
+ * A missing file leaves every device uncalibrated.
+ * @param path Path to calibration.csv
+ * @return Number of entries loaded, or -1 on a malformed file
+ */
+int calibration_load(const char *path);
+
+/**
+ * Get the correction for a device
+ * @param mac Device MAC address
+ * @param out Correction (identity if the device has no entry)
+ */
+void calibration_lookup(const uint8_t mac[6], calibration_t *out);
+
+/**
+ * Correct sensor samples in place (accelerometer and gyro fields)
+ * @param cal Correction
+ * @param samples Samples
+ * @param count Number of samples
+ */
+void calibration_apply(const calibration_t *cal, sensor_data_t *samples, int count);
+
+/**
+ * Correct channel vectors in place (e.g. dequantized IMPACT_BURST samples)
+ * @param cal Correction
+ * @param samples Samples in channel order ax, ay, az, gx, gy, gz
+ * @param count Number of samples
+ */
+void calibration_apply_channels(const calibration_t *cal, float (*samples)[CALIBRATION_CHANNELS], int count);
+
+#endif // _CALIBRATION_H_
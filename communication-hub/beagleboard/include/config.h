@@ -0,0 +1,115 @@
+// Hub Configuration - Hot-reloadable detector settings
+// Settings are published as immutable snapshots. Detector workers read the
+// current snapshot with a single atomic pointer load and never take a lock;
+// a reload swaps the pointer and frees the old snapshot only after every
+// registered worker has passed a quiescent point (RCU/QSBR style).
+
+#ifndef _CONFIG_H_
+#define _CONFIG_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "protocol.h"
+
+// Maximum number of worker threads that may read configuration snapshots
+#define CONFIG_MAX_READERS 16
+
+// Accepted ranges; a file or update outside them is rejected as a whole
+#define CONFIG_THRESHOLD_MIN_G      1.5f    // Same range as the wearable
+#define CONFIG_THRESHOLD_MAX_G      16.0f
+#define CONFIG_GRAVITY_MIN          9.0f    // m/s^2
+#define CONFIG_GRAVITY_MAX          10.5f
+#define CONFIG_RECOVERY_MARGIN_MAX  10.0f   // m/s^2 (must be > 0)
+#define CONFIG_SUSPECT_TIMEOUT_MIN_MS 100
+#define CONFIG_SUSPECT_TIMEOUT_MAX_MS 60000
+#define CONFIG_ALERT_TIMEOUT_MIN_S  1
+#define CONFIG_ALERT_TIMEOUT_MAX_S  3600
+#define CONFIG_SAMPLING_RATE_MIN_HZ 1
+#define CONFIG_SAMPLING_RATE_MAX_HZ 1000
+#define CONFIG_HEARTRATE_MIN_BPM    20      // Limits must lie within this range
+#define CONFIG_HEARTRATE_MAX_BPM    250
+
+// Immutable configuration snapshot (never modified after publication)
+typedef struct {
+    float fall_threshold_g;       // Impact threshold (g)
+    float normal_gravity;         // Gravity reference (m/s^2)
+    float recovery_margin;        // Return-to-normal margin above gravity (m/s^2)
+    uint32_t suspect_timeout_ms;  // FALL_SUSPECTED auto-reset (ms)
+    uint32_t alert_timeout_s;     // User response countdown (seconds)
+    uint32_t sampling_rate_hz;    // Requested wearable sampling rate (Hz)
+    uint32_t heartrate_min;       // Low heart rate limit (bpm)
+    uint32_t heartrate_max;       // High heart rate limit (bpm)
+    uint32_t version;             // Incremented on every publication
+} hub_config_t;
+
+/**
+ * Load the configuration file and publish the first snapshot
+ * Missing keys keep their built-in defaults.
+ * @param path Path to config.json
+ * @return true if successful, false otherwise
+ */
+bool config_init(const char *path);
+
+/**
+ * Get the current configuration snapshot (lock-free, one atomic load)
+ * The pointer stays valid until the calling reader's next quiescent point.
+ * @return Current snapshot (never NULL after config_init)
+ */
+const hub_config_t *config_acquire(void);
+
+/**
+ * Register the calling worker as a snapshot reader
+ * @return Reader id, or -1 if all slots are taken
+ */
+int config_reader_register(void);
+
+/**
+ * Report that a reader holds no snapshot pointers
+ * Workers call this between samples (e.g. once per processed frame).
+ * @param reader Reader id from config_reader_register()
+ */
+void config_quiescent(int reader);
+
+/**
+ * Mark a reader as offline (e.g. before blocking on I/O)
+ * An offline reader never delays reclamation.
+ * @param reader Reader id from config_reader_register()
+ */
+void config_reader_offline(int reader);
+
+/**
+ * Mark a reader as online again after config_reader_offline()
+ * @param reader Reader id from config_reader_register()
+ */
+void config_reader_online(int reader);
+
+/**
+ * Release a reader slot
+ * @param reader Reader id from config_reader_register()
+ */
+void config_reader_unregister(int reader);
+
+/**
+ * Re-read the configuration file and publish a new snapshot
+ * Blocks until no reader can still hold the previous snapshot.
+ * Must not be called from a registered reader that is online.
+ * @return true if successful, false if the file could not be read or a
+ *         value is out of range (the current snapshot stays)
+ */
+bool config_reload(void);
+
+/**
+ * Apply a CFG_xxx setting from the hub side (operator tools) and publish a
+ * new snapshot. CONFIG is hub-to-wearable traffic: never pass it frames
+ * received from a wearable.
+ * @param cfg Configuration payload
+ * @return true if the id is known and the value is in range and was applied
+ */
+bool config_apply(const config_t *cfg);
+
+/**
+ * Cleanup and release configuration resources
+ */
+void config_cleanup(void);
+
+#endif // _CONFIG_H_
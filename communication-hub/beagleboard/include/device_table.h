@@ -0,0 +1,61 @@
+// Device Table - Per-wearable state keyed by MAC address
+
+#ifndef _DEVICE_TABLE_H_
+#define _DEVICE_TABLE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "calibration.h"
+#include "fall_classifier.h"
+#include "fall_detector.h"
+#include "heartrate_analyzer.h"
+#include "history.h"
+#include "orientation.h"
+
+// Maximum number of wearables served by one hub
+#define DEVICE_TABLE_SIZE 64
+
+// Wearables that keep sensor history (one ~1.4 MB pyramid each, reserved at
+// startup); later devices are served without history
+#define DEVICE_HISTORY_MAX 16
+
+// IMPACT_BURST reception after a FALL_DETECTED
+typedef struct {
+    uint16_t id;                // burst_id being received
+    uint8_t next_chunk;         // Chunk number expected next
+    uint16_t samples;           // Samples decoded so far
+    uint16_t lost_chunks;       // Gaps in chunk numbers
+    float peak;                 // Peak |a| in the window (m/s^2)
+    int16_t peak_index;         // Sample index of the peak relative to the impact
+} burst_rx_t;
+
+typedef struct {
+    bool in_use;
+    uint8_t mac[6];
+    uint32_t rx_count;          // Frames received from this device
+    fall_detector_t fall;       // Fall detector state
+    orientation_t orientation;  // Orientation filter (fed every SENSOR_DATA)
+    fall_event_t event;         // Candidate fall being summarized for the classifier
+    hr_analyzer_t hr;           // Heart rate window
+    history_t *history;         // Downsampled sensor history (from the pool on first contact, or NULL)
+    burst_rx_t burst;           // Impact burst in progress
+    fall_replay_t replay;       // Burst samples replayed through the fall chain for the classifier
+    uint64_t report_ms;         // Hub time of a FALL_DETECTED not yet classified (0 = none)
+    calibration_t calibration;  // IMU correction (identity if uncalibrated)
+} device_t;
+
+/**
+ * Find a device, adding it on first contact
+ * @param mac Device MAC address
+ * @return Device entry, or NULL if the table is full
+ */
+device_t *device_table_lookup(const uint8_t mac[6]);
+
+/**
+ * Get a device entry by slot index (for iteration)
+ * @param index Slot index (0 to DEVICE_TABLE_SIZE-1)
+ * @return Device entry, or NULL if the slot is unused
+ */
+device_t *device_table_at(int index);
+
+#endif // _DEVICE_TABLE_H_
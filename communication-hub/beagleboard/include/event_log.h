@@ -0,0 +1,84 @@
+// Event Log - Crash-safe write-ahead log for alert events
+// FALL_DETECTED, state transitions and USER_RESPONSE events are appended as
+// fixed-size CRC-protected records. A flusher thread group-commits pending
+// records with one write + fdatasync per batch. Every EVENT_LOG_CHECKPOINT_INTERVAL
+// records the per-device alert state is checkpointed and the log truncated, so
+// recovery replays at most one interval regardless of how long the hub has run.
+
+#ifndef _EVENT_LOG_H_
+#define _EVENT_LOG_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Records between checkpoints (bounds recovery time)
+#define EVENT_LOG_CHECKPOINT_INTERVAL 4096
+
+// Maximum time a record waits before its batch is flushed (ms)
+#define EVENT_LOG_FLUSH_DELAY_MS 10
+
+// Devices tracked in the alert state table
+#define EVENT_LOG_MAX_DEVICES 64
+
+// Event types
+typedef enum {
+    EVENT_FALL_DETECTED = 1,    // PKT_FALL_DETECTED from a wearable
+    EVENT_STATE_CHANGE = 2,     // Hub detector changed STATE_xxx
+    EVENT_USER_RESPONSE = 3     // PKT_USER_RESPONSE from a wearable
+} event_type_t;
+
+// Event to append
+typedef struct {
+    uint8_t mac[6];             // Device MAC
+    uint8_t type;               // event_type_t
+    uint8_t state;              // STATE_xxx after the event
+    uint8_t severity;           // Fall severity (FALL_DETECTED)
+    uint8_t response;           // USER_xxx (USER_RESPONSE)
+    uint64_t time_ms;           // Hub time (ms since epoch)
+} event_t;
+
+// Per-device alert state rebuilt on recovery
+typedef struct {
+    uint8_t mac[6];
+    uint8_t state;              // STATE_xxx
+    uint8_t severity;           // Last fall severity
+    uint8_t last_response;      // Last USER_xxx
+    uint64_t last_fall_ms;      // Time of last FALL_DETECTED (0 = none)
+    uint64_t last_event_ms;     // Time of last event
+} alert_state_t;
+
+/**
+ * Open the log directory, recover state and start the flusher thread
+ * @param dir Directory holding wal.log and checkpoint.bin (must exist)
+ * @return true if successful, false otherwise
+ */
+bool event_log_init(const char *dir);
+
+/**
+ * Append an event (does not block on disk I/O)
+ * @param event Event to append
+ * @return Log sequence number of the record, or 0 on error
+ */
+uint64_t event_log_append(const event_t *event);
+
+/**
+ * Block until a record is durable on disk
+ * @param lsn Sequence number from event_log_append()
+ * @return true once durable, false if the log failed or was closed
+ */
+bool event_log_wait(uint64_t lsn);
+
+/**
+ * Copy the current per-device alert state (e.g. after recovery)
+ * @param out Output array
+ * @param max Capacity of 'out'
+ * @return Number of entries written
+ */
+int event_log_alert_states(alert_state_t *out, int max);
+
+/**
+ * Flush pending records, stop the flusher and close the log
+ */
+void event_log_cleanup(void);
+
+#endif // _EVENT_LOG_H_
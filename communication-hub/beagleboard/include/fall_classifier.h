@@ -0,0 +1,212 @@
+// Fall Classifier - Confirms candidate fall events with a tree ensemble
+// The threshold detector flags every sample above fall_threshold_g, which also
+// fires on sitting down hard, jumping and stairs. fall_event_t follows each
+// candidate from its first sample above the threshold until the posture has
+// settled (FALL_POSTURE_SETTLE_MS after the last one) and summarizes it as
+// FALL_FEATURE_COUNT features: impact, free fall before it, jerk, tilt before
+// and after, and stillness once settled. The tilt before is taken a second
+// ahead of the first sample, since a falling body has mostly turned by the
+// time it hits the ground. Jerk and stillness come from the common/features.h
+// kernels, fed with every sample.
+//
+// The classifier quantizes the features to int8 and sums the int8 leaves of a
+// boosted ensemble of oblivious decision trees (every node on one level tests
+// the same feature and threshold, so a tree is FALL_MODEL_DEPTH compares that
+// build a leaf index, without branches). The model is constexpr tables in
+// fall_model.h, generated by testing/fall-detection-tests/falltrain, so
+// nothing is parsed or allocated at runtime.
+//
+// fall_replay_t runs a wearable's full-rate IMPACT_BURST window through its
+// own detector, orientation filter and event tracker, so a reported impact is
+// classified at the rate the model was trained at even when the live stream
+// is slower. An event still open at the end of the window is closed there.
+//
+// fall_batch_t scores many events at once in SoA form (one row per feature),
+// one tree at a time across every event, so the tree's tables stay in cache
+// and the loop over events can be vectorized.
+
+#ifndef _FALL_CLASSIFIER_H_
+#define _FALL_CLASSIFIER_H_
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "protocol.h"
+#include "common/features.h"
+#include "fall_detector.h"
+#include "orientation.h"
+
+// Event summary, in model input order
+typedef enum {
+    FALL_FEATURE_PEAK_G = 0,    // Peak |a| during the event (g)
+    FALL_FEATURE_PRE_MIN_G,     // Lowest |a| in the second before it (g)
+    FALL_FEATURE_JERK_GPS,      // Peak |a[t] - a[t-1]| between samples (g/s)
+    FALL_FEATURE_TILT_BEFORE,   // Tilt from upright a second before it (degrees)
+    FALL_FEATURE_TILT_AFTER,    // Tilt once settled (degrees)
+    FALL_FEATURE_TILT_CHANGE,   // |after - before| (degrees)
+    FALL_FEATURE_STILL_G,       // Std dev of |a| over the last FALL_EVENT_STILL_SAMPLES (g)
+    FALL_FEATURE_DURATION_S,    // First to last sample above the threshold (s)
+    FALL_FEATURE_COUNT
+} fall_feature_t;
+
+// |a| and tilt history kept per device (samples; 1.28 s at 100 Hz)
+#define FALL_EVENT_HISTORY 128
+
+// Look-back before the event for free fall and the tilt before (ms)
+#define FALL_EVENT_PRE_MS 1000
+
+// Stillness window ending at the settle point (samples; 500 ms at the 100 Hz
+// the model is trained at)
+#define FALL_EVENT_STILL_SAMPLES 50
+
+// Events per batch (matches DEVICE_TABLE_SIZE)
+#define FALL_CLASSIFIER_BATCH_MAX 64
+
+// Per-device event tracker
+typedef struct {
+    float magnitude[FALL_EVENT_HISTORY];    // Ring of recent |a| (m/s^2)
+    float tilt_deg[FALL_EVENT_HISTORY];     // Tilt from upright (degrees)
+    uint32_t time_ms[FALL_EVENT_HISTORY];   // Sample timestamps
+    uint32_t head;                          // Next write index
+    uint32_t count;                         // Valid entries
+    feature_jerk_t<1, float> jerk;          // Sample-to-sample jerk (the event keeps its own peak)
+    feature_still_t<FALL_EVENT_STILL_SAMPLES, float> still;  // |a| variance, settle window
+    bool open;                              // Event in progress
+    uint32_t start_ms;                      // First sample above the threshold
+    uint32_t end_ms;                        // Last sample above the threshold
+    float features[FALL_FEATURE_COUNT];     // Summary (complete once closed)
+} fall_event_t;
+
+// Replay of one impact burst
+typedef struct {
+    fall_detector_t fall;
+    orientation_t orientation;
+    fall_event_t event;
+    bool done;                  // Event summarized (event.features is valid)
+} fall_replay_t;
+
+// Events to score, one lane each
+typedef struct {
+    int8_t features[FALL_FEATURE_COUNT][FALL_CLASSIFIER_BATCH_MAX];
+    int count;                  // Lanes in use
+} fall_batch_t;
+
+/**
+ * Quantize one feature to the model's int8 input
+ * @param x Feature value
+ * @param offset, scale Model quantization (q = (x - offset) * scale)
+ * @return Rounded and saturated value
+ */
+static inline int8_t fall_classifier_quantize_value(float x, float offset, float scale)
+{
+    float q = rintf((x - offset) * scale);
+    q = (q > 127.0f) ? 127.0f : (q < -128.0f ? -128.0f : q);
+    return (int8_t)q;
+}
+
+/**
+ * Reset an event tracker
+ * @param ev Tracker state
+ */
+void fall_event_init(fall_event_t *ev);
+
+/**
+ * Process one sample after the fall detector and orientation filter
+ * @param ev Tracker state
+ * @param data Sensor sample
+ * @param det Fall detector, already updated with this sample
+ * @param orient Orientation filter, already updated with this sample
+ * @return true when an event has settled; ev->features holds its summary
+ */
+bool fall_event_update(fall_event_t *ev, const sensor_data_t *data,
+                       const fall_detector_t *det, const orientation_t *orient);
+
+/**
+ * Close an event that has not settled, summarizing it as of the newest sample
+ * @param ev Tracker state
+ * @return true if an event was open; ev->features holds its summary
+ */
+bool fall_event_close(fall_event_t *ev);
+
+/**
+ * Start replaying a new burst window
+ * @param replay Replay state
+ */
+void fall_replay_init(fall_replay_t *replay);
+
+/**
+ * Feed one burst sample, in window order (lost chunks leave a time gap)
+ * @param replay Replay state
+ * @param index Sample index relative to the impact (negative = before)
+ * @param rate_hz Capture rate
+ * @param accel Calibrated acceleration (m/s^2)
+ * @param gyro Calibrated rotation rate (rad/s)
+ * @param cfg Configuration snapshot (fall threshold)
+ * @return true when the event has settled; replay->event.features holds its summary
+ */
+bool fall_replay_update(fall_replay_t *replay, int index, uint16_t rate_hz,
+                        const float accel[3], const float gyro[3], const hub_config_t *cfg);
+
+/**
+ * End of the window: close an event that has not settled
+ * @param replay Replay state
+ * @return true if an event was closed here; replay->event.features holds its summary
+ */
+bool fall_replay_finish(fall_replay_t *replay);
+
+/**
+ * Feature name ("peak_g", "tilt_change", ...)
+ * @param feature FALL_FEATURE_xxx
+ * @return Name
+ */
+const char *fall_feature_name(int feature);
+
+/**
+ * Quantize an event summary to the model's int8 inputs
+ * @param features FALL_FEATURE_COUNT values
+ * @param out Quantized values
+ */
+void fall_classifier_quantize(const float features[FALL_FEATURE_COUNT], int8_t out[FALL_FEATURE_COUNT]);
+
+/**
+ * Score one event
+ * @param features Quantized features
+ * @return Log-odds of a fall in leaf units (> 0 means fall)
+ */
+int32_t fall_classifier_score(const int8_t features[FALL_FEATURE_COUNT]);
+
+/**
+ * Whether a score means a fall
+ * @param score From fall_classifier_score() or fall_classifier_batch_score()
+ */
+bool fall_classifier_is_fall(int32_t score);
+
+/**
+ * Fall probability for a score
+ * @param score Log-odds in leaf units
+ * @return Probability (0-1)
+ */
+float fall_classifier_probability(int32_t score);
+
+/**
+ * Empty a batch
+ * @param batch Batch state
+ */
+void fall_classifier_batch_init(fall_batch_t *batch);
+
+/**
+ * Quantize an event summary into the next lane
+ * @param batch Batch state
+ * @param features FALL_FEATURE_COUNT values
+ * @return Lane index, or -1 if the batch is full
+ */
+int fall_classifier_batch_add(fall_batch_t *batch, const float features[FALL_FEATURE_COUNT]);
+
+/**
+ * Score every lane
+ * @param batch Batch state
+ * @param scores One score per lane (batch->count entries)
+ */
+void fall_classifier_batch_score(const fall_batch_t *batch, int32_t *scores);
+
+#endif // _FALL_CLASSIFIER_H_
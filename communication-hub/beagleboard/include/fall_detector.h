@@ -0,0 +1,47 @@
+// Fall Detector - Per-device threshold detection
+// Port of the hub firmware's simpleFallDetection() with thresholds taken from
+// the live configuration snapshot instead of compile-time constants. With the
+// device's orientation filter it also tracks the tilt and records the posture
+// the wearer settles in after each impact.
+
+#ifndef _FALL_DETECTOR_H_
+#define _FALL_DETECTOR_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "protocol.h"
+#include "config.h"
+#include "orientation.h"
+
+// Posture is recorded this long after the last sample above the threshold (ms)
+#define FALL_POSTURE_SETTLE_MS 1000
+
+// Per-device detector state (survives configuration reloads)
+typedef struct {
+    uint8_t state;              // STATE_xxx
+    float magnitude;            // Last acceleration magnitude (m/s^2)
+    uint32_t last_change_ms;    // Sample timestamp of last state change
+    float tilt_deg;             // Tilt from upright at the last sample (degrees)
+    uint8_t posture;            // POSTURE_xxx settled in after the last impact
+    bool posture_pending;       // Impact seen, posture not yet recorded
+    uint32_t impact_ms;         // Sample timestamp of the last sample above the threshold
+} fall_detector_t;
+
+/**
+ * Reset a detector to STATE_MONITORING
+ * @param det Detector state
+ */
+void fall_detector_init(fall_detector_t *det);
+
+/**
+ * Process one sensor sample
+ * @param det Detector state
+ * @param data Sensor sample
+ * @param orient Device orientation, already updated with this sample (or NULL)
+ * @param cfg Configuration snapshot from config_acquire()
+ * @return true if the detector state changed
+ */
+bool fall_detector_process(fall_detector_t *det, const sensor_data_t *data,
+                           const orientation_t *orient, const hub_config_t *cfg);
+
+#endif // _FALL_DETECTOR_H_
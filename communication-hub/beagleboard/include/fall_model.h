@@ -0,0 +1,90 @@
+// Fall Model - Tables for the fall classifier (fall_classifier.h)
+// Generated by testing/fall-detection-tests/falltrain; do not edit.
+// Corpus: 100 Hz, 40 traces per scenario, seed 1000 (events at that rate, on
+// the 100 ms stream and from impact bursts); 16 trees of depth 4,
+// fall weight 2.0. Validation (seed 1001): 359/363 fall events confirmed,
+// 588/597 other events rejected.
+
+#ifndef _FALL_MODEL_H_
+#define _FALL_MODEL_H_
+
+#include <stdint.h>
+
+#define FALL_MODEL_FEATURES 8
+#define FALL_MODEL_TREES 16
+#define FALL_MODEL_DEPTH 4
+
+// Leaf units per unit of log-odds
+#define FALL_MODEL_LEAF_SCALE 16.0f
+
+// Prior log-odds (leaf units)
+#define FALL_MODEL_BIAS 0
+
+// Input quantization: q = (x - offset) * scale, rounded and saturated to int8
+// (peak_g, pre_min_g, jerk_gps, tilt_before, tilt_after, tilt_change, still_g, duration_s)
+static constexpr float FALL_MODEL_OFFSET[FALL_MODEL_FEATURES] = {
+    3.70301f, 0.959178f, 139.371f, 9.87782f, 47.4636f, 46.5757f, 0.389197f, 4.785f
+};
+static constexpr float FALL_MODEL_SCALE[FALL_MODEL_FEATURES] = {
+    58.5889f, 137.366f, 0.94734f, 12.9205f, 2.67847f, 2.72698f, 333.04f, 26.5413f
+};
+
+// Per tree and level: feature tested and threshold (index bit set when q > threshold)
+static constexpr uint8_t FALL_MODEL_SPLIT_FEATURE[FALL_MODEL_TREES][FALL_MODEL_DEPTH] = {
+    { 4, 0, 3, 3 },
+    { 5, 0, 4, 5 },
+    { 5, 0, 1, 1 },
+    { 4, 0, 1, 4 },
+    { 5, 0, 1, 0 },
+    { 4, 0, 1, 3 },
+    { 4, 0, 6, 6 },
+    { 4, 0, 2, 7 },
+    { 4, 0, 3, 3 },
+    { 4, 0, 1, 2 },
+    { 4, 0, 1, 0 },
+    { 5, 6, 3, 4 },
+    { 5, 6, 7, 2 },
+    { 4, 1, 6, 6 },
+    { 5, 3, 2, 1 },
+    { 4, 0, 2, 1 },
+};
+static constexpr int8_t FALL_MODEL_SPLIT_THRESHOLD[FALL_MODEL_TREES][FALL_MODEL_DEPTH] = {
+    { -25, -122, -128, -128 },
+    { -25, -119, -65, -65 },
+    { -25, -119, -16, -4 },
+    { -25, -119, -13, -65 },
+    { -25, -119, -4, -125 },
+    { -25, -119, -9, -82 },
+    { -65, -119, -88, -93 },
+    { -25, -119, -109, -119 },
+    { -65, -119, -84, -101 },
+    { -25, -119, -13, -126 },
+    { -25, -119, -9, -121 },
+    { 61, -84, -82, -65 },
+    { 61, -84, -114, -114 },
+    { -65, -17, -84, -93 },
+    { 61, -75, -119, -21 },
+    { -65, -119, -126, -9 },
+};
+
+// Per tree: log-odds by leaf index (leaf units)
+static constexpr int8_t FALL_MODEL_LEAF[FALL_MODEL_TREES][1 << FALL_MODEL_DEPTH] = {
+    { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -9, 4, -9, 9 },
+    { -7, 0, -7, 0, 3, 0, 0, 0, 0, 0, 0, 0, -4, 4, -1, 7 },
+    { -6, 6, -6, 6, -5, -2, -6, 6, 0, 0, 0, 0, 0, 0, -6, 3 },
+    { -6, 0, -6, 0, -4, 0, -6, 0, 0, 4, -1, 6, -1, -2, 0, 5 },
+    { -4, 0, 0, 0, -3, 0, 0, 0, -5, 2, -5, 6, 4, 0, -5, 3 },
+    { -5, -1, -5, 5, -3, 2, -5, 3, -4, 5, -5, 5, 4, -2, -4, 2 },
+    { -4, 2, -5, 5, 0, 0, 0, 0, 4, 0, -1, 0, -5, 1, -5, 5 },
+    { -5, 2, -4, 4, 3, 2, -3, 5, -2, -2, -4, 0, -4, -1, -5, 4 },
+    { -2, 2, -5, 5, 0, 0, 0, 0, -4, -6, -2, 4, -1, 4, -4, 4 },
+    { -2, 1, 0, 0, -4, -4, 0, 0, -4, 3, -4, 5, 0, -1, -4, 3 },
+    { -4, 0, 0, 0, 2, 0, 0, 0, 1, 0, -4, 5, -1, 0, -4, 2 },
+    { -2, 0, -4, 0, 3, 0, -4, 0, 0, 4, -4, 3, 3, 2, 2, 1 },
+    { -2, 0, -4, 3, 0, 0, -3, 0, 3, 4, 0, 2, -3, 2, -3, -1 },
+    { -3, 4, -3, 1, 0, 0, 0, 0, -1, 1, 2, 0, -2, 4, -4, -1 },
+    { 0, 2, 1, 0, -1, 4, 0, 1, -4, -1, -3, 0, -2, 2, 5, 1 },
+    { -2, -1, 0, 0, -2, 1, -3, 4, -2, -2, 0, 0, 3, 2, -3, 1 },
+};
+
+#endif // _FALL_MODEL_H_
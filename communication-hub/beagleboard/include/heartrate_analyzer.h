@@ -0,0 +1,72 @@
+// Heart Rate Analyzer - Streaming per-device vitals analysis
+// Keeps a bounded window of BPM/SpO2 readings per device and updates the
+// rolling mean, variance and beat-to-beat variability in O(1) per reading
+// using running integer sums. All state is inline; nothing is allocated.
+
+#ifndef _HEARTRATE_ANALYZER_H_
+#define _HEARTRATE_ANALYZER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "protocol.h"
+#include "config.h"
+
+// Readings kept per device (power of two)
+#define HR_WINDOW_SIZE 32
+
+// Minimum readings before variability is classified
+#define HR_MIN_READINGS 8
+
+// Lowest acceptable SpO2 (%) before a reading is flagged
+#define HR_SPO2_MIN 90
+
+// RMS successive difference (bpm) above which the rhythm is irregular
+#define HR_IRREGULAR_RMSSD 15.0f
+
+typedef struct {
+    uint16_t bpm[HR_WINDOW_SIZE];   // Ring of recent BPM readings
+    uint8_t spo2[HR_WINDOW_SIZE];   // Ring of recent SpO2 readings
+    uint32_t head;                  // Next write index
+    uint32_t count;                 // Valid readings (<= HR_WINDOW_SIZE)
+    uint32_t bpm_sum;               // Sum of bpm[] in window
+    uint64_t bpm_sq_sum;            // Sum of bpm[]^2 in window
+    uint32_t spo2_sum;              // Sum of spo2[] in window
+    uint64_t diff_sq_sum;           // Sum of successive bpm differences squared
+    float baseline_bpm;             // Slow EWMA resting baseline
+    uint8_t status;                 // HR_STATUS_xxx of the last reading
+} hr_analyzer_t;
+
+// Derived statistics for the current window
+typedef struct {
+    float mean_bpm;
+    float stddev_bpm;
+    float rmssd_bpm;        // RMS of successive BPM differences
+    float mean_spo2;
+    float baseline_bpm;
+    uint8_t status;         // HR_STATUS_xxx
+} hr_stats_t;
+
+/**
+ * Reset an analyzer to an empty window
+ * @param hr Analyzer state
+ */
+void hr_analyzer_init(hr_analyzer_t *hr);
+
+/**
+ * Add one reading and classify it (O(1))
+ * @param hr Analyzer state
+ * @param reading Heart rate payload
+ * @param cfg Configuration snapshot (heart rate limits)
+ * @return HR_STATUS_xxx for this reading
+ */
+uint8_t hr_analyzer_update(hr_analyzer_t *hr, const heartrate_t *reading,
+                           const hub_config_t *cfg);
+
+/**
+ * Get rolling statistics for the current window (O(1))
+ * @param hr Analyzer state
+ * @param stats Output statistics
+ */
+void hr_analyzer_stats(const hr_analyzer_t *hr, hr_stats_t *stats);
+
+#endif // _HEARTRATE_ANALYZER_H_
@@ -0,0 +1,43 @@
+// Heart Rate Simulator - Synthetic PKT_HEARTRATE source for testing
+// Produces deterministic heartrate_t readings for a given rhythm profile so
+// the analyzer can be exercised without the wearable's heart rate sensor.
+
+#ifndef _HEARTRATE_SIM_H_
+#define _HEARTRATE_SIM_H_
+
+#include <stdint.h>
+#include "protocol.h"
+
+typedef enum {
+    HR_SIM_NORMAL = 0,      // Resting sinus rhythm (~70 bpm)
+    HR_SIM_BRADYCARDIA,     // Slow rhythm (~35 bpm, below the 40 bpm default limit)
+    HR_SIM_TACHYCARDIA,     // Fast rhythm (~165 bpm)
+    HR_SIM_IRREGULAR,       // Large beat-to-beat jumps (AF-like)
+    HR_SIM_HYPOXIA          // Normal rate, falling SpO2
+} hr_sim_profile_t;
+
+typedef struct {
+    hr_sim_profile_t profile;
+    uint32_t seed;          // PRNG state (xorshift32)
+    uint32_t timestamp;     // Next reading timestamp (ms)
+    uint32_t interval_ms;   // Reading interval (ms)
+    uint32_t count;         // Readings produced
+} hr_sim_t;
+
+/**
+ * Initialize a simulated sensor
+ * @param sim Simulator state
+ * @param profile Rhythm profile
+ * @param seed Non-zero seed for reproducible output
+ * @param interval_ms Reading interval (ms)
+ */
+void hr_sim_init(hr_sim_t *sim, hr_sim_profile_t profile, uint32_t seed, uint32_t interval_ms);
+
+/**
+ * Produce the next reading
+ * @param sim Simulator state
+ * @param reading Output heart rate payload
+ */
+void hr_sim_next(hr_sim_t *sim, heartrate_t *reading);
+
+#endif // _HEARTRATE_SIM_H_
@@ -0,0 +1,106 @@
+// Sensor History - Multi-resolution min/max/mean pyramid
+// Every ingested sample updates the current bucket of each level (1 s, 10 s,
+// 1 min, 10 min) in O(levels). Range queries pick the coarsest level that is
+// still at least as fine as one output point, so the work done is proportional
+// to the number of points requested rather than the number of raw samples.
+//
+// Pyramids are fixed-size blocks from a pool reserved once at startup
+// (history_pool_init()), so adding a device on the ingest path never touches
+// the heap. A pyramid is not internally locked; query it from the ingest
+// thread or serialize access externally.
+
+#ifndef _HISTORY_H_
+#define _HISTORY_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "protocol.h"
+#include "common/pool.h"
+
+// Fields summarized per bucket
+typedef enum {
+    HISTORY_ACCEL_MAG = 0,  // Acceleration magnitude (m/s^2)
+    HISTORY_ACCEL_X,
+    HISTORY_ACCEL_Y,
+    HISTORY_ACCEL_Z,
+    HISTORY_GYRO_X,
+    HISTORY_GYRO_Y,
+    HISTORY_GYRO_Z,
+    HISTORY_TEMPERATURE,
+    HISTORY_FIELD_COUNT
+} history_field_t;
+
+// Pyramid levels
+#define HISTORY_LEVEL_COUNT 4
+
+// Summary of one time range
+typedef struct {
+    uint64_t start_ms;                  // Range start (hub time)
+    uint32_t count;                     // Samples in range (0 = no data)
+    float min[HISTORY_FIELD_COUNT];
+    float max[HISTORY_FIELD_COUNT];
+    float mean[HISTORY_FIELD_COUNT];
+} history_point_t;
+
+typedef struct history history_t;
+
+/**
+ * Reserve storage for 'count' pyramids (~1.4 MB each); call once at startup
+ * @param count Pyramids that can exist at once
+ * @return true on success, false if out of memory or already reserved
+ */
+bool history_pool_init(uint16_t count);
+
+/**
+ * Read the pyramid pool counters (failures = devices left without history)
+ * @param stats Output counters
+ */
+void history_pool_stats(pool_stats_t *stats);
+
+/**
+ * Release the storage reserved by history_pool_init()
+ * Every pyramid must have been destroyed.
+ */
+void history_pool_cleanup(void);
+
+/**
+ * Take an empty pyramid from the pool (no heap allocation)
+ * @return Pyramid, or NULL if the pool is exhausted or not reserved
+ */
+history_t *history_create(void);
+
+/**
+ * Add one sample to every level (O(levels), no allocation)
+ * @param hist Pyramid
+ * @param time_ms Hub receive time (ms since epoch)
+ * @param data Sensor sample
+ */
+void history_add(history_t *hist, uint64_t time_ms, const sensor_data_t *data);
+
+/**
+ * Summarize [start_ms, end_ms) as 'points' equal-width output points
+ * Points past the newest sample are returned empty without being scanned.
+ * @param hist Pyramid
+ * @param start_ms Range start (ms since epoch)
+ * @param end_ms Range end (ms since epoch)
+ * @param points Number of output points (e.g. chart width in pixels)
+ * @param out Output array of 'points' entries
+ * @return Bucket width used (ms), or 0 on error
+ */
+uint32_t history_query(const history_t *hist, uint64_t start_ms, uint64_t end_ms,
+                       uint32_t points, history_point_t *out);
+
+/**
+ * Get the bucket width of a level
+ * @param level Level index (0 = finest)
+ * @return Bucket width (ms)
+ */
+uint32_t history_level_width(int level);
+
+/**
+ * Return a pyramid to the pool
+ * @param hist Pyramid (may be NULL)
+ */
+void history_destroy(history_t *hist);
+
+#endif // _HISTORY_H_
@@ -0,0 +1,64 @@
+// Hub Link - Frames forwarded by the ESP32 hub over UART
+// Each frame is a protocol.h packet (START/LENGTH/TYPE/PAYLOAD/CRC16/END)
+// whose payload starts with the source wearable's MAC, so the BeagleBoard can
+// keep per-device state for every wearable paired with the hub. A packet with
+// a bad END byte or CRC is dropped one byte at a time until the next START
+// byte lines up, so a lost or extra UART byte only costs the packets it hits.
+
+#ifndef _HUB_LINK_H_
+#define _HUB_LINK_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "protocol.h"
+
+// Receive buffer: two full packets, so one can be completed behind a partial one
+#define HUB_LINK_BUFFER_SIZE (2 * (PROTOCOL_MAX_PAYLOAD + 6))
+
+typedef struct {
+    uint8_t mac[6];                         // Source wearable MAC
+    uint8_t type;                           // PKT_xxx
+    uint8_t length;                         // Payload length
+    uint8_t payload[PROTOCOL_MAX_PAYLOAD];  // Raw payload (e.g. sensor_data_t)
+} hub_frame_t;
+
+typedef struct {
+    int fd;
+    uint8_t buffer[HUB_LINK_BUFFER_SIZE];
+    uint32_t len;                           // Bytes buffered
+    uint32_t frames;                        // Packets decoded
+    uint32_t crc_errors;                    // Packets dropped (bad CRC, END or length)
+    uint32_t skipped_bytes;                 // Bytes discarded while resynchronizing
+} hub_link_t;
+
+/**
+ * Open the link to the ESP32 hub. A tty is switched to raw mode at
+ * PROTOCOL_HUB_LINK_BAUD; files and stdin are read as they are.
+ * @param link Link state
+ * @param path UART device (e.g. /dev/ttyS1), recorded capture file, or "-" for stdin
+ * @return true on success
+ */
+bool hub_link_open(hub_link_t *link, const char *path);
+
+/**
+ * Read one frame (blocking), skipping corrupted packets
+ * @param link Link state
+ * @param frame Output frame
+ * @return true if a complete frame was read, false on EOF or error
+ */
+bool hub_link_read(hub_link_t *link, hub_frame_t *frame);
+
+/**
+ * Whether the next read would return without waiting
+ * @param link Link state
+ * @return true if a complete packet is buffered or input is ready (always for a capture file)
+ */
+bool hub_link_pending(const hub_link_t *link);
+
+/**
+ * Close the link
+ * @param link Link state
+ */
+void hub_link_close(hub_link_t *link);
+
+#endif // _HUB_LINK_H_
@@ -0,0 +1,140 @@
+// Orientation - Incremental per-device orientation filter
+// Madgwick's gyro + accelerometer (IMU) filter, fed one SENSOR_DATA sample at
+// a time: the gyro rates are integrated into a quaternion, and a gradient
+// step of gain ORIENTATION_BETA pulls it toward the measured gravity. The
+// correction is skipped while |a| is far from 1 g (impacts, free fall), when
+// the accelerometer does not measure gravity. About 60 flops and two inverse
+// square roots per sample.
+//
+// The hub sees SENSOR_DATA only while the activity gate streams, so a gap
+// longer than ORIENTATION_MAX_GAP_MS re-seeds the filter from the
+// accelerometer instead of integrating across it.
+//
+// Postures assume the wearable's frame when standing: Z up, X forward,
+// Y to the wearer's left.
+//
+// orientation_batch_t runs the same filter for many devices in SoA form
+// (one array per quaternion component), one sample per device per call, with
+// a branch-free loop body the compiler can vectorize.
+
+#ifndef _ORIENTATION_H_
+#define _ORIENTATION_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "protocol.h"
+
+// Filter gain (rad/s): higher trusts the accelerometer more
+#define ORIENTATION_BETA 0.1f
+
+// Accelerometer correction only while ||a| - g| is below this (m/s^2)
+#define ORIENTATION_ACCEL_GATE 2.5f
+
+// Longer gaps between samples re-seed from the accelerometer (ms)
+#define ORIENTATION_MAX_GAP_MS 500
+
+// Devices per batch (matches DEVICE_TABLE_SIZE)
+#define ORIENTATION_BATCH_MAX 64
+
+// Body posture from the direction of gravity
+typedef enum {
+    POSTURE_UNKNOWN = 0,
+    POSTURE_UPRIGHT,            // Within 45 degrees of vertical
+    POSTURE_PRONE,              // Lying face down (X down)
+    POSTURE_SUPINE,             // Lying face up (X up)
+    POSTURE_LEFT_SIDE,          // Lying on the left side (Y down)
+    POSTURE_RIGHT_SIDE,         // Lying on the right side (Y up)
+    POSTURE_INVERTED            // Z down
+} posture_t;
+
+typedef struct {
+    float q0, q1, q2, q3;       // Device-to-world quaternion (w, x, y, z)
+    uint32_t last_ms;           // Timestamp of the last sample
+    bool seeded;                // false until the first sample
+} orientation_t;
+
+// Per-device filter state, one lane per device
+typedef struct {
+    float q0[ORIENTATION_BATCH_MAX];
+    float q1[ORIENTATION_BATCH_MAX];
+    float q2[ORIENTATION_BATCH_MAX];
+    float q3[ORIENTATION_BATCH_MAX];
+    int count;                  // Lanes in use
+} orientation_batch_t;
+
+// One sample per lane
+typedef struct {
+    float ax[ORIENTATION_BATCH_MAX];
+    float ay[ORIENTATION_BATCH_MAX];
+    float az[ORIENTATION_BATCH_MAX];
+    float gx[ORIENTATION_BATCH_MAX];
+    float gy[ORIENTATION_BATCH_MAX];
+    float gz[ORIENTATION_BATCH_MAX];
+} orientation_input_t;
+
+/**
+ * Reset a filter; the next sample seeds it
+ * @param o Filter state
+ */
+void orientation_init(orientation_t *o);
+
+/**
+ * Process one sensor sample
+ * @param o Filter state
+ * @param data Sample (calibrated, SI units)
+ */
+void orientation_update(orientation_t *o, const sensor_data_t *data);
+
+/**
+ * Angle between the device's Z axis and vertical
+ * @param o Filter state
+ * @return Tilt (degrees, 0 upright, 180 upside down)
+ */
+float orientation_tilt_deg(const orientation_t *o);
+
+/**
+ * Classify the current posture
+ * @param o Filter state
+ * @return POSTURE_xxx (POSTURE_UNKNOWN before the first sample)
+ */
+posture_t orientation_posture(const orientation_t *o);
+
+/**
+ * Posture name ("UPRIGHT", "PRONE", ...)
+ * @param posture POSTURE_xxx
+ * @return Name
+ */
+const char *orientation_posture_name(posture_t posture);
+
+/**
+ * Reset a batch to 'count' lanes, each seeded upright
+ * @param batch Batch state
+ * @param count Lanes (at most ORIENTATION_BATCH_MAX)
+ */
+void orientation_batch_init(orientation_batch_t *batch, int count);
+
+/**
+ * Seed one lane from an accelerometer reading
+ * @param batch Batch state
+ * @param lane Lane index
+ * @param ax, ay, az Acceleration (m/s^2)
+ */
+void orientation_batch_seed(orientation_batch_t *batch, int lane, float ax, float ay, float az);
+
+/**
+ * Process one sample for every lane
+ * @param batch Batch state
+ * @param in Samples, one per lane
+ * @param dt Sample interval (s)
+ */
+void orientation_batch_update(orientation_batch_t *batch, const orientation_input_t *in, float dt);
+
+/**
+ * Tilt of one lane (see orientation_tilt_deg())
+ * @param batch Batch state
+ * @param lane Lane index
+ * @return Tilt (degrees)
+ */
+float orientation_batch_tilt_deg(const orientation_batch_t *batch, int lane);
+
+#endif // _ORIENTATION_H_
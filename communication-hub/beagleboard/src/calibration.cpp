@@ -0,0 +1,112 @@
+// Sensor Calibration - Per-wearable IMU bias/scale correction
+#include "calibration.h"
+#include <stdio.h>
+#include <string.h>
+
+typedef struct {
+    uint8_t mac[6];
+    calibration_t cal;
+} calibration_entry_t;
+
+static calibration_entry_t table[CALIBRATION_TABLE_SIZE];
+static int table_count = 0;
+
+static void set_identity(calibration_t *cal)
+{
+    for (int i = 0; i < CALIBRATION_CHANNELS; i++) {
+        cal->gain[i] = 1.0f;
+        cal->offset[i] = 0.0f;
+    }
+    cal->calibrated = false;
+}
+
+int calibration_load(const char *path)
+{
+    table_count = 0;
+
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        printf("Calibration - No calibration file %s, using raw sensor values\n", path);
+        return 0;
+    }
+
+    char line[512];
+    int line_number = 0;
+    while (fgets(line, sizeof(line), file) != NULL) {
+        line_number++;
+        if (line[0] == '#' || line[0] == '\n' || line[0] == '\r') {
+            continue;
+        }
+
+        unsigned mac[6];
+        float bias[CALIBRATION_CHANNELS], scale[CALIBRATION_CHANNELS];
+        int fields = sscanf(line, "%x:%x:%x:%x:%x:%x,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f",
+                            &mac[0], &mac[1], &mac[2], &mac[3], &mac[4], &mac[5],
+                            &bias[0], &bias[1], &bias[2], &bias[3], &bias[4], &bias[5],
+                            &scale[0], &scale[1], &scale[2], &scale[3], &scale[4], &scale[5]);
+        bool valid = (fields == 18);
+        for (int i = 0; valid && i < CALIBRATION_CHANNELS; i++) {
+            valid = scale[i] > 0.5f && scale[i] < 2.0f;
+        }
+        if (!valid) {
+            printf("Calibration - %s:%d malformed or implausible, ignoring the file\n", path, line_number);
+            fclose(file);
+            table_count = 0;
+            return -1;
+        }
+        if (table_count == CALIBRATION_TABLE_SIZE) {
+            printf("Calibration - More than %d entries, ignoring the rest\n", CALIBRATION_TABLE_SIZE);
+            break;
+        }
+
+        calibration_entry_t *entry = &table[table_count++];
+        for (int i = 0; i < 6; i++) {
+            entry->mac[i] = (uint8_t)mac[i];
+        }
+        // (raw - bias) / scale folded into raw * gain + offset
+        for (int i = 0; i < CALIBRATION_CHANNELS; i++) {
+            entry->cal.gain[i] = 1.0f / scale[i];
+            entry->cal.offset[i] = -bias[i] / scale[i];
+        }
+        entry->cal.calibrated = true;
+    }
+
+    fclose(file);
+    printf("Calibration - %d devices loaded from %s\n", table_count, path);
+    return table_count;
+}
+
+void calibration_lookup(const uint8_t mac[6], calibration_t *out)
+{
+    for (int i = 0; i < table_count; i++) {
+        if (memcmp(table[i].mac, mac, 6) == 0) {
+            *out = table[i].cal;
+            return;
+        }
+    }
+    set_identity(out);
+}
+
+void calibration_apply(const calibration_t *cal, sensor_data_t *samples, int count)
+{
+    const float *g = cal->gain;
+    const float *o = cal->offset;
+    for (int i = 0; i < count; i++) {
+        sensor_data_t *s = &samples[i];
+        s->accel_x = s->accel_x * g[0] + o[0];
+        s->accel_y = s->accel_y * g[1] + o[1];
+        s->accel_z = s->accel_z * g[2] + o[2];
+        s->gyro_x = s->gyro_x * g[3] + o[3];
+        s->gyro_y = s->gyro_y * g[4] + o[4];
+        s->gyro_z = s->gyro_z * g[5] + o[5];
+    }
+}
+
+void calibration_apply_channels(const calibration_t *cal, float (*samples)[CALIBRATION_CHANNELS], int count)
+{
+    for (int i = 0; i < count; i++) {
+        for (int c = 0; c < CALIBRATION_CHANNELS; c++) {
+            samples[i][c] = samples[i][c] * cal->gain[c] + cal->offset[c];
+        }
+    }
+}
@@ -0,0 +1,319 @@
+// Hub Configuration - Snapshot publication and reclamation
+#include "config.h"
+#include "common/pool.h"
+#include <atomic>
+#include <math.h>
+#include <mutex>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define CONFIG_MAX_FILE_SIZE 8192
+
+// Per-worker reader slot (padded to avoid false sharing between workers)
+typedef struct {
+    alignas(64) std::atomic<bool> in_use;
+    std::atomic<bool> online;
+    std::atomic<uint64_t> seen_epoch;
+} reader_slot_t;
+
+static std::atomic<const hub_config_t *> current_config{NULL};
+static std::atomic<uint64_t> global_epoch{1};
+static reader_slot_t readers[CONFIG_MAX_READERS];
+static std::mutex writer_lock;
+static char config_path[256];
+static bool is_initialized = false;
+
+// Snapshots come from a small pool: at most the current snapshot, one being
+// built and one awaiting reclamation are alive at once
+POOL_DEFINE(config_pool, hub_config_t, 4)
+
+static const hub_config_t DEFAULT_CONFIG = {
+    1.53f,   // fall_threshold_g (~15 m/s^2)
+    9.81f,   // normal_gravity
+    2.0f,    // recovery_margin
+    5000,    // suspect_timeout_ms
+    30,      // alert_timeout_s
+    10,      // sampling_rate_hz
+    40,      // heartrate_min
+    150,     // heartrate_max
+    0        // version
+};
+
+// Copy a snapshot into a new pool block
+static hub_config_t *snapshot_copy(const hub_config_t *src)
+{
+    hub_config_t *cfg = (hub_config_t *)pool_alloc(&config_pool);
+    if (cfg != NULL) {
+        *cfg = *src;
+    }
+    return cfg;
+}
+
+// Find "key": <number> anywhere in the document (keys are unique in config.json)
+static bool json_find_number(const char *text, const char *key, double *out)
+{
+    char pattern[64];
+    snprintf(pattern, sizeof(pattern), "\"%s\"", key);
+
+    const char *p = strstr(text, pattern);
+    if (p == NULL) {
+        return false;
+    }
+    p += strlen(pattern);
+    while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') p++;
+    if (*p != ':') {
+        return false;
+    }
+    p++;
+
+    char *end;
+    double value = strtod(p, &end);
+    if (end == p) {
+        return false;
+    }
+    *out = value;
+    return true;
+}
+
+// Negative, non-finite or oversized numbers become UINT32_MAX so validation rejects them
+static uint32_t to_u32(double value)
+{
+    return (value >= 0.0 && value < 4294967295.0) ? (uint32_t)value : UINT32_MAX;
+}
+
+static bool in_range_f(float value, float lo, float hi)
+{
+    return isfinite(value) && value >= lo && value <= hi;
+}
+
+// Check every field before a snapshot is published
+static bool validate(const hub_config_t *cfg)
+{
+    const char *bad = NULL;
+    if (!in_range_f(cfg->fall_threshold_g, CONFIG_THRESHOLD_MIN_G, CONFIG_THRESHOLD_MAX_G)) {
+        bad = "fall threshold";
+    } else if (!in_range_f(cfg->normal_gravity, CONFIG_GRAVITY_MIN, CONFIG_GRAVITY_MAX)) {
+        bad = "normal gravity";
+    } else if (!in_range_f(cfg->recovery_margin, 0.0f, CONFIG_RECOVERY_MARGIN_MAX) || cfg->recovery_margin == 0.0f) {
+        bad = "recovery margin";
+    } else if (cfg->suspect_timeout_ms < CONFIG_SUSPECT_TIMEOUT_MIN_MS ||
+               cfg->suspect_timeout_ms > CONFIG_SUSPECT_TIMEOUT_MAX_MS) {
+        bad = "suspect timeout";
+    } else if (cfg->alert_timeout_s < CONFIG_ALERT_TIMEOUT_MIN_S || cfg->alert_timeout_s > CONFIG_ALERT_TIMEOUT_MAX_S) {
+        bad = "alert timeout";
+    } else if (cfg->sampling_rate_hz < CONFIG_SAMPLING_RATE_MIN_HZ ||
+               cfg->sampling_rate_hz > CONFIG_SAMPLING_RATE_MAX_HZ) {
+        bad = "sampling rate";
+    } else if (cfg->heartrate_min < CONFIG_HEARTRATE_MIN_BPM || cfg->heartrate_max > CONFIG_HEARTRATE_MAX_BPM ||
+               cfg->heartrate_min >= cfg->heartrate_max) {
+        bad = "heart rate limits";
+    }
+
+    if (bad != NULL) {
+        printf("Config - Rejected: %s out of range\n", bad);
+        return false;
+    }
+    return true;
+}
+
+static bool load_file(const char *path, hub_config_t *cfg)
+{
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        printf("Config - Cannot open %s\n", path);
+        return false;
+    }
+
+    static char text[CONFIG_MAX_FILE_SIZE];
+    size_t len = fread(text, 1, sizeof(text) - 1, file);
+    fclose(file);
+    text[len] = '\0';
+
+    double value;
+    if (json_find_number(text, "fall_acceleration", &value)) cfg->fall_threshold_g = (float)value;
+    if (json_find_number(text, "normal_gravity", &value)) cfg->normal_gravity = (float)value;
+    if (json_find_number(text, "recovery_margin", &value)) cfg->recovery_margin = (float)value;
+    if (json_find_number(text, "suspect_timeout_ms", &value)) cfg->suspect_timeout_ms = to_u32(value);
+    if (json_find_number(text, "countdown", &value)) cfg->alert_timeout_s = to_u32(value);
+    if (json_find_number(text, "sampling_rate", &value)) cfg->sampling_rate_hz = to_u32(value);
+    if (json_find_number(text, "heartrate_min", &value)) cfg->heartrate_min = to_u32(value);
+    if (json_find_number(text, "heartrate_max", &value)) cfg->heartrate_max = to_u32(value);
+    return validate(cfg);
+}
+
+// Wait until every online reader has passed a quiescent point after 'epoch'
+static void synchronize(uint64_t epoch)
+{
+    for (int i = 0; i < CONFIG_MAX_READERS; i++) {
+        while (readers[i].in_use.load() && readers[i].online.load() &&
+               readers[i].seen_epoch.load() < epoch) {
+            struct timespec pause = {0, 1000000};  // 1 ms
+            nanosleep(&pause, NULL);
+        }
+    }
+}
+
+// Swap in a new snapshot and reclaim the old one (caller holds writer_lock)
+static void publish(hub_config_t *next)
+{
+    const hub_config_t *prev = current_config.load();
+    next->version = (prev != NULL) ? prev->version + 1 : 1;
+
+    current_config.store(next);
+    uint64_t epoch = global_epoch.fetch_add(1) + 1;
+
+    if (prev != NULL) {
+        synchronize(epoch);
+        pool_free(&config_pool, (void *)prev);
+    }
+}
+
+bool config_init(const char *path)
+{
+    printf("Config - Initializing\n");
+
+    if (is_initialized) {
+        printf("Config - Already initialized\n");
+        return false;
+    }
+
+    snprintf(config_path, sizeof(config_path), "%s", path);
+    pool_init_config_pool();
+
+    hub_config_t *cfg = snapshot_copy(&DEFAULT_CONFIG);
+    if (!load_file(config_path, cfg)) {
+        printf("Config - Using built-in defaults\n");
+        *cfg = DEFAULT_CONFIG;
+    }
+
+    std::lock_guard<std::mutex> guard(writer_lock);
+    publish(cfg);
+    is_initialized = true;
+    return true;
+}
+
+const hub_config_t *config_acquire(void)
+{
+    return current_config.load(std::memory_order_acquire);
+}
+
+int config_reader_register(void)
+{
+    for (int i = 0; i < CONFIG_MAX_READERS; i++) {
+        bool expected = false;
+        if (readers[i].in_use.compare_exchange_strong(expected, true)) {
+            readers[i].seen_epoch.store(global_epoch.load());
+            readers[i].online.store(true);
+            return i;
+        }
+    }
+    printf("Config - No free reader slots\n");
+    return -1;
+}
+
+void config_quiescent(int reader)
+{
+    readers[reader].seen_epoch.store(global_epoch.load(std::memory_order_relaxed),
+                                     std::memory_order_release);
+}
+
+void config_reader_offline(int reader)
+{
+    readers[reader].online.store(false);
+}
+
+void config_reader_online(int reader)
+{
+    readers[reader].online.store(true);
+    readers[reader].seen_epoch.store(global_epoch.load());
+}
+
+void config_reader_unregister(int reader)
+{
+    readers[reader].online.store(false);
+    readers[reader].in_use.store(false);
+}
+
+bool config_reload(void)
+{
+    if (!is_initialized) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> guard(writer_lock);
+    hub_config_t *cfg = snapshot_copy(current_config.load());
+    if (cfg == NULL) {
+        return false;
+    }
+    if (!load_file(config_path, cfg)) {
+        pool_free(&config_pool, cfg);
+        return false;
+    }
+
+    publish(cfg);
+    printf("Config - Reloaded %s (version %u)\n", config_path, (unsigned)cfg->version);
+    return true;
+}
+
+bool config_apply(const config_t *update)
+{
+    if (!is_initialized || update == NULL) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> guard(writer_lock);
+    hub_config_t *cfg = snapshot_copy(current_config.load());
+    if (cfg == NULL) {
+        return false;
+    }
+
+    bool applied = true;
+    switch (update->config_id) {
+    case CFG_FALL_THRESHOLD:
+        if (update->length == sizeof(float)) {
+            memcpy(&cfg->fall_threshold_g, update->value, sizeof(float));
+        } else {
+            applied = false;
+        }
+        break;
+    case CFG_ALERT_TIMEOUT:
+        if (update->length == sizeof(uint32_t)) {
+            memcpy(&cfg->alert_timeout_s, update->value, sizeof(uint32_t));
+        } else {
+            applied = false;
+        }
+        break;
+    case CFG_SAMPLING_RATE:
+        if (update->length == sizeof(uint32_t)) {
+            memcpy(&cfg->sampling_rate_hz, update->value, sizeof(uint32_t));
+        } else {
+            applied = false;
+        }
+        break;
+    default:
+        // CFG_DISPLAY_BRIGHTNESS, CFG_IMU_PROFILE, CFG_SEND_INTERVAL and unknown ids are wearable-side only
+        applied = false;
+        break;
+    }
+
+    if (!applied || !validate(cfg)) {
+        pool_free(&config_pool, cfg);
+        return false;
+    }
+
+    publish(cfg);
+    printf("Config - Applied id 0x%02X (version %u)\n", update->config_id, (unsigned)cfg->version);
+    return true;
+}
+
+void config_cleanup(void)
+{
+    printf("Config - Cleanup\n");
+    if (is_initialized) {
+        std::lock_guard<std::mutex> guard(writer_lock);
+        pool_free(&config_pool, (void *)current_config.exchange(NULL));
+    }
+    is_initialized = false;
+}
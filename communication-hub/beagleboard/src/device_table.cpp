@@ -0,0 +1,51 @@
+// Device Table - Per-wearable state keyed by MAC address
+#include "device_table.h"
+#include <stdio.h>
+#include <string.h>
+
+static device_t devices[DEVICE_TABLE_SIZE];
+
+device_t *device_table_lookup(const uint8_t mac[6])
+{
+    device_t *free_slot = NULL;
+
+    for (int i = 0; i < DEVICE_TABLE_SIZE; i++) {
+        if (devices[i].in_use) {
+            if (memcmp(devices[i].mac, mac, 6) == 0) {
+                return &devices[i];
+            }
+        } else if (free_slot == NULL) {
+            free_slot = &devices[i];
+        }
+    }
+
+    if (free_slot == NULL) {
+        printf("DeviceTable - Table full, dropping %02X:%02X:%02X:%02X:%02X:%02X\n",
+               mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+        return NULL;
+    }
+
+    memset(free_slot, 0, sizeof(*free_slot));
+    free_slot->in_use = true;
+    memcpy(free_slot->mac, mac, 6);
+    fall_detector_init(&free_slot->fall);
+    orientation_init(&free_slot->orientation);
+    fall_event_init(&free_slot->event);
+    hr_analyzer_init(&free_slot->hr);
+    calibration_lookup(mac, &free_slot->calibration);
+    free_slot->history = history_create();
+
+    printf("DeviceTable - New device %02X:%02X:%02X:%02X:%02X:%02X%s%s\n",
+           mac[0], mac[1], mac[2], mac[3], mac[4], mac[5],
+           free_slot->calibration.calibrated ? " (calibrated)" : "",
+           free_slot->history == NULL ? " (no history: pool full)" : "");
+    return free_slot;
+}
+
+device_t *device_table_at(int index)
+{
+    if (index < 0 || index >= DEVICE_TABLE_SIZE || !devices[index].in_use) {
+        return NULL;
+    }
+    return &devices[index];
+}
@@ -0,0 +1,384 @@
+// Event Log - Crash-safe write-ahead log for alert events
+#include "event_log.h"
+#include <condition_variable>
+#include <fcntl.h>
+#include <mutex>
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+#include <unistd.h>
+
+#define RECORD_MAGIC        0x574C4746u     // "FGLW"
+#define CHECKPOINT_MAGIC    0x504B4746u     // "FGKP"
+
+// Records buffered between flushes (appenders block when full)
+#define PENDING_CAPACITY    1024
+
+// On-disk record (fixed size, CRC over everything after the crc field)
+typedef struct {
+    uint32_t crc;
+    uint32_t magic;
+    uint64_t lsn;
+    event_t event;
+} record_t;
+
+static_assert(sizeof(record_t) == 40, "record_t layout must stay fixed on disk");
+
+// On-disk checkpoint header (followed by 'count' alert_state_t entries and a CRC)
+typedef struct {
+    uint32_t magic;
+    uint32_t count;
+    uint64_t lsn;               // All records <= lsn are reflected
+} checkpoint_header_t;
+
+static std::mutex log_lock;
+static std::condition_variable work_cv;     // Flusher waits for records
+static std::condition_variable durable_cv;  // Appenders wait for durability
+static std::thread flusher;
+
+static record_t pending[2][PENDING_CAPACITY];
+static int pending_buf = 0;                 // Buffer appenders write into
+static int pending_count = 0;
+
+static uint64_t next_lsn = 1;
+static uint64_t durable_lsn = 0;
+static bool running = false;
+static bool failed = false;
+
+// Alert state as of durable_lsn (only the flusher and recovery modify it)
+static alert_state_t states[EVENT_LOG_MAX_DEVICES];
+static int state_count = 0;
+static uint32_t since_checkpoint = 0;
+
+static int log_fd = -1;
+static char log_path[256];
+static char checkpoint_path[256];
+static char checkpoint_tmp_path[256];
+static char dir_path[256];
+static bool is_initialized = false;
+
+static uint32_t crc_table[256];
+
+static void crc32_init(void)
+{
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; k++) {
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        }
+        crc_table[i] = c;
+    }
+}
+
+static uint32_t crc32(const void *data, size_t len)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    uint32_t c = 0xFFFFFFFFu;
+    for (size_t i = 0; i < len; i++) {
+        c = crc_table[(c ^ p[i]) & 0xFF] ^ (c >> 8);
+    }
+    return c ^ 0xFFFFFFFFu;
+}
+
+static uint32_t record_crc(const record_t *rec)
+{
+    return crc32((const uint8_t *)rec + sizeof(rec->crc), sizeof(*rec) - sizeof(rec->crc));
+}
+
+static bool write_all(int fd, const void *data, size_t len)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    while (len > 0) {
+        ssize_t n = write(fd, p, len);
+        if (n <= 0) {
+            return false;
+        }
+        p += n;
+        len -= (size_t)n;
+    }
+    return true;
+}
+
+// Apply one event to the alert state table
+static void apply_event(const event_t *event)
+{
+    alert_state_t *entry = NULL;
+    for (int i = 0; i < state_count; i++) {
+        if (memcmp(states[i].mac, event->mac, 6) == 0) {
+            entry = &states[i];
+            break;
+        }
+    }
+    if (entry == NULL) {
+        if (state_count == EVENT_LOG_MAX_DEVICES) {
+            return;
+        }
+        entry = &states[state_count++];
+        memset(entry, 0, sizeof(*entry));
+        memcpy(entry->mac, event->mac, 6);
+    }
+
+    entry->state = event->state;
+    entry->last_event_ms = event->time_ms;
+    switch (event->type) {
+    case EVENT_FALL_DETECTED:
+        entry->severity = event->severity;
+        entry->last_fall_ms = event->time_ms;
+        break;
+    case EVENT_USER_RESPONSE:
+        entry->last_response = event->response;
+        break;
+    default:
+        break;
+    }
+}
+
+// ===== Checkpoints =====
+
+static bool write_checkpoint(uint64_t lsn, const alert_state_t *snapshot, int count)
+{
+    int fd = open(checkpoint_tmp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+
+    checkpoint_header_t header = {CHECKPOINT_MAGIC, (uint32_t)count, lsn};
+    uint32_t crc = crc32(&header, sizeof(header)) ^ crc32(snapshot, count * sizeof(alert_state_t));
+
+    bool ok = write_all(fd, &header, sizeof(header)) &&
+              write_all(fd, snapshot, count * sizeof(alert_state_t)) &&
+              write_all(fd, &crc, sizeof(crc)) &&
+              fsync(fd) == 0;
+    close(fd);
+    if (!ok || rename(checkpoint_tmp_path, checkpoint_path) != 0) {
+        return false;
+    }
+
+    // Make the rename durable before dropping the records it replaces
+    int dir_fd = open(dir_path, O_RDONLY);
+    if (dir_fd >= 0) {
+        fsync(dir_fd);
+        close(dir_fd);
+    }
+    return true;
+}
+
+static bool load_checkpoint(uint64_t *lsn)
+{
+    *lsn = 0;
+    FILE *file = fopen(checkpoint_path, "rb");
+    if (file == NULL) {
+        return false;
+    }
+
+    checkpoint_header_t header;
+    uint32_t crc;
+    bool ok = fread(&header, sizeof(header), 1, file) == 1 &&
+              header.magic == CHECKPOINT_MAGIC &&
+              header.count <= EVENT_LOG_MAX_DEVICES &&
+              fread(states, sizeof(alert_state_t), header.count, file) == header.count &&
+              fread(&crc, sizeof(crc), 1, file) == 1 &&
+              crc == (crc32(&header, sizeof(header)) ^
+                      crc32(states, header.count * sizeof(alert_state_t)));
+    fclose(file);
+
+    if (!ok) {
+        printf("EventLog - Ignoring corrupt checkpoint\n");
+        state_count = 0;
+        return false;
+    }
+    state_count = (int)header.count;
+    *lsn = header.lsn;
+    return true;
+}
+
+// ===== Recovery =====
+
+static bool recover(void)
+{
+    uint64_t checkpoint_lsn;
+    load_checkpoint(&checkpoint_lsn);
+    durable_lsn = checkpoint_lsn;
+
+    record_t rec;
+    off_t valid_end = 0;
+    uint32_t replayed = 0;
+    while (read(log_fd, &rec, sizeof(rec)) == (ssize_t)sizeof(rec)) {
+        if (rec.magic != RECORD_MAGIC || rec.crc != record_crc(&rec)) {
+            break;  // Torn or corrupt tail
+        }
+        valid_end += sizeof(rec);
+        if (rec.lsn > durable_lsn) {
+            apply_event(&rec.event);
+            durable_lsn = rec.lsn;
+            replayed++;
+        }
+    }
+
+    // Drop any torn tail so new records follow the last valid one
+    if (ftruncate(log_fd, valid_end) != 0) {
+        return false;
+    }
+
+    next_lsn = durable_lsn + 1;
+    since_checkpoint = replayed;
+    printf("EventLog - Recovered %d devices (checkpoint lsn %llu, replayed %u records)\n",
+           state_count, (unsigned long long)checkpoint_lsn, replayed);
+    return true;
+}
+
+// ===== Group Commit =====
+
+static void flusher_main(void)
+{
+    std::unique_lock<std::mutex> guard(log_lock);
+
+    while (true) {
+        work_cv.wait(guard, [] { return pending_count > 0 || !running; });
+        if (pending_count == 0 && !running) {
+            break;
+        }
+
+        // Let a batch accumulate briefly unless the buffer is filling up
+        work_cv.wait_for(guard, std::chrono::milliseconds(EVENT_LOG_FLUSH_DELAY_MS),
+                         [] { return pending_count >= PENDING_CAPACITY / 2 || !running; });
+
+        record_t *batch = pending[pending_buf];
+        int count = pending_count;
+        pending_buf ^= 1;
+        pending_count = 0;
+        durable_cv.notify_all();   // Space is available again
+        guard.unlock();
+
+        bool ok = write_all(log_fd, batch, count * sizeof(record_t)) && fdatasync(log_fd) == 0;
+
+        guard.lock();
+        if (!ok) {
+            printf("EventLog - Write failed, log is now read-only\n");
+            failed = true;
+            durable_cv.notify_all();
+            continue;
+        }
+
+        for (int i = 0; i < count; i++) {
+            apply_event(&batch[i].event);
+        }
+        durable_lsn = batch[count - 1].lsn;
+        since_checkpoint += count;
+        durable_cv.notify_all();
+
+        if (since_checkpoint >= EVENT_LOG_CHECKPOINT_INTERVAL) {
+            alert_state_t snapshot[EVENT_LOG_MAX_DEVICES];
+            int snapshot_count = state_count;
+            uint64_t snapshot_lsn = durable_lsn;
+            memcpy(snapshot, states, snapshot_count * sizeof(alert_state_t));
+            guard.unlock();
+
+            // Only the flusher writes the log, so truncating here is safe
+            if (write_checkpoint(snapshot_lsn, snapshot, snapshot_count) &&
+                ftruncate(log_fd, 0) == 0) {
+                since_checkpoint = 0;
+            }
+            guard.lock();
+        }
+    }
+}
+
+// ===== Public API =====
+
+bool event_log_init(const char *dir)
+{
+    printf("EventLog - Initializing\n");
+
+    if (is_initialized) {
+        printf("EventLog - Already initialized\n");
+        return false;
+    }
+
+    crc32_init();
+    snprintf(dir_path, sizeof(dir_path), "%s", dir);
+    snprintf(log_path, sizeof(log_path), "%s/wal.log", dir);
+    snprintf(checkpoint_path, sizeof(checkpoint_path), "%s/checkpoint.bin", dir);
+    snprintf(checkpoint_tmp_path, sizeof(checkpoint_tmp_path), "%s/checkpoint.tmp", dir);
+
+    log_fd = open(log_path, O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (log_fd < 0) {
+        printf("EventLog - Cannot open %s\n", log_path);
+        return false;
+    }
+
+    if (!recover()) {
+        printf("EventLog - Recovery failed\n");
+        close(log_fd);
+        log_fd = -1;
+        return false;
+    }
+
+    running = true;
+    failed = false;
+    flusher = std::thread(flusher_main);
+    is_initialized = true;
+    return true;
+}
+
+uint64_t event_log_append(const event_t *event)
+{
+    if (!is_initialized || event == NULL) {
+        return 0;
+    }
+
+    std::unique_lock<std::mutex> guard(log_lock);
+    durable_cv.wait(guard, [] { return pending_count < PENDING_CAPACITY || failed; });
+    if (failed) {
+        return 0;
+    }
+
+    record_t *rec = &pending[pending_buf][pending_count++];
+    memset(rec, 0, sizeof(*rec));
+    rec->magic = RECORD_MAGIC;
+    rec->lsn = next_lsn++;
+    rec->event = *event;
+    rec->crc = record_crc(rec);
+
+    work_cv.notify_one();
+    return rec->lsn;
+}
+
+bool event_log_wait(uint64_t lsn)
+{
+    if (!is_initialized || lsn == 0) {
+        return false;
+    }
+
+    std::unique_lock<std::mutex> guard(log_lock);
+    durable_cv.wait(guard, [lsn] { return durable_lsn >= lsn || failed || !running; });
+    return durable_lsn >= lsn;
+}
+
+int event_log_alert_states(alert_state_t *out, int max)
+{
+    std::lock_guard<std::mutex> guard(log_lock);
+    int count = (state_count < max) ? state_count : max;
+    memcpy(out, states, count * sizeof(alert_state_t));
+    return count;
+}
+
+void event_log_cleanup(void)
+{
+    printf("EventLog - Cleanup\n");
+    if (!is_initialized) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(log_lock);
+        running = false;
+    }
+    work_cv.notify_all();
+    flusher.join();
+    durable_cv.notify_all();
+
+    close(log_fd);
+    log_fd = -1;
+    is_initialized = false;
+}
@@ -0,0 +1,253 @@
+// Fall Classifier - Confirms candidate fall events with a tree ensemble
+#include "fall_classifier.h"
+#include "fall_model.h"
+#include <string.h>
+
+#define GRAVITY 9.80665f
+
+static_assert((FALL_EVENT_HISTORY & (FALL_EVENT_HISTORY - 1)) == 0, "history must be a power of two");
+static_assert(FALL_MODEL_FEATURES == FALL_FEATURE_COUNT, "fall_model.h was generated for other features");
+static_assert(FALL_MODEL_DEPTH <= 8, "leaf index must fit in a byte");
+
+// Burst replay clock value at the impact sample (ms)
+#define REPLAY_IMPACT_MS 60000
+
+// Lanes per inner batch loop (one 128-bit vector of int8 features)
+#define BATCH_BLOCK 16
+static_assert(FALL_CLASSIFIER_BATCH_MAX % BATCH_BLOCK == 0, "batch must be whole blocks");
+
+static const char *FEATURE_NAMES[FALL_FEATURE_COUNT] = {
+    "peak_g", "pre_min_g", "jerk_gps", "tilt_before", "tilt_after", "tilt_change", "still_g", "duration_s"
+};
+
+// ===== Event Tracking =====
+
+void fall_event_init(fall_event_t *ev)
+{
+    memset(ev, 0, sizeof(*ev));
+    feature_jerk_init(&ev->jerk);
+    feature_still_init(&ev->still);
+}
+
+// Lowest |a| (g) and the oldest tilt in the look-back before 'now_ms'
+static void look_back(const fall_event_t *ev, uint32_t now_ms, float mag, float tilt,
+                      float *min_g, float *tilt_before)
+{
+    float lowest = mag;
+    *tilt_before = tilt;
+    for (uint32_t i = 0; i < ev->count; i++) {
+        uint32_t slot = (ev->head - 1 - i) & (FALL_EVENT_HISTORY - 1);
+        if (now_ms - ev->time_ms[slot] > FALL_EVENT_PRE_MS) {
+            break;
+        }
+        lowest = (ev->magnitude[slot] < lowest) ? ev->magnitude[slot] : lowest;
+        *tilt_before = ev->tilt_deg[slot];
+    }
+    *min_g = lowest / GRAVITY;
+}
+
+// Summarize the event as of the newest sample and close it
+static void close_event(fall_event_t *ev, float tilt, float variance)
+{
+    float *f = ev->features;
+    f[FALL_FEATURE_TILT_AFTER] = tilt;
+    f[FALL_FEATURE_TILT_CHANGE] = fabsf(tilt - f[FALL_FEATURE_TILT_BEFORE]);
+    f[FALL_FEATURE_STILL_G] = sqrtf(variance) / GRAVITY;
+    f[FALL_FEATURE_DURATION_S] = (ev->end_ms - ev->start_ms) * 0.001f;
+    ev->open = false;
+}
+
+bool fall_event_update(fall_event_t *ev, const sensor_data_t *data,
+                       const fall_detector_t *det, const orientation_t *orient)
+{
+    float mag = feature_magnitude(data->accel_x, data->accel_y, data->accel_z);
+    float tilt = orientation_tilt_deg(orient);
+    uint32_t now = data->timestamp;
+    float *f = ev->features;
+    float jerk = feature_jerk_push(&ev->jerk, data->accel_x, data->accel_y, data->accel_z);
+    float variance = feature_still_push(&ev->still, data->accel_x, data->accel_y, data->accel_z);
+
+    if (!ev->open && det->posture_pending) {
+        // First sample above the threshold
+        ev->open = true;
+        ev->start_ms = now;
+        memset(f, 0, sizeof(ev->features));
+        look_back(ev, now, mag, tilt, &f[FALL_FEATURE_PRE_MIN_G], &f[FALL_FEATURE_TILT_BEFORE]);
+    }
+
+    if (ev->open) {
+        float g = mag / GRAVITY;
+        f[FALL_FEATURE_PEAK_G] = (g > f[FALL_FEATURE_PEAK_G]) ? g : f[FALL_FEATURE_PEAK_G];
+        if (ev->count > 0) {
+            // Per-sample jerk to g/s at this sample's spacing
+            uint32_t last = (ev->head - 1) & (FALL_EVENT_HISTORY - 1);
+            uint32_t dt_ms = now - ev->time_ms[last];
+            if (dt_ms > 0) {
+                float gps = jerk / GRAVITY * 1000.0f / dt_ms;
+                f[FALL_FEATURE_JERK_GPS] = (gps > f[FALL_FEATURE_JERK_GPS]) ? gps : f[FALL_FEATURE_JERK_GPS];
+            }
+        }
+        ev->end_ms = det->impact_ms;
+    }
+
+    ev->magnitude[ev->head] = mag;
+    ev->tilt_deg[ev->head] = tilt;
+    ev->time_ms[ev->head] = now;
+    ev->head = (ev->head + 1) & (FALL_EVENT_HISTORY - 1);
+    if (ev->count < FALL_EVENT_HISTORY) {
+        ev->count++;
+    }
+
+    if (!ev->open || det->posture_pending) {
+        return false;
+    }
+    close_event(ev, tilt, variance);
+    return true;
+}
+
+bool fall_event_close(fall_event_t *ev)
+{
+    if (!ev->open || ev->count == 0) {
+        return false;
+    }
+    uint32_t newest = (ev->head - 1) & (FALL_EVENT_HISTORY - 1);
+    close_event(ev, ev->tilt_deg[newest], ev->still.m2 * (1.0f / FALL_EVENT_STILL_SAMPLES));
+    return true;
+}
+
+// ===== Burst Replay =====
+
+void fall_replay_init(fall_replay_t *replay)
+{
+    fall_detector_init(&replay->fall);
+    orientation_init(&replay->orientation);
+    fall_event_init(&replay->event);
+    replay->done = false;
+}
+
+bool fall_replay_update(fall_replay_t *replay, int index, uint16_t rate_hz,
+                        const float accel[3], const float gyro[3], const hub_config_t *cfg)
+{
+    if (replay->done || rate_hz == 0) {
+        return false;
+    }
+
+    // Replay clock: the impact is at REPLAY_IMPACT_MS, so the window never wraps
+    sensor_data_t data;
+    memset(&data, 0, sizeof(data));
+    data.timestamp = (uint32_t)(REPLAY_IMPACT_MS + (int64_t)index * 1000 / rate_hz);
+    data.accel_x = accel[0];
+    data.accel_y = accel[1];
+    data.accel_z = accel[2];
+    data.gyro_x = gyro[0];
+    data.gyro_y = gyro[1];
+    data.gyro_z = gyro[2];
+
+    orientation_update(&replay->orientation, &data);
+    fall_detector_process(&replay->fall, &data, &replay->orientation, cfg);
+    replay->done = fall_event_update(&replay->event, &data, &replay->fall, &replay->orientation);
+    return replay->done;
+}
+
+bool fall_replay_finish(fall_replay_t *replay)
+{
+    if (replay->done) {
+        return false;
+    }
+    replay->done = fall_event_close(&replay->event);
+    return replay->done;
+}
+
+const char *fall_feature_name(int feature)
+{
+    return (feature >= 0 && feature < FALL_FEATURE_COUNT) ? FEATURE_NAMES[feature] : "unknown";
+}
+
+// ===== Inference =====
+
+void fall_classifier_quantize(const float features[FALL_FEATURE_COUNT], int8_t out[FALL_FEATURE_COUNT])
+{
+    for (int i = 0; i < FALL_FEATURE_COUNT; i++) {
+        out[i] = fall_classifier_quantize_value(features[i], FALL_MODEL_OFFSET[i], FALL_MODEL_SCALE[i]);
+    }
+}
+
+int32_t fall_classifier_score(const int8_t features[FALL_FEATURE_COUNT])
+{
+    int32_t score = FALL_MODEL_BIAS;
+    for (int t = 0; t < FALL_MODEL_TREES; t++) {
+        int leaf = 0;
+        for (int d = 0; d < FALL_MODEL_DEPTH; d++) {
+            leaf |= (features[FALL_MODEL_SPLIT_FEATURE[t][d]] > FALL_MODEL_SPLIT_THRESHOLD[t][d]) << d;
+        }
+        score += FALL_MODEL_LEAF[t][leaf];
+    }
+    return score;
+}
+
+bool fall_classifier_is_fall(int32_t score)
+{
+    return score > 0;
+}
+
+float fall_classifier_probability(int32_t score)
+{
+    return 1.0f / (1.0f + expf(-(float)score / FALL_MODEL_LEAF_SCALE));
+}
+
+void fall_classifier_batch_init(fall_batch_t *batch)
+{
+    // Lanes past count are scored with the rest of their block
+    memset(batch->features, 0, sizeof(batch->features));
+    batch->count = 0;
+}
+
+int fall_classifier_batch_add(fall_batch_t *batch, const float features[FALL_FEATURE_COUNT])
+{
+    if (batch->count >= FALL_CLASSIFIER_BATCH_MAX) {
+        return -1;
+    }
+    int lane = batch->count++;
+    for (int i = 0; i < FALL_FEATURE_COUNT; i++) {
+        batch->features[i][lane] = fall_classifier_quantize_value(features[i], FALL_MODEL_OFFSET[i],
+                                                                  FALL_MODEL_SCALE[i]);
+    }
+    return lane;
+}
+
+void fall_classifier_batch_score(const fall_batch_t *batch, int32_t *scores)
+{
+    int lanes = (batch->count + BATCH_BLOCK - 1) / BATCH_BLOCK * BATCH_BLOCK;
+    int32_t total[FALL_CLASSIFIER_BATCH_MAX];
+    for (int i = 0; i < lanes; i++) {
+        total[i] = FALL_MODEL_BIAS;
+    }
+
+    // Tree-major: one tree's splits and leaves for every lane, a block at a
+    // time. The fixed-length compare loops become int8 vector compares; the
+    // leaf lookup stays scalar.
+    for (int t = 0; t < FALL_MODEL_TREES; t++) {
+        const int8_t *leaves = FALL_MODEL_LEAF[t];
+        for (int b = 0; b < lanes; b += BATCH_BLOCK) {
+            uint8_t leaf[BATCH_BLOCK];
+            for (int j = 0; j < BATCH_BLOCK; j++) {
+                leaf[j] = 0;
+            }
+            for (int d = 0; d < FALL_MODEL_DEPTH; d++) {
+                const int8_t *row = &batch->features[FALL_MODEL_SPLIT_FEATURE[t][d]][b];
+                int8_t threshold = FALL_MODEL_SPLIT_THRESHOLD[t][d];
+                uint8_t bit = (uint8_t)(1u << d);
+                for (int j = 0; j < BATCH_BLOCK; j++) {
+                    leaf[j] |= (row[j] > threshold) ? bit : 0;
+                }
+            }
+            for (int j = 0; j < BATCH_BLOCK; j++) {
+                total[b + j] += leaves[leaf[j]];
+            }
+        }
+    }
+
+    for (int i = 0; i < batch->count; i++) {
+        scores[i] = total[i];
+    }
+}
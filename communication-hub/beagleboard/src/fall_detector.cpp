@@ -0,0 +1,61 @@
+// Fall Detector - Per-device threshold detection
+#include "fall_detector.h"
+#include <math.h>
+#include <stdio.h>
+
+void fall_detector_init(fall_detector_t *det)
+{
+    det->state = STATE_MONITORING;
+    det->magnitude = 0.0f;
+    det->last_change_ms = 0;
+    det->tilt_deg = 0.0f;
+    det->posture = POSTURE_UNKNOWN;
+    det->posture_pending = false;
+    det->impact_ms = 0;
+}
+
+bool fall_detector_process(fall_detector_t *det, const sensor_data_t *data,
+                           const orientation_t *orient, const hub_config_t *cfg)
+{
+    float accel_mag = sqrtf(data->accel_x * data->accel_x +
+                            data->accel_y * data->accel_y +
+                            data->accel_z * data->accel_z);
+    det->magnitude = accel_mag;
+
+    uint8_t prev_state = det->state;
+    float threshold = cfg->fall_threshold_g * cfg->normal_gravity;
+
+    if (accel_mag > threshold) {
+        // Sudden acceleration detected
+        det->impact_ms = data->timestamp;
+        det->posture_pending = (orient != NULL);
+        if (det->state == STATE_MONITORING) {
+            det->state = STATE_FALL_SUSPECTED;
+        }
+    } else if (accel_mag < (cfg->normal_gravity + cfg->recovery_margin) &&
+               det->state == STATE_FALL_SUSPECTED) {
+        // Acceleration returned to normal
+        det->state = STATE_MONITORING;
+    }
+
+    // Auto-reset a suspected fall after the configured timeout
+    if (det->state == STATE_FALL_SUSPECTED && prev_state == STATE_FALL_SUSPECTED &&
+        data->timestamp - det->last_change_ms > cfg->suspect_timeout_ms) {
+        det->state = STATE_MONITORING;
+    }
+
+    // Orientation once the body has come to rest after the impact
+    if (orient != NULL) {
+        det->tilt_deg = orientation_tilt_deg(orient);
+        if (det->posture_pending && data->timestamp - det->impact_ms >= FALL_POSTURE_SETTLE_MS) {
+            det->posture = orientation_posture(orient);
+            det->posture_pending = false;
+        }
+    }
+
+    if (det->state != prev_state) {
+        det->last_change_ms = data->timestamp;
+        return true;
+    }
+    return false;
+}
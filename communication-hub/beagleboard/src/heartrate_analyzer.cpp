@@ -0,0 +1,102 @@
+// Heart Rate Analyzer - Streaming per-device vitals analysis
+#include "heartrate_analyzer.h"
+#include <math.h>
+#include <string.h>
+
+#define HR_WINDOW_MASK (HR_WINDOW_SIZE - 1)
+
+// Baseline EWMA weight (~1/64 per reading, tracks resting rate slowly)
+#define HR_BASELINE_ALPHA 0.015625f
+
+static_assert((HR_WINDOW_SIZE & HR_WINDOW_MASK) == 0, "HR_WINDOW_SIZE must be a power of two");
+
+void hr_analyzer_init(hr_analyzer_t *hr)
+{
+    memset(hr, 0, sizeof(*hr));
+    hr->status = HR_STATUS_OK;
+}
+
+static int32_t diff_at(const hr_analyzer_t *hr, uint32_t newer, uint32_t older)
+{
+    return (int32_t)hr->bpm[newer & HR_WINDOW_MASK] - (int32_t)hr->bpm[older & HR_WINDOW_MASK];
+}
+
+uint8_t hr_analyzer_update(hr_analyzer_t *hr, const heartrate_t *reading,
+                           const hub_config_t *cfg)
+{
+    // Sensor-reported errors and implausible values are not added to the window
+    if (reading->status == HR_STATUS_ERROR || reading->bpm == 0 || reading->spo2 == 0) {
+        hr->status = HR_STATUS_ERROR;
+        return hr->status;
+    }
+
+    uint32_t slot = hr->head & HR_WINDOW_MASK;
+
+    if (hr->count == HR_WINDOW_SIZE) {
+        // Evict the oldest reading and its successive difference
+        uint32_t old = hr->bpm[slot];
+        hr->bpm_sum -= old;
+        hr->bpm_sq_sum -= (uint64_t)old * old;
+        hr->spo2_sum -= hr->spo2[slot];
+
+        int32_t d = diff_at(hr, hr->head + 1, hr->head);
+        hr->diff_sq_sum -= (uint64_t)(d * d);
+    } else {
+        hr->count++;
+    }
+
+    hr->bpm[slot] = reading->bpm;
+    hr->spo2[slot] = reading->spo2;
+    hr->bpm_sum += reading->bpm;
+    hr->bpm_sq_sum += (uint64_t)reading->bpm * reading->bpm;
+    hr->spo2_sum += reading->spo2;
+
+    if (hr->count > 1) {
+        int32_t d = diff_at(hr, hr->head, hr->head - 1);
+        hr->diff_sq_sum += (uint64_t)(d * d);
+    }
+    hr->head++;
+
+    if (hr->baseline_bpm == 0.0f) {
+        hr->baseline_bpm = reading->bpm;
+    } else {
+        hr->baseline_bpm += HR_BASELINE_ALPHA * ((float)reading->bpm - hr->baseline_bpm);
+    }
+
+    // Classify: limits first, then rhythm once the window has enough history
+    uint8_t status = HR_STATUS_OK;
+    if (reading->bpm < cfg->heartrate_min || reading->spo2 < HR_SPO2_MIN) {
+        status = HR_STATUS_LOW;
+    } else if (reading->bpm > cfg->heartrate_max) {
+        status = HR_STATUS_HIGH;
+    } else if (hr->count >= HR_MIN_READINGS) {
+        float rmssd = sqrtf((float)hr->diff_sq_sum / (float)(hr->count - 1));
+        if (rmssd > HR_IRREGULAR_RMSSD) {
+            status = HR_STATUS_IRREGULAR;
+        }
+    }
+
+    hr->status = status;
+    return status;
+}
+
+void hr_analyzer_stats(const hr_analyzer_t *hr, hr_stats_t *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+    stats->status = hr->status;
+    stats->baseline_bpm = hr->baseline_bpm;
+    if (hr->count == 0) {
+        return;
+    }
+
+    float n = (float)hr->count;
+    stats->mean_bpm = hr->bpm_sum / n;
+    stats->mean_spo2 = hr->spo2_sum / n;
+
+    float variance = (float)hr->bpm_sq_sum / n - stats->mean_bpm * stats->mean_bpm;
+    stats->stddev_bpm = (variance > 0.0f) ? sqrtf(variance) : 0.0f;
+
+    if (hr->count > 1) {
+        stats->rmssd_bpm = sqrtf((float)hr->diff_sq_sum / (float)(hr->count - 1));
+    }
+}
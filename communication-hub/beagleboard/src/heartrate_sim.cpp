@@ -0,0 +1,67 @@
+// Heart Rate Simulator - Synthetic PKT_HEARTRATE source for testing
+#include "heartrate_sim.h"
+#include <string.h>
+
+static uint32_t xorshift32(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+// Uniform integer noise in [-range, range]
+static int32_t noise(uint32_t *state, int32_t range)
+{
+    return (int32_t)(xorshift32(state) % (uint32_t)(2 * range + 1)) - range;
+}
+
+void hr_sim_init(hr_sim_t *sim, hr_sim_profile_t profile, uint32_t seed, uint32_t interval_ms)
+{
+    sim->profile = profile;
+    sim->seed = (seed != 0) ? seed : 0x9E3779B9u;
+    sim->timestamp = 0;
+    sim->interval_ms = interval_ms;
+    sim->count = 0;
+}
+
+void hr_sim_next(hr_sim_t *sim, heartrate_t *reading)
+{
+    int32_t bpm = 70;
+    int32_t spo2 = 98;
+
+    switch (sim->profile) {
+    case HR_SIM_NORMAL:
+        bpm = 70 + noise(&sim->seed, 3);
+        spo2 = 98 + noise(&sim->seed, 1);
+        break;
+    case HR_SIM_BRADYCARDIA:
+        bpm = 35 + noise(&sim->seed, 2);
+        spo2 = 96 + noise(&sim->seed, 1);
+        break;
+    case HR_SIM_TACHYCARDIA:
+        bpm = 165 + noise(&sim->seed, 5);
+        spo2 = 95 + noise(&sim->seed, 1);
+        break;
+    case HR_SIM_IRREGULAR:
+        bpm = 85 + noise(&sim->seed, 30);
+        spo2 = 96 + noise(&sim->seed, 1);
+        break;
+    case HR_SIM_HYPOXIA:
+        bpm = 80 + noise(&sim->seed, 3);
+        spo2 = 97 - (int32_t)(sim->count / 4);
+        if (spo2 < 75) spo2 = 75;
+        break;
+    }
+
+    memset(reading, 0, sizeof(*reading));
+    reading->bpm = (uint16_t)bpm;
+    reading->spo2 = (uint8_t)(spo2 > 100 ? 100 : spo2);
+    reading->status = HR_STATUS_OK;
+    reading->timestamp = sim->timestamp;
+
+    sim->timestamp += sim->interval_ms;
+    sim->count++;
+}
@@ -0,0 +1,234 @@
+// Sensor History - Multi-resolution min/max/mean pyramid
+#include "history.h"
+#include "common/pool.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BUCKET_EMPTY UINT64_MAX
+
+typedef struct {
+    uint64_t index;                     // start_ms / width, or BUCKET_EMPTY
+    uint32_t count;
+    float min[HISTORY_FIELD_COUNT];
+    float max[HISTORY_FIELD_COUNT];
+    float sum[HISTORY_FIELD_COUNT];
+} bucket_t;
+
+typedef struct {
+    uint32_t width_ms;
+    uint32_t capacity;
+    bucket_t *buckets;                  // Ring indexed by (index % capacity)
+} level_t;
+
+// Bucket width and retention per level: 1 h of 1 s, 6 h of 10 s,
+// 2 days of 1 min and 30 days of 10 min (~1.4 MB per device)
+static const uint32_t LEVEL_WIDTH_MS[HISTORY_LEVEL_COUNT] = {1000, 10000, 60000, 600000};
+static constexpr uint32_t LEVEL_CAPACITY[HISTORY_LEVEL_COUNT] = {3600, 2160, 2880, 4320};
+#define TOTAL_BUCKETS (3600 + 2160 + 2880 + 4320)
+static_assert(LEVEL_CAPACITY[0] + LEVEL_CAPACITY[1] + LEVEL_CAPACITY[2] + LEVEL_CAPACITY[3] == TOTAL_BUCKETS,
+              "TOTAL_BUCKETS must match LEVEL_CAPACITY");
+
+// One pool block per device: every level's ring lives inside the block
+struct history {
+    level_t levels[HISTORY_LEVEL_COUNT];
+    uint64_t latest_ms;                 // Newest sample time
+    bucket_t storage[TOTAL_BUCKETS];
+};
+
+static pool_t history_pool;
+static uint8_t *pool_storage = NULL;
+static uint16_t *pool_links = NULL;
+
+bool history_pool_init(uint16_t count)
+{
+    if (pool_storage != NULL || count == 0) {
+        return false;
+    }
+    pool_storage = (uint8_t *)malloc((size_t)count * POOL_BLOCK_SIZE(sizeof(history_t)));
+    pool_links = (uint16_t *)malloc(count * sizeof(uint16_t));
+    if (pool_storage == NULL || pool_links == NULL) {
+        history_pool_cleanup();
+        return false;
+    }
+    pool_init(&history_pool, pool_storage, pool_links, sizeof(history_t), count);
+    return true;
+}
+
+void history_pool_stats(pool_stats_t *stats)
+{
+    pool_get_stats(&history_pool, stats);
+}
+
+void history_pool_cleanup(void)
+{
+    free(pool_storage);
+    free(pool_links);
+    pool_storage = NULL;
+    pool_links = NULL;
+}
+
+history_t *history_create(void)
+{
+    if (pool_storage == NULL) {
+        return NULL;
+    }
+    history_t *hist = (history_t *)pool_alloc(&history_pool);
+    if (hist == NULL) {
+        return NULL;
+    }
+
+    bucket_t *next = hist->storage;
+    for (int l = 0; l < HISTORY_LEVEL_COUNT; l++) {
+        level_t *level = &hist->levels[l];
+        level->width_ms = LEVEL_WIDTH_MS[l];
+        level->capacity = LEVEL_CAPACITY[l];
+        level->buckets = next;
+        next += level->capacity;
+        for (uint32_t i = 0; i < level->capacity; i++) {
+            level->buckets[i].index = BUCKET_EMPTY;
+        }
+    }
+    hist->latest_ms = 0;
+    return hist;
+}
+
+void history_add(history_t *hist, uint64_t time_ms, const sensor_data_t *data)
+{
+    float values[HISTORY_FIELD_COUNT];
+    values[HISTORY_ACCEL_MAG] = sqrtf(data->accel_x * data->accel_x +
+                                      data->accel_y * data->accel_y +
+                                      data->accel_z * data->accel_z);
+    values[HISTORY_ACCEL_X] = data->accel_x;
+    values[HISTORY_ACCEL_Y] = data->accel_y;
+    values[HISTORY_ACCEL_Z] = data->accel_z;
+    values[HISTORY_GYRO_X] = data->gyro_x;
+    values[HISTORY_GYRO_Y] = data->gyro_y;
+    values[HISTORY_GYRO_Z] = data->gyro_z;
+    values[HISTORY_TEMPERATURE] = data->temperature;
+
+    for (int l = 0; l < HISTORY_LEVEL_COUNT; l++) {
+        level_t *level = &hist->levels[l];
+        uint64_t index = time_ms / level->width_ms;
+        bucket_t *b = &level->buckets[index % level->capacity];
+
+        if (b->index != index) {
+            // Bucket is empty or holds an expired period: start it fresh
+            b->index = index;
+            b->count = 0;
+            for (int f = 0; f < HISTORY_FIELD_COUNT; f++) {
+                b->min[f] = values[f];
+                b->max[f] = values[f];
+                b->sum[f] = 0.0f;
+            }
+        }
+
+        b->count++;
+        for (int f = 0; f < HISTORY_FIELD_COUNT; f++) {
+            b->min[f] = fminf(b->min[f], values[f]);
+            b->max[f] = fmaxf(b->max[f], values[f]);
+            b->sum[f] += values[f];
+        }
+    }
+
+    if (time_ms > hist->latest_ms) {
+        hist->latest_ms = time_ms;
+    }
+}
+
+// Coarsest level no wider than one output point that still retains start_ms
+static int choose_level(const history_t *hist, uint64_t start_ms, uint64_t point_ms)
+{
+    int chosen = 0;
+    for (int l = 0; l < HISTORY_LEVEL_COUNT; l++) {
+        if (hist->levels[l].width_ms <= point_ms) {
+            chosen = l;
+        }
+    }
+
+    while (chosen < HISTORY_LEVEL_COUNT - 1) {
+        const level_t *level = &hist->levels[chosen];
+        uint64_t retention = (uint64_t)level->width_ms * level->capacity;
+        if (hist->latest_ms < retention || start_ms >= hist->latest_ms - retention) {
+            break;
+        }
+        chosen++;
+    }
+    return chosen;
+}
+
+uint32_t history_query(const history_t *hist, uint64_t start_ms, uint64_t end_ms,
+                       uint32_t points, history_point_t *out)
+{
+    if (hist == NULL || out == NULL || points == 0 || end_ms <= start_ms) {
+        return 0;
+    }
+
+    uint64_t span = end_ms - start_ms;
+    uint64_t point_ms = span / points;
+    const level_t *level = &hist->levels[choose_level(hist, start_ms, point_ms)];
+
+    for (uint32_t p = 0; p < points; p++) {
+        out[p].start_ms = start_ms + span * p / points;
+        out[p].count = 0;
+    }
+
+    // Only indices still held in the ring can match; skip the rest, including
+    // any part of the range past the newest bucket
+    uint64_t first = start_ms / level->width_ms;
+    uint64_t last = (end_ms - 1) / level->width_ms;
+    uint64_t newest = hist->latest_ms / level->width_ms;
+    if (newest >= level->capacity && first < newest - level->capacity + 1) {
+        first = newest - level->capacity + 1;
+    }
+    if (last > newest) {
+        last = newest;
+    }
+
+    for (uint64_t index = first; index <= last; index++) {
+        const bucket_t *b = &level->buckets[index % level->capacity];
+        if (b->index != index || b->count == 0) {
+            continue;
+        }
+
+        uint64_t bucket_start = index * level->width_ms;
+        uint64_t offset = (bucket_start > start_ms) ? bucket_start - start_ms : 0;
+        history_point_t *pt = &out[offset * points / span];
+
+        if (pt->count == 0) {
+            for (int f = 0; f < HISTORY_FIELD_COUNT; f++) {
+                pt->min[f] = b->min[f];
+                pt->max[f] = b->max[f];
+                pt->mean[f] = 0.0f;
+            }
+        }
+        for (int f = 0; f < HISTORY_FIELD_COUNT; f++) {
+            pt->min[f] = fminf(pt->min[f], b->min[f]);
+            pt->max[f] = fmaxf(pt->max[f], b->max[f]);
+            pt->mean[f] += b->sum[f];      // Accumulate sums, divide below
+        }
+        pt->count += b->count;
+    }
+
+    for (uint32_t p = 0; p < points; p++) {
+        if (out[p].count > 0) {
+            for (int f = 0; f < HISTORY_FIELD_COUNT; f++) {
+                out[p].mean[f] /= (float)out[p].count;
+            }
+        }
+    }
+    return level->width_ms;
+}
+
+uint32_t history_level_width(int level)
+{
+    if (level < 0 || level >= HISTORY_LEVEL_COUNT) {
+        return 0;
+    }
+    return LEVEL_WIDTH_MS[level];
+}
+
+void history_destroy(history_t *hist)
+{
+    pool_free(&history_pool, hist);
+}
@@ -0,0 +1,130 @@
+// Hub Link - Frames forwarded by the ESP32 hub over UART
+#include "hub_link.h"
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+static_assert(PROTOCOL_HUB_LINK_BAUD == 460800, "update the termios speed below");
+
+// Raw 8N1 at the link rate: no echo, no line editing, no CR/LF translation
+static bool configure_tty(int fd)
+{
+    struct termios tio;
+    if (tcgetattr(fd, &tio) != 0) {
+        return false;
+    }
+    cfmakeraw(&tio);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cflag &= ~(CSTOPB | CRTSCTS);
+    tio.c_cc[VMIN] = 1;
+    tio.c_cc[VTIME] = 0;
+    if (cfsetispeed(&tio, B460800) != 0 || cfsetospeed(&tio, B460800) != 0) {
+        return false;
+    }
+    if (tcsetattr(fd, TCSANOW, &tio) != 0) {
+        return false;
+    }
+    tcflush(fd, TCIFLUSH);
+    return true;
+}
+
+bool hub_link_open(hub_link_t *link, const char *path)
+{
+    memset(link, 0, sizeof(*link));
+    if (strcmp(path, "-") == 0) {
+        link->fd = STDIN_FILENO;
+        return true;
+    }
+
+    link->fd = open(path, O_RDONLY | O_NOCTTY);
+    if (link->fd < 0) {
+        printf("HubLink - Cannot open %s\n", path);
+        return false;
+    }
+    if (isatty(link->fd) && !configure_tty(link->fd)) {
+        printf("HubLink - Cannot set %s to raw %d baud\n", path, PROTOCOL_HUB_LINK_BAUD);
+        close(link->fd);
+        link->fd = -1;
+        return false;
+    }
+    return true;
+}
+
+// Drop 'n' bytes from the front of the buffer
+static void consume(hub_link_t *link, uint32_t n)
+{
+    memmove(link->buffer, link->buffer + n, link->len - n);
+    link->len -= n;
+}
+
+// Decode the next packet from the buffer
+// Returns 1 with a frame, 0 if more input is needed.
+static int decode(hub_link_t *link, hub_frame_t *frame)
+{
+    protocol_packet_t packet;
+    while (link->len > 0) {
+        // Skip to the next START byte
+        uint8_t *start = (uint8_t *)memchr(link->buffer, PROTOCOL_START_BYTE, link->len);
+        uint32_t skip = (start != NULL) ? (uint32_t)(start - link->buffer) : link->len;
+        if (skip > 0) {
+            link->skipped_bytes += skip;
+            consume(link, skip);
+            continue;
+        }
+
+        int used = protocol_decode_packet(&packet, link->buffer, link->len);
+        if (used == 0) {
+            return 0;
+        }
+        if (used < 0 || packet.length < PROTOCOL_HUB_LINK_MAC) {
+            // Not a packet after all: resync from the next START byte
+            link->crc_errors++;
+            link->skipped_bytes++;
+            consume(link, 1);
+            continue;
+        }
+
+        memcpy(frame->mac, packet.payload, PROTOCOL_HUB_LINK_MAC);
+        frame->type = packet.type;
+        frame->length = (uint8_t)(packet.length - PROTOCOL_HUB_LINK_MAC);
+        memcpy(frame->payload, packet.payload + PROTOCOL_HUB_LINK_MAC, frame->length);
+        link->frames++;
+        consume(link, (uint32_t)used);
+        return 1;
+    }
+    return 0;
+}
+
+// Fails on EINTR so a shutdown signal can stop a blocked reader.
+bool hub_link_read(hub_link_t *link, hub_frame_t *frame)
+{
+    while (decode(link, frame) == 0) {
+        ssize_t n = read(link->fd, link->buffer + link->len, sizeof(link->buffer) - link->len);
+        if (n <= 0) {
+            return false;
+        }
+        link->len += (uint32_t)n;
+    }
+    return true;
+}
+
+bool hub_link_pending(const hub_link_t *link)
+{
+    if (link->len >= 2 && link->buffer[0] == PROTOCOL_START_BYTE &&
+        link->len >= 6u + link->buffer[1]) {
+        return true;
+    }
+    struct pollfd pfd = { link->fd, POLLIN, 0 };
+    return poll(&pfd, 1, 0) > 0;
+}
+
+void hub_link_close(hub_link_t *link)
+{
+    if (link->fd > STDIN_FILENO) {
+        close(link->fd);
+    }
+    link->fd = -1;
+}
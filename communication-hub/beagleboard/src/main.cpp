@@ -0,0 +1,520 @@
+/*
+ * FallGuys - Communication Hub BeagleBoard Daemon
+ *
+ * Reads frames forwarded by the ESP32 hub, keeps per-wearable state and runs
+ * fall detection against the live configuration snapshot. Candidate falls are
+ * confirmed or rejected by the fall classifier once the wearer has settled.
+ *
+ * USAGE:
+ *   fallguys-hub [config.json] [link] [log_dir] [calibration.csv]
+ *   link is a UART device, a recorded capture file, or "-" for stdin.
+ *   log_dir holds the alert write-ahead log; pending alerts survive restarts.
+ *   calibration.csv holds per-wearable IMU corrections (see calibration.h).
+ *
+ * Send SIGHUP (or edit config.json) to reload thresholds without restarting;
+ * per-device detector state is preserved across reloads.
+ */
+
+#include <atomic>
+#include <math.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <thread>
+#include <time.h>
+
+#include "common/burst_codec.h"
+#include "common/heap_guard.h"
+#include "calibration.h"
+#include "config.h"
+#include "device_table.h"
+#include "event_log.h"
+#include "fall_classifier.h"
+#include "fall_detector.h"
+#include "heartrate_analyzer.h"
+#include "history.h"
+#include "hub_link.h"
+
+static const char *DEFAULT_CONFIG_PATH = "config/config.json";
+static const char *DEFAULT_LINK_PATH = "/dev/ttyS1";
+static const char *DEFAULT_LOG_DIR = "data";
+static const char *DEFAULT_CALIBRATION_PATH = "config/calibration.csv";
+
+// Longest a settled event waits for others to share its classifier batch (ms)
+#define CLASSIFY_MAX_WAIT_MS 20
+
+// A FALL_DETECTED with no classified event this long after it is escalated
+// to FALL_CONFIRMED (burst lost, or its event never settled) (ms)
+#define FALL_REPORT_TIMEOUT_MS 5000
+
+static volatile sig_atomic_t reload_requested = 0;
+static std::atomic<bool> running{true};
+static int detector_reader = -1;     // Config reader slot of the ingest thread
+
+static const char *state_name(uint8_t state)
+{
+    switch (state) {
+    case STATE_IDLE:            return "IDLE";
+    case STATE_MONITORING:      return "MONITORING";
+    case STATE_FALL_SUSPECTED:  return "FALL_SUSPECTED";
+    case STATE_FALL_CONFIRMED:  return "FALL_CONFIRMED";
+    case STATE_EMERGENCY_ALERT: return "EMERGENCY_ALERT";
+    default:                    return "UNKNOWN";
+    }
+}
+
+static const char *hr_status_name(uint8_t status)
+{
+    switch (status) {
+    case HR_STATUS_OK:        return "OK";
+    case HR_STATUS_LOW:       return "LOW";
+    case HR_STATUS_HIGH:      return "HIGH";
+    case HR_STATUS_IRREGULAR: return "IRREGULAR";
+    default:                  return "ERROR";
+    }
+}
+
+// Hub wall-clock time (ms since epoch) used to index sensor history
+static uint64_t now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static void on_signal(int sig)
+{
+    if (sig == SIGHUP) {
+        reload_requested = 1;
+    } else {
+        running = false;
+    }
+}
+
+// ===== Configuration Watcher =====
+// Publishes new snapshots on SIGHUP or when config.json changes on disk.
+// Runs outside the detector path so workers never wait on file I/O.
+
+static void config_watcher(const char *path)
+{
+    // Leave signal delivery to the main thread so it can leave a blocked read
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGHUP);
+    sigaddset(&mask, SIGINT);
+    sigaddset(&mask, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &mask, NULL);
+
+    struct stat st;
+    time_t last_mtime = (stat(path, &st) == 0) ? st.st_mtime : 0;
+
+    while (running) {
+        struct timespec pause = {0, 200000000};  // 200 ms
+        nanosleep(&pause, NULL);
+
+        bool changed = false;
+        if (stat(path, &st) == 0 && st.st_mtime != last_mtime) {
+            last_mtime = st.st_mtime;
+            changed = true;
+        }
+
+        if (reload_requested || changed) {
+            reload_requested = 0;
+            config_reload();
+        }
+    }
+}
+
+// ===== Alert Logging =====
+
+static uint64_t log_event(const device_t *dev, uint8_t type, uint8_t severity, uint8_t response)
+{
+    event_t event;
+    memset(&event, 0, sizeof(event));
+    memcpy(event.mac, dev->mac, 6);
+    event.type = type;
+    event.state = dev->fall.state;
+    event.severity = severity;
+    event.response = response;
+    event.time_ms = now_ms();
+    return event_log_append(&event);
+}
+
+// Rebuild per-device alert state from the log after a restart
+static void restore_alert_states(void)
+{
+    alert_state_t states[EVENT_LOG_MAX_DEVICES];
+    int count = event_log_alert_states(states, EVENT_LOG_MAX_DEVICES);
+
+    for (int i = 0; i < count; i++) {
+        device_t *dev = device_table_lookup(states[i].mac);
+        if (dev == NULL) {
+            continue;
+        }
+        dev->fall.state = states[i].state;
+        if (states[i].state >= STATE_FALL_CONFIRMED) {
+            printf("[ALERT] Pending alert restored for %02X:%02X:%02X:%02X:%02X:%02X (%s)\n",
+                   dev->mac[0], dev->mac[1], dev->mac[2],
+                   dev->mac[3], dev->mac[4], dev->mac[5], state_name(states[i].state));
+        }
+    }
+}
+
+static void classify_queue(device_t *dev, const float *features);
+
+// ===== Impact Bursts =====
+// The SENSOR_DATA stream is 10 Hz, too coarse for the impact itself, so the
+// full-rate burst is replayed through the same chain (fall_replay_t) and its
+// event classified like a streamed one.
+
+// Accumulate one IMPACT_BURST chunk; report the window once the last arrives
+static void handle_burst(device_t *dev, const hub_frame_t *frame, const hub_config_t *cfg)
+{
+    impact_burst_t chunk;
+    memset(&chunk, 0, sizeof(chunk));
+    memcpy(&chunk, frame->payload, frame->length < sizeof(chunk) ? frame->length : sizeof(chunk));
+
+    int16_t samples[255][IMPACT_BURST_CHANNELS];
+    int count = burst_decode(&chunk, frame->length, samples, 255);
+    if (count < 0) {
+        return;
+    }
+
+    // Dequantize the whole chunk, then correct it in one batch
+    float channels[255][CALIBRATION_CHANNELS];
+    for (int i = 0; i < count; i++) {
+        burst_dequantize(samples[i], &channels[i][0], &channels[i][3]);
+    }
+    calibration_apply_channels(&dev->calibration, channels, count);
+
+    burst_rx_t *rx = &dev->burst;
+    if (chunk.burst_id != rx->id || chunk.chunk == 0) {
+        memset(rx, 0, sizeof(*rx));
+        rx->id = chunk.burst_id;
+        fall_replay_init(&dev->replay);
+    }
+    if (chunk.chunk > rx->next_chunk) {
+        rx->lost_chunks += chunk.chunk - rx->next_chunk;
+    }
+    rx->next_chunk = chunk.chunk + 1;
+    rx->samples += count;
+
+    for (int i = 0; i < count; i++) {
+        const float *accel = channels[i];
+        float mag = sqrtf(accel[0] * accel[0] + accel[1] * accel[1] + accel[2] * accel[2]);
+        if (mag > rx->peak) {
+            rx->peak = mag;
+            rx->peak_index = (int16_t)(chunk.first_index + i);
+        }
+        if (!dev->replay.done &&
+            fall_replay_update(&dev->replay, chunk.first_index + i, chunk.rate_hz,
+                               &channels[i][0], &channels[i][3], cfg)) {
+            classify_queue(dev, dev->replay.event.features);
+        }
+    }
+
+    if (chunk.flags & IMPACT_BURST_LAST) {
+        // Window over before the posture settled: classify what it holds
+        if (!dev->replay.done && fall_replay_finish(&dev->replay)) {
+            classify_queue(dev, dev->replay.event.features);
+        }
+        printf("[BURST] %02X:%02X:%02X:%02X:%02X:%02X #%u: %u samples at %u Hz, %u chunks lost, "
+               "peak %.2f m/s^2 at %+d\n",
+               dev->mac[0], dev->mac[1], dev->mac[2], dev->mac[3], dev->mac[4], dev->mac[5],
+               rx->id, rx->samples, chunk.rate_hz, rx->lost_chunks, rx->peak, rx->peak_index);
+    }
+}
+
+// ===== Fall Classification =====
+// Settled candidate events are queued and scored as one batch when the link
+// has nothing more buffered, when the batch is full, or CLASSIFY_MAX_WAIT_MS
+// after the first was queued (a capture file always has input buffered).
+
+static fall_batch_t classify_batch;
+static device_t *classify_devices[FALL_CLASSIFIER_BATCH_MAX];
+static float classify_features[FALL_CLASSIFIER_BATCH_MAX][FALL_FEATURE_COUNT];
+static uint64_t classify_since_ms;
+static int reports_pending;     // Devices with report_ms set
+
+static void classify_flush(void)
+{
+    int32_t scores[FALL_CLASSIFIER_BATCH_MAX];
+    fall_classifier_batch_score(&classify_batch, scores);
+
+    for (int i = 0; i < classify_batch.count; i++) {
+        device_t *dev = classify_devices[i];
+        const float *f = classify_features[i];
+        float p = fall_classifier_probability(scores[i]);
+        bool fall = fall_classifier_is_fall(scores[i]);
+        printf("[FALL] %02X:%02X:%02X:%02X:%02X:%02X classified as %s (p %.2f, peak %.2f g, tilt change %.0f deg)\n",
+               dev->mac[0], dev->mac[1], dev->mac[2], dev->mac[3], dev->mac[4], dev->mac[5],
+               fall ? "FALL" : "no fall", p, f[FALL_FEATURE_PEAK_G], f[FALL_FEATURE_TILT_CHANGE]);
+        if (!fall || dev->fall.state >= STATE_FALL_CONFIRMED) {
+            continue;
+        }
+
+        // Confirmed on the hub: pending until the wearer responds, so make it durable
+        dev->fall.state = STATE_FALL_CONFIRMED;
+        event_log_wait(log_event(dev, EVENT_STATE_CHANGE, (uint8_t)(p * 255.0f), USER_NO_RESPONSE));
+        printf("[ALERT] Fall confirmed for %02X:%02X:%02X:%02X:%02X:%02X (p %.2f, %s)\n",
+               dev->mac[0], dev->mac[1], dev->mac[2], dev->mac[3], dev->mac[4], dev->mac[5],
+               p, orientation_posture_name((posture_t)dev->fall.posture));
+    }
+    fall_classifier_batch_init(&classify_batch);
+}
+
+static void classify_queue(device_t *dev, const float *features)
+{
+    if (classify_batch.count == FALL_CLASSIFIER_BATCH_MAX) {
+        classify_flush();
+    }
+    if (classify_batch.count == 0) {
+        classify_since_ms = now_ms();
+    }
+    int lane = fall_classifier_batch_add(&classify_batch, features);
+    classify_devices[lane] = dev;
+    memcpy(classify_features[lane], features, sizeof(classify_features[lane]));
+    if (dev->report_ms != 0) {
+        dev->report_ms = 0;
+        reports_pending--;
+    }
+}
+
+// ===== Unclassified Reports =====
+// Checked as frames arrive; every wearable sends at least a summary every 10 s.
+
+static void escalate_reports(void)
+{
+    uint64_t now = now_ms();
+    for (int i = 0; i < DEVICE_TABLE_SIZE && reports_pending > 0; i++) {
+        device_t *dev = device_table_at(i);
+        if (dev == NULL || dev->report_ms == 0) {
+            continue;
+        }
+        if (now - dev->report_ms < FALL_REPORT_TIMEOUT_MS) {
+            continue;
+        }
+        dev->report_ms = 0;
+        reports_pending--;
+        if (dev->fall.state >= STATE_FALL_CONFIRMED) {
+            continue;
+        }
+        dev->fall.state = STATE_FALL_CONFIRMED;
+        event_log_wait(log_event(dev, EVENT_STATE_CHANGE, 255, USER_NO_RESPONSE));
+        printf("[ALERT] Fall reported by %02X:%02X:%02X:%02X:%02X:%02X never classified, escalated\n",
+               dev->mac[0], dev->mac[1], dev->mac[2], dev->mac[3], dev->mac[4], dev->mac[5]);
+    }
+}
+
+// ===== Frame Dispatch =====
+
+static void handle_frame(const hub_frame_t *frame, const hub_config_t *cfg)
+{
+    device_t *dev = device_table_lookup(frame->mac);
+    if (dev == NULL) {
+        return;
+    }
+    dev->rx_count++;
+
+    switch (frame->type) {
+    case PKT_SENSOR_DATA: {
+        if (frame->length < sizeof(sensor_data_t)) {
+            return;
+        }
+        sensor_data_t data;
+        memcpy(&data, frame->payload, sizeof(data));
+        calibration_apply(&dev->calibration, &data, 1);
+
+        if (dev->history != NULL) {
+            history_add(dev->history, now_ms(), &data);
+        }
+        orientation_update(&dev->orientation, &data);
+        bool posture_pending = dev->fall.posture_pending;
+        if (fall_detector_process(&dev->fall, &data, &dev->orientation, cfg)) {
+            log_event(dev, EVENT_STATE_CHANGE, 0, USER_NO_RESPONSE);
+            printf("[FALL] %02X:%02X:%02X:%02X:%02X:%02X -> %s (%.2f m/s^2, tilt %.0f deg)\n",
+                   frame->mac[0], frame->mac[1], frame->mac[2],
+                   frame->mac[3], frame->mac[4], frame->mac[5],
+                   state_name(dev->fall.state), dev->fall.magnitude, dev->fall.tilt_deg);
+        }
+        if (posture_pending && !dev->fall.posture_pending) {
+            printf("[FALL] %02X:%02X:%02X:%02X:%02X:%02X posture after impact: %s (tilt %.0f deg)\n",
+                   frame->mac[0], frame->mac[1], frame->mac[2],
+                   frame->mac[3], frame->mac[4], frame->mac[5],
+                   orientation_posture_name((posture_t)dev->fall.posture), dev->fall.tilt_deg);
+        }
+        if (fall_event_update(&dev->event, &data, &dev->fall, &dev->orientation)) {
+            classify_queue(dev, dev->event.features);
+        }
+        break;
+    }
+    case PKT_FALL_DETECTED: {
+        if (frame->length < sizeof(fall_detected_t)) {
+            return;
+        }
+        fall_detected_t fall;
+        memcpy(&fall, frame->payload, sizeof(fall));
+
+        // The wearable's impact trigger also fires on jumps and hard landings,
+        // so a report is only a suspicion: the burst that follows is replayed
+        // (handle_burst) and the classifier confirms (classify_flush). A report
+        // nothing classifies within FALL_REPORT_TIMEOUT_MS is escalated.
+        if (dev->fall.state < STATE_FALL_SUSPECTED) {
+            dev->fall.state = STATE_FALL_SUSPECTED;
+        }
+        if (dev->report_ms == 0) {
+            reports_pending++;
+        }
+        dev->report_ms = now_ms();
+        log_event(dev, EVENT_FALL_DETECTED, fall.severity, USER_NO_RESPONSE);
+        printf("[FALL] Fall reported by %02X:%02X:%02X:%02X:%02X:%02X (severity %u, impact %.2f g) -> %s\n",
+               frame->mac[0], frame->mac[1], frame->mac[2],
+               frame->mac[3], frame->mac[4], frame->mac[5], fall.severity, fall.impact,
+               state_name(dev->fall.state));
+        break;
+    }
+    case PKT_IMPACT_BURST:
+        handle_burst(dev, frame, cfg);
+        break;
+    case PKT_USER_RESPONSE: {
+        if (frame->length < 1) {
+            return;
+        }
+        uint8_t response = frame->payload[0];
+        if (response == USER_CONFIRMED_OK) {
+            dev->fall.state = STATE_MONITORING;
+        } else if (response == USER_REQUESTED_HELP) {
+            dev->fall.state = STATE_EMERGENCY_ALERT;
+        }
+        event_log_wait(log_event(dev, EVENT_USER_RESPONSE, 0, response));
+        printf("[ALERT] %02X:%02X:%02X:%02X:%02X:%02X responded -> %s\n",
+               frame->mac[0], frame->mac[1], frame->mac[2],
+               frame->mac[3], frame->mac[4], frame->mac[5], state_name(dev->fall.state));
+        break;
+    }
+    case PKT_HEARTRATE: {
+        if (frame->length < sizeof(heartrate_t)) {
+            return;
+        }
+        heartrate_t reading;
+        memcpy(&reading, frame->payload, sizeof(reading));
+
+        uint8_t prev_status = dev->hr.status;
+        uint8_t status = hr_analyzer_update(&dev->hr, &reading, cfg);
+        if (status != prev_status) {
+            hr_stats_t stats;
+            hr_analyzer_stats(&dev->hr, &stats);
+            printf("[HR] %02X:%02X:%02X:%02X:%02X:%02X -> %s (%u bpm, mean %.1f, rmssd %.1f, SpO2 %u%%)\n",
+                   frame->mac[0], frame->mac[1], frame->mac[2],
+                   frame->mac[3], frame->mac[4], frame->mac[5],
+                   hr_status_name(status), reading.bpm, stats.mean_bpm,
+                   stats.rmssd_bpm, reading.spo2);
+        }
+        break;
+    }
+    default:
+        // CONFIG is hub-to-wearable traffic: a wearable must never retune the hub
+        break;
+    }
+}
+
+// ===== Main =====
+
+int main(int argc, char *argv[])
+{
+    const char *config_path = (argc > 1) ? argv[1] : DEFAULT_CONFIG_PATH;
+    const char *link_path = (argc > 2) ? argv[2] : DEFAULT_LINK_PATH;
+    const char *log_dir = (argc > 3) ? argv[3] : DEFAULT_LOG_DIR;
+    const char *calibration_path = (argc > 4) ? argv[4] : DEFAULT_CALIBRATION_PATH;
+
+    printf("FallGuys - Communication Hub (BeagleBoard)\n");
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_signal;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    sa.sa_flags = SA_RESTART;  // Reload requests must not interrupt the link
+    sigaction(SIGHUP, &sa, NULL);
+
+    if (!config_init(config_path)) {
+        return 1;
+    }
+
+    // Before the first device is created: entries are copied on first contact
+    calibration_load(calibration_path);
+
+    // Sensor history blocks for every device that may appear (no heap after this)
+    if (!history_pool_init(DEVICE_HISTORY_MAX)) {
+        printf("History - Cannot reserve %d pyramids\n", DEVICE_HISTORY_MAX);
+        config_cleanup();
+        return 1;
+    }
+
+    if (!event_log_init(log_dir)) {
+        history_pool_cleanup();
+        config_cleanup();
+        return 1;
+    }
+    restore_alert_states();
+
+    static hub_link_t link;
+    if (!hub_link_open(&link, link_path)) {
+        event_log_cleanup();
+        history_pool_cleanup();
+        config_cleanup();
+        return 1;
+    }
+
+    std::thread watcher(config_watcher, config_path);
+    detector_reader = config_reader_register();
+
+    fall_classifier_batch_init(&classify_batch);
+
+    // Warm-up done: the ingest path must not touch the heap from here on
+    heap_guard_arm();
+
+    hub_frame_t frame;
+    while (running) {
+        // Blocking read: go offline so reloads never wait on the link
+        config_reader_offline(detector_reader);
+        bool ok = hub_link_read(&link, &frame);
+        config_reader_online(detector_reader);
+        if (!ok) {
+            break;
+        }
+
+        handle_frame(&frame, config_acquire());
+        if (classify_batch.count > 0 &&
+            (!hub_link_pending(&link) || now_ms() - classify_since_ms >= CLASSIFY_MAX_WAIT_MS)) {
+            classify_flush();
+        }
+        if (reports_pending > 0) {
+            escalate_reports();
+        }
+        config_quiescent(detector_reader);
+    }
+    if (classify_batch.count > 0) {
+        classify_flush();
+    }
+
+    heap_guard_disarm();
+    printf("HeapGuard - %u heap allocations on the ingest path after warm-up\n",
+           (unsigned)heap_guard_violations());
+
+    config_reader_unregister(detector_reader);
+    running = false;
+    watcher.join();
+    printf("HubLink - %u frames, %u corrupted packets dropped, %u bytes skipped\n",
+           (unsigned)link.frames, (unsigned)link.crc_errors, (unsigned)link.skipped_bytes);
+    hub_link_close(&link);
+    pool_stats_t history_stats;
+    history_pool_stats(&history_stats);
+    printf("History - %u of %u pyramids in use, %u devices without history\n",
+           (unsigned)history_stats.in_use, (unsigned)history_stats.block_count,
+           (unsigned)history_stats.failures);
+    event_log_cleanup();
+    config_cleanup();
+    return 0;
+}
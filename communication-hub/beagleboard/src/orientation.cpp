@@ -0,0 +1,193 @@
+// Orientation - Incremental per-device orientation filter
+#include "orientation.h"
+#include <math.h>
+#include <string.h>
+
+#define GRAVITY 9.80665f
+#define RAD_TO_DEG 57.29578f
+
+// Posture limits on the vertical component of "up" in the device frame
+#define POSTURE_UPRIGHT_MIN 0.7071f     // cos(45 deg)
+
+static const char *POSTURE_NAMES[] = {
+    "UNKNOWN", "UPRIGHT", "PRONE", "SUPINE", "LEFT_SIDE", "RIGHT_SIDE", "INVERTED"
+};
+
+// Quaternion with zero yaw whose gravity direction matches the accelerometer
+static void seed_from_accel(float ax, float ay, float az, float *q0, float *q1, float *q2, float *q3)
+{
+    float roll = atan2f(ay, az);
+    float pitch = atan2f(-ax, sqrtf(ay * ay + az * az));
+    float cr = cosf(roll * 0.5f), sr = sinf(roll * 0.5f);
+    float cp = cosf(pitch * 0.5f), sp = sinf(pitch * 0.5f);
+    *q0 = cr * cp;
+    *q1 = sr * cp;
+    *q2 = cr * sp;
+    *q3 = -sr * sp;
+}
+
+// One Madgwick IMU step. Branch-free, so the batch loop can be vectorized.
+static inline void madgwick_step(float *pq0, float *pq1, float *pq2, float *pq3,
+                                 float ax, float ay, float az,
+                                 float gx, float gy, float gz, float dt)
+{
+    float q0 = *pq0, q1 = *pq1, q2 = *pq2, q3 = *pq3;
+
+    // Rate of change from the gyro
+    float qd0 = 0.5f * (-q1 * gx - q2 * gy - q3 * gz);
+    float qd1 = 0.5f * (q0 * gx + q2 * gz - q3 * gy);
+    float qd2 = 0.5f * (q0 * gy - q1 * gz + q3 * gx);
+    float qd3 = 0.5f * (q0 * gz + q1 * gy - q2 * gx);
+
+    // Gradient of the error between estimated and measured gravity
+    float norm_sq = ax * ax + ay * ay + az * az;
+    float norm = sqrtf(norm_sq);
+    float inv = 1.0f / (norm + 1e-6f);
+    ax *= inv;
+    ay *= inv;
+    az *= inv;
+
+    float _2q0 = 2.0f * q0, _2q1 = 2.0f * q1, _2q2 = 2.0f * q2, _2q3 = 2.0f * q3;
+    float _4q0 = 4.0f * q0, _4q1 = 4.0f * q1, _4q2 = 4.0f * q2;
+    float _8q1 = 8.0f * q1, _8q2 = 8.0f * q2;
+    float q0q0 = q0 * q0, q1q1 = q1 * q1, q2q2 = q2 * q2, q3q3 = q3 * q3;
+
+    float s0 = _4q0 * q2q2 + _2q2 * ax + _4q0 * q1q1 - _2q1 * ay;
+    float s1 = _4q1 * q3q3 - _2q3 * ax + 4.0f * q0q0 * q1 - _2q0 * ay - _4q1 +
+               _8q1 * q1q1 + _8q1 * q2q2 + _4q1 * az;
+    float s2 = 4.0f * q0q0 * q2 + _2q0 * ax + _4q2 * q3q3 - _2q3 * ay - _4q2 +
+               _8q2 * q1q1 + _8q2 * q2q2 + _4q2 * az;
+    float s3 = 4.0f * q1q1 * q3 - _2q1 * ax + 4.0f * q2q2 * q3 - _2q2 * ay;
+    float s_inv = 1.0f / sqrtf(s0 * s0 + s1 * s1 + s2 * s2 + s3 * s3 + 1e-12f);
+
+    // No correction while the accelerometer sees more than gravity (a 0/1
+    // factor rather than a branch)
+    float gate = (float)(fabsf(norm - GRAVITY) < ORIENTATION_ACCEL_GATE);
+    float beta = ORIENTATION_BETA * s_inv * gate;
+    qd0 -= beta * s0;
+    qd1 -= beta * s1;
+    qd2 -= beta * s2;
+    qd3 -= beta * s3;
+
+    q0 += qd0 * dt;
+    q1 += qd1 * dt;
+    q2 += qd2 * dt;
+    q3 += qd3 * dt;
+    float q_inv = 1.0f / sqrtf(q0 * q0 + q1 * q1 + q2 * q2 + q3 * q3);
+    *pq0 = q0 * q_inv;
+    *pq1 = q1 * q_inv;
+    *pq2 = q2 * q_inv;
+    *pq3 = q3 * q_inv;
+}
+
+// Vertical component of "up" in the device frame
+static float up_z(float q0, float q1, float q2, float q3)
+{
+    return q0 * q0 - q1 * q1 - q2 * q2 + q3 * q3;
+}
+
+static float tilt_deg(float q0, float q1, float q2, float q3)
+{
+    float z = up_z(q0, q1, q2, q3);
+    if (z > 1.0f) z = 1.0f;
+    if (z < -1.0f) z = -1.0f;
+    return acosf(z) * RAD_TO_DEG;
+}
+
+void orientation_init(orientation_t *o)
+{
+    o->q0 = 1.0f;
+    o->q1 = 0.0f;
+    o->q2 = 0.0f;
+    o->q3 = 0.0f;
+    o->last_ms = 0;
+    o->seeded = false;
+}
+
+void orientation_update(orientation_t *o, const sensor_data_t *data)
+{
+    uint32_t gap_ms = data->timestamp - o->last_ms;
+    if (!o->seeded || gap_ms == 0 || gap_ms > ORIENTATION_MAX_GAP_MS) {
+        // Nothing to integrate across: take the tilt from gravity
+        seed_from_accel(data->accel_x, data->accel_y, data->accel_z, &o->q0, &o->q1, &o->q2, &o->q3);
+        o->seeded = true;
+        o->last_ms = data->timestamp;
+        return;
+    }
+
+    madgwick_step(&o->q0, &o->q1, &o->q2, &o->q3,
+                  data->accel_x, data->accel_y, data->accel_z,
+                  data->gyro_x, data->gyro_y, data->gyro_z, gap_ms * 0.001f);
+    o->last_ms = data->timestamp;
+}
+
+float orientation_tilt_deg(const orientation_t *o)
+{
+    return tilt_deg(o->q0, o->q1, o->q2, o->q3);
+}
+
+posture_t orientation_posture(const orientation_t *o)
+{
+    if (!o->seeded) {
+        return POSTURE_UNKNOWN;
+    }
+
+    float ux = 2.0f * (o->q1 * o->q3 - o->q0 * o->q2);
+    float uy = 2.0f * (o->q0 * o->q1 + o->q2 * o->q3);
+    float uz = up_z(o->q0, o->q1, o->q2, o->q3);
+    if (uz >= POSTURE_UPRIGHT_MIN) {
+        return POSTURE_UPRIGHT;
+    }
+    if (uz <= -POSTURE_UPRIGHT_MIN) {
+        return POSTURE_INVERTED;
+    }
+    // Lying: the horizontal axis closest to vertical decides
+    if (fabsf(ux) >= fabsf(uy)) {
+        return (ux < 0.0f) ? POSTURE_PRONE : POSTURE_SUPINE;
+    }
+    return (uy > 0.0f) ? POSTURE_RIGHT_SIDE : POSTURE_LEFT_SIDE;
+}
+
+const char *orientation_posture_name(posture_t posture)
+{
+    return (posture >= POSTURE_UNKNOWN && posture <= POSTURE_INVERTED) ? POSTURE_NAMES[posture] : "UNKNOWN";
+}
+
+void orientation_batch_init(orientation_batch_t *batch, int count)
+{
+    if (count > ORIENTATION_BATCH_MAX) {
+        count = ORIENTATION_BATCH_MAX;
+    }
+    for (int i = 0; i < ORIENTATION_BATCH_MAX; i++) {
+        batch->q0[i] = 1.0f;
+        batch->q1[i] = 0.0f;
+        batch->q2[i] = 0.0f;
+        batch->q3[i] = 0.0f;
+    }
+    batch->count = count;
+}
+
+void orientation_batch_seed(orientation_batch_t *batch, int lane, float ax, float ay, float az)
+{
+    seed_from_accel(ax, ay, az, &batch->q0[lane], &batch->q1[lane], &batch->q2[lane], &batch->q3[lane]);
+}
+
+void orientation_batch_update(orientation_batch_t *batch, const orientation_input_t *in, float dt)
+{
+    float *__restrict q0 = batch->q0;
+    float *__restrict q1 = batch->q1;
+    float *__restrict q2 = batch->q2;
+    float *__restrict q3 = batch->q3;
+    int count = batch->count;
+
+    for (int i = 0; i < count; i++) {
+        madgwick_step(&q0[i], &q1[i], &q2[i], &q3[i],
+                      in->ax[i], in->ay[i], in->az[i],
+                      in->gx[i], in->gy[i], in->gz[i], dt);
+    }
+}
+
+float orientation_batch_tilt_deg(const orientation_batch_t *batch, int lane)
+{
+    return tilt_deg(batch->q0[lane], batch->q1[lane], batch->q2[lane], batch->q3[lane]);
+}
@@ -8,17 +8,27 @@
  * INSTRUCTIONS:
  * 1. Get this ESP32's MAC address using get_mac_address.cpp
  * 2. Put this MAC in the wearable's main_espnow.cpp (HUB_PEER_MAC)
- * 3. Put the wearable's MAC in WEARABLE_PEER_MAC below
+ * 3. Put the wearable's MAC in WEARABLE_PEER_MAC below (further wearables are
+ *    added as ESP-NOW peers when first heard from, up to MAX_PEERS)
  * 4. Upload this code to Communication Hub ESP32
  * 
- * NOTE: This is a placeholder for MS2. Currently just echoes data back.
- * Future: This will interface with BeagleBoard for fall detection algorithm.
+ * Every frame from a wearable is also forwarded to the BeagleBoard daemon
+ * over UART2 (see "BeagleBoard Link" below), which runs the real fall
+ * detection. The threshold check here only drives FALL_STATUS to the wearable.
  */
 
 #include <Arduino.h>
 #include <WiFi.h>
+#include "common/pool.h"
+#include "protocol.h"
+#include "common/burst_codec.h"
+#include "common/clock_sync.h"
+#include "common/dlog.h"
+#include "common/ingest_limit.h"
+#include "common/latency_hist.h"
 extern "C" {
   #include <esp_now.h>
+  #include <esp_timer.h>
   #include <esp_wifi.h>
   #include <esp_wifi_types.h>
 }
@@ -31,40 +41,97 @@ const uint8_t WIFI_CHANNEL = 1;  // Must match wearable
 
 // ===== Data Structures =====
 
-// Sensor data received FROM wearable
-typedef struct __attribute__((packed)) {
-  float accel_x;
-  float accel_y;
-  float accel_z;
-  float gyro_x;
-  float gyro_y;
-  float gyro_z;
-  float temperature;
-  uint32_t timestamp;
-} sensor_data_t;
-
-// Fall status sent TO wearable
-typedef struct __attribute__((packed)) {
-  uint8_t state;          // 0=IDLE, 1=MONITORING, 2=FALL_SUSPECTED, 3=FALL_CONFIRMED
-  uint8_t fall_severity;  // 0-255
-  float fall_confidence;  // 0.0-1.0
-  uint32_t timestamp;
-  uint8_t reserved[7];
-} fall_status_t;
+// Frames in both directions are one PKT_xxx type byte plus a protocol.h
+// payload (see protocol.h: the type byte is mandatory)
 
 static_assert(sizeof(sensor_data_t) == 32, "sensor_data_t must be 32 bytes");
+static_assert(sizeof(sensor_summary_t) == 24, "sensor_summary_t must be 24 bytes");
+static_assert(sizeof(fall_detected_t) == 28, "fall_detected_t must be 28 bytes");
 static_assert(sizeof(fall_status_t) == 16, "fall_status_t must be 16 bytes");
+static_assert(sizeof(ack_t) == 8, "ack_t must be 8 bytes");
+static_assert(sizeof(time_sync_t) == 32, "time_sync_t must be 32 bytes");
+
+// Received frame handed from the Wi-Fi task to loop()
+typedef struct {
+  uint8_t mac[6];
+  uint8_t type;                               // PKT_xxx
+  uint8_t len;                                // Payload bytes
+  int64_t rx_us;                              // Arrival time (esp_timer)
+  uint8_t payload[PROTOCOL_ESPNOW_MAX_FRAME];
+} rx_frame_t;
+
+// ===== Receive Pipeline =====
+// Frames are copied into pool blocks in the receive callback and processed in
+// loop(), so the Wi-Fi task never waits on Serial and no heap is used per packet.
+const int RX_QUEUE_DEPTH = 16;
+POOL_DEFINE(rxPool, rx_frame_t, RX_QUEUE_DEPTH)
+QueueHandle_t rxQueue = NULL;
+
+// ===== Ingest Limits =====
+// Each wearable gets a token bucket in the receive callback; over its budget
+// its SENSOR_DATA is downsampled, and once the pool is down to the blocks
+// kept for alerts everything but alerts is shed. Alerts are never shed.
+const int RX_ALERT_RESERVE = 4;
+ingest_limit_t ingestLimit;
+unsigned long alertDropCount = 0;
 
 // ===== State Variables =====
 unsigned long lastReceiveMs = 0;
 unsigned long receiveCount = 0;
+unsigned long summaryCount = 0;
+unsigned long unknownCount = 0;
+unsigned long fallReportCount = 0;
 unsigned long sendCount = 0;
+unsigned long dropCount = 0;
+unsigned long configSentCount = 0;
+unsigned long configAckCount = 0;
+unsigned long configNakCount = 0;
 sensor_data_t latestSensorData{};
 
+// Samples of the IMPACT_BURST chunk being decoded (reception state is per wearable)
+int16_t burstDecoded[255][IMPACT_BURST_CHANNELS];
+
+// ===== Clock Sync, Latency and Bursts =====
+// Each wearable's clock is tracked with TIME_SYNC exchanges so its sample
+// timestamps can be placed on the hub clock and latencies measured end to end.
+// Its impact burst is tracked alongside, so two wearables reporting falls at
+// the same time cannot mix their chunks. Replies go to the wearable a frame
+// came from, and TIME_SYNC to every wearable in the table.
+const int MAX_PEERS = 4;
+const unsigned long TIME_SYNC_INTERVAL_MS = 2000;
+
+// IMPACT_BURST reception after a FALL_DETECTED
+typedef struct {
+  uint16_t id;                // burst_id being received
+  uint8_t nextChunk;          // Chunk number expected next
+  unsigned long samples;      // Samples decoded so far
+  unsigned long lostChunks;   // Gaps in chunk numbers
+  float peak;                 // Peak |a| in the window (m/s^2)
+} burst_rx_t;
+
+typedef struct {
+  bool used;
+  uint8_t mac[6];
+  clock_sync_t clock;
+  latency_hist_t rtt;         // TIME_SYNC round trip (radio and both stacks)
+  latency_hist_t uplink;      // Sample taken -> frame arrived at the hub
+  latency_hist_t decision;    // Sample taken -> fall status sent back
+  latency_hist_t alert;       // Impact -> FALL status sent back
+  burst_rx_t burst;           // Impact burst in progress
+} peer_t;
+
+peer_t peers[MAX_PEERS];
+uint32_t timeSyncSeq = 0;
+unsigned long lastTimeSyncMs = 0;
+
 // Simple fall detection state (placeholder for MS2)
 uint8_t currentState = 1;  // 1 = MONITORING
 float fallMagnitude = 0.0f;
 
+// Placeholder detector threshold, changed with the "threshold" console command
+const float NORMAL_GRAVITY = 9.81f;  // m/s²
+float fallThreshold = 15.0f;         // m/s² (~1.5g)
+
 // ===== Fall Detection Algorithm (Placeholder) =====
 // This is a SIMPLE placeholder. Real algorithm will be on BeagleBoard.
 
@@ -79,10 +146,7 @@ void simpleFallDetection(const sensor_data_t &data) {
   fallMagnitude = accelMag;
   
   // Simple threshold detection (placeholder)
-  const float FALL_THRESHOLD = 15.0;  // m/s² (~1.5g)
-  const float NORMAL_GRAVITY = 9.81;   // m/s²
-  
-  if (accelMag > FALL_THRESHOLD) {
+  if (accelMag > fallThreshold) {
     // Sudden acceleration detected
     if (currentState == 1) {  // Was monitoring
       currentState = 2;  // FALL_SUSPECTED
@@ -104,53 +168,494 @@ void simpleFallDetection(const sensor_data_t &data) {
 
 // ===== ESP-NOW Callbacks =====
 
+// Callbacks run on the Wi-Fi task: log through dlog (a ring write), never Serial
 void onDataSent(const uint8_t *mac_addr, esp_now_send_status_t status) {
   if (status == ESP_NOW_SEND_SUCCESS) {
-    Serial.println("[TX] Fall status sent successfully");
+    DLOG_DEBUG("[TX] Fall status delivered");
   } else {
-    Serial.println("[TX] Send failed!");
+    DLOG_WARN("[TX] Send failed!");
   }
 }
 
 void onDataRecv(const esp_now_recv_info_t *info, const uint8_t *data, int len) {
-  if (len >= (int)sizeof(sensor_data_t)) {
-    memcpy(&latestSensorData, data, sizeof(sensor_data_t));
-    lastReceiveMs = millis();
-    receiveCount++;
-    
-    Serial.printf("[RX #%lu] Sensor data from %02X:%02X:%02X:%02X:%02X:%02X\n",
-      receiveCount,
-      info->src_addr[0], info->src_addr[1], info->src_addr[2],
-      info->src_addr[3], info->src_addr[4], info->src_addr[5]);
-    
-    Serial.printf("     Accel: %.2f, %.2f, %.2f m/s²\n",
-      latestSensorData.accel_x,
-      latestSensorData.accel_y,
-      latestSensorData.accel_z);
-    
-    Serial.printf("     Gyro:  %.2f, %.2f, %.2f rad/s\n",
-      latestSensorData.gyro_x,
-      latestSensorData.gyro_y,
-      latestSensorData.gyro_z);
-    
-    Serial.printf("     Temp:  %.1f °C\n", latestSensorData.temperature);
-    
-    // Run fall detection algorithm
-    simpleFallDetection(latestSensorData);
-    
-    // Send fall status back to wearable
-    fall_status_t status;
-    status.state = currentState;
-    status.fall_severity = (uint8_t)(constrain(fallMagnitude / 20.0 * 255, 0, 255));
-    status.fall_confidence = constrain(fallMagnitude / 20.0, 0.0, 1.0);
-    status.timestamp = millis();
-    memset(status.reserved, 0, sizeof(status.reserved));
-    
-    esp_err_t result = esp_now_send(WEARABLE_PEER_MAC, (const uint8_t*)&status, sizeof(status));
-    if (result == ESP_OK) {
-      sendCount++;
+  if (len < 1 || len > PROTOCOL_ESPNOW_MAX_FRAME) {
+    return;
+  }
+
+  uint8_t type = data[0];
+  data++;
+  len--;
+
+  int64_t nowUs = esp_timer_get_time();
+  bool saturated = rxPool.in_use.load(std::memory_order_relaxed) >= (uint32_t)(RX_QUEUE_DEPTH - RX_ALERT_RESERVE);
+  if (!ingest_limit_admit(&ingestLimit, info->src_addr, type, (uint64_t)nowUs, saturated)) {
+    return;
+  }
+
+  rx_frame_t *frame = (rx_frame_t *)pool_alloc(&rxPool);
+  if (frame == NULL) {
+    dropCount++;  // loop() is behind; shed instead of allocating
+    if (ingest_limit_is_alert(type)) {
+      alertDropCount++;
+    }
+    return;
+  }
+
+  frame->rx_us = nowUs;
+  memcpy(frame->mac, info->src_addr, 6);
+  frame->type = type;
+  frame->len = (uint8_t)len;
+  memcpy(frame->payload, data, len);
+  if (xQueueSend(rxQueue, &frame, 0) != pdTRUE) {
+    pool_free(&rxPool, frame);
+    dropCount++;
+    if (ingest_limit_is_alert(type)) {
+      alertDropCount++;
+    }
+  }
+}
+
+// ===== BeagleBoard Link =====
+// Every frame from a wearable goes to the BeagleBoard daemon as one protocol.h
+// packet: the wearable's MAC plus the ESP-NOW payload, CRC-checked so the
+// daemon can resync after a lost byte. Hub-local traffic (ACK, TIME_SYNC) is
+// not forwarded.
+HardwareSerial &beagleLink = Serial2;
+const int BEAGLE_RX_PIN = 16;
+const int BEAGLE_TX_PIN = 17;
+const size_t BEAGLE_TX_BUFFER = 2048;  // ~40 ms at the link rate
+unsigned long forwardCount = 0;
+unsigned long forwardDropCount = 0;
+
+bool isForwarded(uint8_t type) {
+  switch (type) {
+  case PKT_SENSOR_DATA:
+  case PKT_FALL_DETECTED:
+  case PKT_HEARTRATE:
+  case PKT_SENSOR_SUMMARY:
+  case PKT_IMPACT_BURST:
+  case PKT_STATUS_RESPONSE:
+  case PKT_USER_RESPONSE:
+    return true;
+  default:
+    return false;
+  }
+}
+
+void forwardFrame(const rx_frame_t *frame) {
+  if (!isForwarded(frame->type)) {
+    return;
+  }
+  uint8_t payload[PROTOCOL_MAX_PAYLOAD];
+  memcpy(payload, frame->mac, PROTOCOL_HUB_LINK_MAC);
+  memcpy(payload + PROTOCOL_HUB_LINK_MAC, frame->payload, frame->len);
+  uint8_t packet[PROTOCOL_MAX_PAYLOAD + 6];
+  int len = protocol_encode_packet(packet, frame->type, payload, PROTOCOL_HUB_LINK_MAC + frame->len);
+  
+  // Never block loop() on the UART: drop the frame if the daemon is not keeping up
+  if (len < 0 || beagleLink.availableForWrite() < len) {
+    forwardDropCount++;
+    return;
+  }
+  beagleLink.write(packet, len);
+  forwardCount++;
+}
+
+// ===== Frame Processing (loop task) =====
+
+// Register a wearable as an ESP-NOW peer (needed to send to it, not to receive)
+bool addEspNowPeer(const uint8_t *mac) {
+  if (esp_now_is_peer_exist(mac)) {
+    return true;
+  }
+  esp_now_peer_info_t peerInfo{};
+  memcpy(peerInfo.peer_addr, mac, 6);
+  peerInfo.channel = WIFI_CHANNEL;
+  peerInfo.encrypt = false;
+  return esp_now_add_peer(&peerInfo) == ESP_OK;
+}
+
+// Send one frame to a wearable: PKT_xxx type byte followed by the payload
+bool sendFrame(const uint8_t *mac, uint8_t type, const void *payload, size_t len) {
+  uint8_t frame[PROTOCOL_ESPNOW_MAX_FRAME];
+  frame[0] = type;
+  memcpy(frame + 1, payload, len);
+  
+  esp_err_t result = esp_now_send(mac, frame, len + 1);
+  if (result != ESP_OK) {
+    DLOG_WARN("[TX] Send error: %d", (int)result);
+    return false;
+  }
+  sendCount++;
+  return true;
+}
+
+void sendFallStatus(const uint8_t *mac) {
+  fall_status_t status;
+  status.state = currentState;
+  status.fall_severity = (uint8_t)(constrain(fallMagnitude / 20.0 * 255, 0, 255));
+  status.fall_confidence = constrain(fallMagnitude / 20.0, 0.0, 1.0);
+  status.timestamp = millis();
+  memset(status.reserved, 0, sizeof(status.reserved));
+  
+  sendFrame(mac, PKT_FALL_STATUS, &status, sizeof(status));
+}
+
+// Change one setting on every wearable heard from (WEARABLE_PEER_MAC before
+// any has been); each answers with an ACK_CONFIG
+bool sendConfig(uint8_t configId, const void *value, uint8_t len) {
+  config_t config;
+  config.config_id = configId;
+  config.length = len;
+  memcpy(config.value, value, len);
+  
+  int targets = 0, sent = 0;
+  for (int i = 0; i < MAX_PEERS; i++) {
+    if (peers[i].used) {
+      targets++;
+      sent += sendFrame(peers[i].mac, PKT_CONFIG, &config, 2 + len);
     }
   }
+  if (targets == 0) {
+    targets++;
+    sent += sendFrame(WEARABLE_PEER_MAC, PKT_CONFIG, &config, 2 + len);
+  }
+  if (sent == 0) {
+    return false;
+  }
+  configSentCount += sent;
+  Serial.printf("[CONFIG] Sent config %u (%u bytes) to %d of %d wearables\n", configId, len, sent, targets);
+  return true;
+}
+
+void handleAck(const rx_frame_t *frame) {
+  ack_t ack;
+  memcpy(&ack, frame->payload, sizeof(ack));
+  if (ack.ack_type != ACK_CONFIG) {
+    return;
+  }
+  
+  if (ack.status == ACK_STATUS_OK) {
+    configAckCount++;
+    Serial.printf("[CONFIG] Config %u applied by wearable\n", ack.seq_num);
+  } else {
+    configNakCount++;
+    Serial.printf("[CONFIG] Config %u rejected by wearable (%s)\n", ack.seq_num,
+      ack.status == ACK_STATUS_UNSUPPORTED ? "unsupported" : "invalid");
+  }
+}
+
+// State for a wearable, created on first use (NULL when full)
+peer_t *findPeer(const uint8_t *mac) {
+  peer_t *freeSlot = NULL;
+  for (int i = 0; i < MAX_PEERS; i++) {
+    if (peers[i].used && memcmp(peers[i].mac, mac, 6) == 0) {
+      return &peers[i];
+    }
+    if (!peers[i].used && freeSlot == NULL) {
+      freeSlot = &peers[i];
+    }
+  }
+  if (freeSlot != NULL) {
+    if (!addEspNowPeer(mac)) {
+      DLOG_WARN("[ESP-NOW] Cannot add peer ..:%02X:%02X:%02X", mac[3], mac[4], mac[5]);
+    }
+    memset(freeSlot, 0, sizeof(*freeSlot));
+    freeSlot->used = true;
+    memcpy(freeSlot->mac, mac, 6);
+    clock_sync_init(&freeSlot->clock);
+    latency_hist_init(&freeSlot->rtt);
+    latency_hist_init(&freeSlot->uplink);
+    latency_hist_init(&freeSlot->decision);
+    latency_hist_init(&freeSlot->alert);
+  }
+  return freeSlot;
+}
+
+// One exchange with every wearable in the table, each stamped when sent
+void sendTimeSync() {
+  for (int i = 0; i < MAX_PEERS; i++) {
+    if (!peers[i].used) {
+      continue;
+    }
+    time_sync_t sync{};
+    sync.seq = ++timeSyncSeq;
+    sync.t0_us = esp_timer_get_time();
+    sendFrame(peers[i].mac, PKT_TIME_SYNC, &sync, sizeof(sync));
+  }
+}
+
+void handleTimeSync(const rx_frame_t *frame) {
+  time_sync_t sync;
+  memcpy(&sync, frame->payload, sizeof(sync));
+  peer_t *peer = findPeer(frame->mac);
+  if (peer == NULL) {
+    return;
+  }
+  
+  if (clock_sync_add(&peer->clock, sync.t0_us, sync.t1_us, sync.t2_us, frame->rx_us)) {
+    latency_hist_add(&peer->rtt, peer->clock.last_delay_us);
+    DLOG_DEBUG("[SYNC #%lu] rtt %ld us, offset %ld us",
+      (unsigned long)sync.seq, (long)peer->clock.last_delay_us,
+      (long)clock_sync_offset(&peer->clock, frame->rx_us));
+  } else {
+    DLOG_WARN("[SYNC #%lu] Inconsistent timestamps", (unsigned long)sync.seq);
+  }
+}
+
+void handleSensorData(const rx_frame_t *frame) {
+  memcpy(&latestSensorData, frame->payload, sizeof(sensor_data_t));
+  
+  DLOG_DEBUG("[RX #%lu] Sensor data from ..:%02X:%02X:%02X",
+    receiveCount, frame->mac[3], frame->mac[4], frame->mac[5]);
+  DLOG_DEBUG("     Accel: %.2f, %.2f, %.2f m/s^2",
+    latestSensorData.accel_x, latestSensorData.accel_y, latestSensorData.accel_z);
+  DLOG_DEBUG("     Gyro:  %.2f, %.2f, %.2f rad/s, Temp: %.1f C",
+    latestSensorData.gyro_x, latestSensorData.gyro_y, latestSensorData.gyro_z,
+    latestSensorData.temperature);
+  
+  // Run fall detection algorithm
+  simpleFallDetection(latestSensorData);
+  
+  // Send fall status back to wearable
+  sendFallStatus(frame->mac);
+  
+  // Sample timestamp (wearable millis()) on the hub clock; none before the first sync
+  peer_t *peer = findPeer(frame->mac);
+  if (peer != NULL && peer->clock.valid) {
+    int64_t sampleUs = clock_sync_remote_ms_to_local(&peer->clock, latestSensorData.timestamp, frame->rx_us);
+    latency_hist_add(&peer->uplink, frame->rx_us - sampleUs);
+    latency_hist_add(&peer->decision, esp_timer_get_time() - sampleUs);
+  }
+}
+
+void handleSensorSummary(const rx_frame_t *frame) {
+  sensor_summary_t summary;
+  memcpy(&summary, frame->payload, sizeof(summary));
+  summaryCount++;
+  
+  DLOG_INFO("[RX #%lu] Still summary from ..:%02X:%02X:%02X",
+    receiveCount, frame->mac[3], frame->mac[4], frame->mac[5]);
+  DLOG_INFO("     |a| rms %.2f, min %.2f, max %.2f m/s^2, energy %.3f",
+    summary.accel_rms, summary.accel_min, summary.accel_max, summary.motion_energy);
+  
+  // Keep the wearable's status fresh while it is quiet
+  sendFallStatus(frame->mac);
+}
+
+void handleFallDetected(const rx_frame_t *frame) {
+  fall_detected_t fall;
+  memcpy(&fall, frame->payload, sizeof(fall));
+  fallReportCount++;
+  
+  Serial.printf("[FALL] Reported by %02X:%02X:%02X:%02X:%02X:%02X: %.2f g, free fall %lu ms, severity %u\n",
+    frame->mac[0], frame->mac[1], frame->mac[2],
+    frame->mac[3], frame->mac[4], frame->mac[5],
+    fall.impact, (unsigned long)fall.duration, fall.severity);
+  
+  // Only suspected here: the report and the burst that follows are forwarded
+  // to the BeagleBoard, whose classifier decides whether it was a fall
+  currentState = 2;  // FALL_SUSPECTED
+  fallMagnitude = fall.impact * 9.81f;
+  sendFallStatus(frame->mac);
+  
+  // Impact to alert, the latency the SLA is about
+  peer_t *peer = findPeer(frame->mac);
+  if (peer != NULL && peer->clock.valid) {
+    int64_t impactUs = clock_sync_remote_ms_to_local(&peer->clock, fall.timestamp, frame->rx_us);
+    latency_hist_add(&peer->alert, esp_timer_get_time() - impactUs);
+  }
+}
+
+void handleImpactBurst(const rx_frame_t *frame) {
+  impact_burst_t burst;
+  memcpy(&burst, frame->payload, min((size_t)frame->len, sizeof(burst)));
+  int n = burst_decode(&burst, frame->len, burstDecoded, 255);
+  if (n < 0) {
+    unknownCount++;
+    return;
+  }
+  
+  peer_t *peer = findPeer(frame->mac);
+  if (peer == NULL) {
+    return;  // Peer table full: the BeagleBoard still gets the forwarded chunk
+  }
+  
+  // A new burst id starts a new window; gaps in chunk numbers are lost chunks
+  burst_rx_t *rx = &peer->burst;
+  if (burst.burst_id != rx->id || burst.chunk == 0) {
+    memset(rx, 0, sizeof(*rx));
+    rx->id = burst.burst_id;
+  }
+  if (burst.chunk > rx->nextChunk) {
+    rx->lostChunks += burst.chunk - rx->nextChunk;
+  }
+  rx->nextChunk = burst.chunk + 1;
+  rx->samples += n;
+  
+  for (int i = 0; i < n; i++) {
+    float accel[3], gyro[3];
+    burst_dequantize(burstDecoded[i], accel, gyro);
+    float mag = sqrt(accel[0] * accel[0] + accel[1] * accel[1] + accel[2] * accel[2]);
+    if (mag > rx->peak) {
+      rx->peak = mag;
+    }
+  }
+  
+  if (burst.flags & IMPACT_BURST_LAST) {
+    Serial.printf("[BURST] %02X:%02X:%02X:%02X:%02X:%02X #%u: %lu samples at %u Hz in %u chunks (%lu lost), peak %.2f m/s²\n",
+      frame->mac[0], frame->mac[1], frame->mac[2],
+      frame->mac[3], frame->mac[4], frame->mac[5],
+      rx->id, rx->samples, burst.rate_hz, rx->nextChunk, rx->lostChunks, rx->peak);
+  }
+}
+
+void processFrame(const rx_frame_t *frame) {
+  lastReceiveMs = millis();
+  receiveCount++;
+  forwardFrame(frame);
+  findPeer(frame->mac);  // First contact: add the wearable so replies can reach it
+  
+  if (frame->type == PKT_SENSOR_DATA && frame->len >= sizeof(sensor_data_t)) {
+    handleSensorData(frame);
+  } else if (frame->type == PKT_SENSOR_SUMMARY && frame->len >= sizeof(sensor_summary_t)) {
+    handleSensorSummary(frame);
+  } else if (frame->type == PKT_FALL_DETECTED && frame->len >= sizeof(fall_detected_t)) {
+    handleFallDetected(frame);
+  } else if (frame->type == PKT_IMPACT_BURST) {
+    handleImpactBurst(frame);
+  } else if (frame->type == PKT_ACK && frame->len >= sizeof(ack_t)) {
+    handleAck(frame);
+  } else if (frame->type == PKT_TIME_SYNC && frame->len >= sizeof(time_sync_t)) {
+    handleTimeSync(frame);
+  } else {
+    unknownCount++;
+  }
+}
+
+// ===== Latency Report =====
+
+void printLatency(const char *name, const latency_hist_t *hist) {
+  if (hist->count == 0) {
+    Serial.printf("  %-9s no samples\n", name);
+    return;
+  }
+  Serial.printf("  %-9s n=%lu p50 %.1f ms, p90 %.1f ms, p99 %.1f ms, max %.1f ms%s\n", name,
+    (unsigned long)hist->count,
+    latency_hist_percentile(hist, 0.50f) / 1000.0f,
+    latency_hist_percentile(hist, 0.90f) / 1000.0f,
+    latency_hist_percentile(hist, 0.99f) / 1000.0f,
+    hist->max_us / 1000.0f,
+    hist->negative > 0 ? " (some negative: sync error)" : "");
+}
+
+void printLatencyReport() {
+  for (int i = 0; i < MAX_PEERS; i++) {
+    const peer_t *peer = &peers[i];
+    if (!peer->used) {
+      continue;
+    }
+    Serial.printf("Latency:  %02X:%02X:%02X:%02X:%02X:%02X offset %lld us, drift %.1f ppm, %lu syncs (%lu rejected)\n",
+      peer->mac[0], peer->mac[1], peer->mac[2], peer->mac[3], peer->mac[4], peer->mac[5],
+      (long long)clock_sync_offset(&peer->clock, esp_timer_get_time()),
+      clock_sync_drift_ppm(&peer->clock),
+      (unsigned long)peer->clock.exchanges, (unsigned long)peer->clock.rejected);
+    printLatency("rtt", &peer->rtt);
+    printLatency("uplink", &peer->uplink);
+    printLatency("decision", &peer->decision);
+    printLatency("alert", &peer->alert);
+  }
+}
+
+// Shed traffic in total and for each wearable that lost any
+void printIngestReport() {
+  ingest_limit_counts_t total;
+  ingest_limit_get_totals(&ingestLimit, &total);
+  Serial.printf("Ingest:   %lu admitted (%lu alerts, %lu downsampled), shed %lu over budget, %lu saturated\n",
+    (unsigned long)total.admitted, (unsigned long)total.alerts, (unsigned long)total.downsampled,
+    (unsigned long)total.shed_budget, (unsigned long)total.shed_saturated);
+  for (int i = 0; i <= INGEST_LIMIT_MAX_PEERS; i++) {
+    const ingest_peer_t *peer = ingest_limit_peer(&ingestLimit, i);
+    if (peer == NULL || peer->counts.shed_budget + peer->counts.shed_saturated == 0) {
+      continue;
+    }
+    if (i == INGEST_LIMIT_MAX_PEERS) {
+      Serial.printf("Ingest:   other peers");
+    } else {
+      Serial.printf("Ingest:   %02X:%02X:%02X:%02X:%02X:%02X",
+        peer->mac[0], peer->mac[1], peer->mac[2], peer->mac[3], peer->mac[4], peer->mac[5]);
+    }
+    Serial.printf(" %lu admitted, %lu downsampled, shed %lu over budget, %lu saturated\n",
+      (unsigned long)peer->counts.admitted, (unsigned long)peer->counts.downsampled,
+      (unsigned long)peer->counts.shed_budget, (unsigned long)peer->counts.shed_saturated);
+  }
+}
+
+// ===== Serial Console =====
+// One command per line to throttle or boost the wearables:
+//   rate <Hz> | interval <ms> | profile <0-2> | brightness <0-255> | threshold <g>
+// threshold also sets the hub's placeholder detector.
+
+void handleCommand(char *line) {
+  char *name = strtok(line, " ");
+  char *arg = strtok(NULL, " ");
+  if (name == NULL) {
+    return;
+  }
+  if (arg == NULL) {
+    Serial.println("[CONFIG] Usage: rate|interval|profile|brightness|threshold <value>");
+    return;
+  }
+  
+  if (strcmp(name, "rate") == 0) {
+    uint32_t rateHz = strtoul(arg, NULL, 10);
+    sendConfig(CFG_SAMPLING_RATE, &rateHz, sizeof(rateHz));
+  } else if (strcmp(name, "interval") == 0) {
+    uint32_t intervalMs = strtoul(arg, NULL, 10);
+    sendConfig(CFG_SEND_INTERVAL, &intervalMs, sizeof(intervalMs));
+  } else if (strcmp(name, "profile") == 0) {
+    uint8_t profile = (uint8_t)strtoul(arg, NULL, 10);
+    sendConfig(CFG_IMU_PROFILE, &profile, sizeof(profile));
+  } else if (strcmp(name, "brightness") == 0) {
+    uint8_t brightness = (uint8_t)strtoul(arg, NULL, 10);
+    sendConfig(CFG_DISPLAY_BRIGHTNESS, &brightness, sizeof(brightness));
+  } else if (strcmp(name, "threshold") == 0) {
+    float thresholdG = strtof(arg, NULL);
+    if (!(thresholdG >= 1.5f && thresholdG <= 16.0f)) {
+      Serial.println("[CONFIG] Threshold must be 1.5-16 g");
+      return;
+    }
+    fallThreshold = thresholdG * NORMAL_GRAVITY;
+    Serial.printf("[CONFIG] Hub threshold %.2f m/s²\n", fallThreshold);
+    sendConfig(CFG_FALL_THRESHOLD, &thresholdG, sizeof(thresholdG));
+  } else {
+    Serial.printf("[CONFIG] Unknown command: %s\n", name);
+  }
+}
+
+// Collect console input without blocking loop()
+void pollSerial() {
+  static char line[48];
+  static size_t lineLen = 0;
+  while (Serial.available() > 0) {
+    char c = (char)Serial.read();
+    if (c == '\r' || c == '\n') {
+      line[lineLen] = '\0';
+      handleCommand(line);
+      lineLen = 0;
+    } else if (lineLen < sizeof(line) - 1) {
+      line[lineLen++] = c;
+    }
+  }
+}
+
+// ===== Deferred Log Output =====
+
+// Records drained per loop iteration (binary frames are 15-31 bytes)
+const int DLOG_FLUSH_PER_LOOP = 16;
+
+void dlogSink(const uint8_t *data, size_t len) {
+  Serial.write(data, len);
 }
 
 // ===== ESP-NOW Initialization =====
@@ -175,13 +680,8 @@ void initESPNow() {
   esp_now_register_send_cb(onDataSent);
   esp_now_register_recv_cb(onDataRecv);
   
-  // Add peer (Wearable Module)
-  esp_now_peer_info_t peerInfo{};
-  memcpy(peerInfo.peer_addr, WEARABLE_PEER_MAC, 6);
-  peerInfo.channel = WIFI_CHANNEL;
-  peerInfo.encrypt = false;
-  
-  if (esp_now_add_peer(&peerInfo) != ESP_OK) {
+  // Add peer (Wearable Module); others are added by findPeer() on first contact
+  if (!addEspNowPeer(WEARABLE_PEER_MAC)) {
     Serial.println("[ESP-NOW] Failed to add peer!");
     while (1) delay(1000);
   }
@@ -206,6 +706,15 @@ void setup() {
   Serial.println("FallGuys - Communication Hub (ESP32)");
   Serial.println("========================================\n");
   
+  // Receive pipeline (allocated once, before any packet arrives)
+  pool_init_rxPool();
+  rxQueue = xQueueCreate(RX_QUEUE_DEPTH, sizeof(rx_frame_t *));
+  ingest_limit_init(&ingestLimit, NULL);
+  
+  // Link to the BeagleBoard daemon (raw 8N1, see protocol.h)
+  beagleLink.setTxBufferSize(BEAGLE_TX_BUFFER);
+  beagleLink.begin(PROTOCOL_HUB_LINK_BAUD, SERIAL_8N1, BEAGLE_RX_PIN, BEAGLE_TX_PIN);
+  
   // Initialize ESP-NOW
   initESPNow();
   
@@ -221,8 +730,12 @@ void loop() {
   static unsigned long lastStatsMs = 0;
   if (now - lastStatsMs >= 5000) {
     Serial.println("\n--- Statistics ---");
-    Serial.printf("Received: %lu packets\n", receiveCount);
+    Serial.printf("Received: %lu packets (%lu summaries, %lu fall reports, %lu unknown)\n",
+      receiveCount, summaryCount, fallReportCount, unknownCount);
     Serial.printf("Sent:     %lu packets\n", sendCount);
+    Serial.printf("Beagle:   %lu forwarded, %lu dropped (link busy)\n", forwardCount, forwardDropCount);
+    Serial.printf("Config:   %lu sent, %lu applied, %lu rejected\n",
+      configSentCount, configAckCount, configNakCount);
     Serial.printf("State:    %s\n", 
       currentState == 0 ? "IDLE" :
       currentState == 1 ? "MONITORING" :
@@ -230,13 +743,47 @@ void loop() {
       currentState == 3 ? "FALL_CONFIRMED" : "UNKNOWN");
     Serial.printf("Fall Mag: %.2f m/s²\n", fallMagnitude);
     
-    if (now - lastReceiveMs > 2000) {
-      Serial.println("WARNING: No data received for 2+ seconds");
+    pool_stats_t poolStats;
+    pool_get_stats(&rxPool, &poolStats);
+    Serial.printf("Dropped:  %lu packets, %lu alerts (pool high water %lu/%u)\n",
+      dropCount, alertDropCount, (unsigned long)poolStats.high_water, poolStats.block_count);
+    printIngestReport();
+    Serial.printf("Heap:     %lu free, %lu minimum\n",
+      (unsigned long)ESP.getFreeHeap(), (unsigned long)ESP.getMinFreeHeap());
+    dlog_stats_t logStats;
+    dlog_get_stats(&logStats);
+    Serial.printf("Log:      %lu records, %lu dropped\n",
+      (unsigned long)logStats.written, (unsigned long)logStats.dropped);
+    printLatencyReport();
+    
+    // A still wearer only sends a summary every 10 seconds
+    if (now - lastReceiveMs > 15000) {
+      Serial.println("WARNING: No data received for 15+ seconds");
     }
     
     Serial.println();
     lastStatsMs = now;
   }
   
-  delay(100);
+  // Binary records for the host decoder, or text with -DDLOG_TEXT_OUTPUT
+#ifdef DLOG_TEXT_OUTPUT
+  dlog_flush_text(dlogSink, DLOG_FLUSH_PER_LOOP);
+#else
+  dlog_flush(dlogSink, DLOG_FLUSH_PER_LOOP);
+#endif
+  
+  pollSerial();
+  
+  // Clock sync exchange with the wearable
+  if (now - lastTimeSyncMs >= TIME_SYNC_INTERVAL_MS) {
+    sendTimeSync();
+    lastTimeSyncMs = now;
+  }
+  
+  // Process received frames (waits up to 100ms for the next one)
+  rx_frame_t *frame;
+  if (xQueueReceive(rxQueue, &frame, pdMS_TO_TICKS(100)) == pdTRUE) {
+    processFrame(frame);
+    pool_free(&rxPool, frame);
+  }
 }
@@ -18,10 +18,25 @@ extern "C" {
 #define PROTOCOL_END_BYTE       0x55
 #define PROTOCOL_MAX_PAYLOAD    255
 
+// ESP-NOW framing: one PKT_xxx type byte followed by the payload, in both
+// directions. The type byte is mandatory: variable-length payloads (IMPACT_BURST,
+// CONFIG) can make a typed frame any length, so frame length alone cannot tell
+// an untyped frame from older firmware apart.
+#define PROTOCOL_ESPNOW_MAX_FRAME 250
+
+// Hub link (ESP32 hub -> BeagleBoard UART, 8N1 raw): one packet per received
+// ESP-NOW frame, framed as START/LENGTH/TYPE/PAYLOAD/CRC16/END (CRC low byte
+// first). TYPE is the frame's PKT_xxx; the payload is the source wearable's
+// MAC followed by the ESP-NOW payload.
+#define PROTOCOL_HUB_LINK_BAUD  460800
+#define PROTOCOL_HUB_LINK_MAC   6
+
 // Packet types - Wearable to Hub
 #define PKT_SENSOR_DATA         0x01    // Periodic sensor data
 #define PKT_FALL_DETECTED       0x02    // Fall detection alert
 #define PKT_HEARTRATE           0x03    // Heart rate & vitals
+#define PKT_SENSOR_SUMMARY      0x04    // Low-rate summary while the wearer is still
+#define PKT_IMPACT_BURST        0x05    // Compressed samples around a FALL_DETECTED
 #define PKT_STATUS_RESPONSE     0x13    // Response to status request
 #define PKT_USER_RESPONSE       0x20    // User acknowledgment
 
@@ -29,12 +44,23 @@ extern "C" {
 #define PKT_ACK                 0x10    // Acknowledgment
 #define PKT_CONFIG              0x11    // Configuration update
 #define PKT_STATUS_REQUEST      0x12    // Status request
+#define PKT_FALL_STATUS         0x14    // Hub's fall assessment for the wearable
+#define PKT_TIME_SYNC           0x15    // Clock sync request (echoed back by the wearable)
 
 // Configuration IDs (for PKT_CONFIG)
 #define CFG_SAMPLING_RATE       0x01    // uint32_t (Hz)
 #define CFG_FALL_THRESHOLD      0x02    // float (g)
 #define CFG_ALERT_TIMEOUT       0x03    // uint32_t (seconds)
 #define CFG_DISPLAY_BRIGHTNESS  0x04    // uint8_t (0-255)
+#define CFG_IMU_PROFILE         0x05    // uint8_t (MPU6050_PROFILE_xxx)
+#define CFG_SEND_INTERVAL       0x06    // uint32_t (ms between SENSOR_DATA while active)
+
+// IMPACT_BURST sample encoding: ax, ay, az, gx, gy, gz as int16 counts
+#define IMPACT_BURST_CHANNELS   6
+#define IMPACT_BURST_ACCEL_LSB  0.01f   // m/s² per count (±327 m/s²)
+#define IMPACT_BURST_GYRO_LSB   0.002f  // rad/s per count (±65 rad/s)
+#define IMPACT_BURST_DATA_MAX   226     // Keeps a typed frame within PROTOCOL_ESPNOW_MAX_FRAME
+#define IMPACT_BURST_LAST       0x01    // flags: final chunk of the burst
 
 // System states
 #define STATE_IDLE              0x00
@@ -53,6 +79,12 @@ extern "C" {
 #define ACK_SENSOR_DATA         0x01
 #define ACK_FALL_DETECTED       0x02
 #define ACK_HEARTRATE           0x03
+#define ACK_CONFIG              0x04    // seq_num carries the CFG_xxx applied
+
+// ACK status
+#define ACK_STATUS_OK           0x00
+#define ACK_STATUS_INVALID      0x01    // Bad length or value out of range
+#define ACK_STATUS_UNSUPPORTED  0x02    // Setting not handled by this device
 
 // Heart rate status
 #define HR_STATUS_OK            0x00
@@ -87,6 +119,17 @@ typedef struct {
     uint32_t timestamp; // milliseconds
 } sensor_data_t;
 
+// SENSOR_SUMMARY payload (24 bytes), sent instead of SENSOR_DATA while still
+typedef struct {
+    float accel_rms;        // RMS of |a| over the window (m/s²)
+    float accel_min;        // Minimum |a| (m/s²)
+    float accel_max;        // Maximum |a| (m/s²)
+    float motion_energy;    // Mean motion energy (see activity gate)
+    uint16_t samples;       // Samples summarized
+    uint16_t window_ms;     // Window length (ms)
+    uint32_t timestamp;     // milliseconds (end of window)
+} sensor_summary_t;
+
 // FALL_DETECTED payload (28 bytes)
 typedef struct {
     uint8_t severity;       // 0-255 (0=low, 255=critical)
@@ -98,6 +141,21 @@ typedef struct {
     uint32_t timestamp;     // milliseconds
 } fall_detected_t;
 
+// IMPACT_BURST payload (22-byte header + data_len bytes). Each chunk is
+// decodable on its own: 'base' is its first sample, followed by samples-1
+// zigzag varint deltas per channel. Only the used part of data[] is sent.
+typedef struct {
+    uint16_t burst_id;      // Same for every chunk of one capture
+    uint8_t chunk;          // Chunk number (0-based)
+    uint8_t flags;          // IMPACT_BURST_xxx
+    uint16_t rate_hz;       // Sample rate of the capture
+    int16_t first_index;    // First sample relative to the impact (negative = before)
+    uint8_t samples;        // Samples in this chunk (including base)
+    uint8_t data_len;       // Bytes used in data[]
+    int16_t base[IMPACT_BURST_CHANNELS];
+    uint8_t data[IMPACT_BURST_DATA_MAX];
+} impact_burst_t;
+
 // HEARTRATE payload (16 bytes)
 typedef struct {
     uint16_t bpm;           // Beats per minute (40-200)
@@ -111,7 +169,8 @@ typedef struct {
 typedef struct {
     uint8_t ack_type;       // ACK_xxx
     uint8_t seq_num;        // Sequence number
-    uint8_t reserved[6];    // Reserved
+    uint8_t status;         // ACK_STATUS_xxx
+    uint8_t reserved[5];    // Reserved
 } ack_t;
 
 // CONFIG payload (variable)
@@ -121,6 +180,26 @@ typedef struct {
     uint8_t value[253];     // Configuration value
 } config_t;
 
+// FALL_STATUS payload (16 bytes, packed: the float is not 4-byte aligned)
+typedef struct __attribute__((packed)) {
+    uint8_t state;          // STATE_xxx
+    uint8_t fall_severity;  // 0-255
+    float fall_confidence;  // 0.0-1.0
+    uint32_t timestamp;     // milliseconds
+    uint8_t reserved[6];    // Reserved
+} fall_status_t;
+
+// TIME_SYNC payload (32 bytes). The hub sends seq and t0; the wearable
+// echoes them with t1 and t2 filled in. Times are esp_timer microseconds
+// since boot, in the same clock as millis().
+typedef struct {
+    uint32_t seq;           // Matches a reply to its request
+    uint32_t reserved;
+    int64_t t0_us;          // Hub send time (hub clock)
+    int64_t t1_us;          // Wearable receive time (wearable clock)
+    int64_t t2_us;          // Wearable reply time (wearable clock)
+} time_sync_t;
+
 // STATUS_RESPONSE payload (16 bytes)
 typedef struct {
     uint8_t state;          // STATE_xxx
@@ -171,7 +250,8 @@ int protocol_encode_packet(uint8_t* buffer, uint8_t type,
  * @param packet: Output packet structure
  * @param buffer: Input buffer
  * @param length: Buffer length
- * @return Number of bytes consumed, or -1 on error
+ * @return Number of bytes consumed, 0 if the packet is not complete yet, or -1
+ *         if buffer[0] does not start a valid packet (skip a byte to resync)
  */
 int protocol_decode_packet(protocol_packet_t* packet, 
                            const uint8_t* buffer, size_t length);
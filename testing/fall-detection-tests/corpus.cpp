@@ -0,0 +1,497 @@
+// Fall Corpus - Labeled synthetic sensor_data_t traces for detector evaluation
+#include "corpus.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define GRAVITY 9.80665f
+#define DEG_TO_RAD 0.017453293f
+#define PI_F 3.14159265f
+
+#define CORPUS_MAGIC "# fallguys corpus v1"
+
+static const char *SCENARIO_NAMES[SCENARIO_COUNT] = {
+    "fall-forward",
+    "fall-backward",
+    "fall-lateral",
+    "fall-slump",
+    "adl-sitting",
+    "adl-jumping",
+    "adl-walking",
+    "adl-stairs"
+};
+
+// ===== Random numbers =====
+
+// xorshift32; one stream per trace so traces do not depend on each other
+typedef struct {
+    uint32_t state;
+    bool have_spare;
+    float spare;
+} rng_t;
+
+static void rng_seed(rng_t *rng, uint32_t seed, uint32_t scenario, uint32_t index)
+{
+    // FNV-1a over the three words, never zero
+    uint32_t h = 2166136261u;
+    const uint32_t words[3] = { seed, scenario, index };
+    for (int i = 0; i < 3; i++) {
+        for (int b = 0; b < 4; b++) {
+            h = (h ^ ((words[i] >> (b * 8)) & 0xFF)) * 16777619u;
+        }
+    }
+    rng->state = (h != 0) ? h : 1;
+    rng->have_spare = false;
+}
+
+static uint32_t rng_next(rng_t *rng)
+{
+    uint32_t x = rng->state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    rng->state = x;
+    return x;
+}
+
+// Uniform in [lo, hi)
+static float rng_uniform(rng_t *rng, float lo, float hi)
+{
+    return lo + (hi - lo) * (float)(rng_next(rng) >> 8) * (1.0f / 16777216.0f);
+}
+
+// Standard normal (Box-Muller)
+static float rng_gauss(rng_t *rng)
+{
+    if (rng->have_spare) {
+        rng->have_spare = false;
+        return rng->spare;
+    }
+    float u1 = rng_uniform(rng, 1e-7f, 1.0f);
+    float u2 = rng_uniform(rng, 0.0f, 1.0f);
+    float r = sqrtf(-2.0f * logf(u1));
+    rng->spare = r * sinf(2.0f * PI_F * u2);
+    rng->have_spare = true;
+    return r * cosf(2.0f * PI_F * u2);
+}
+
+static bool rng_chance(rng_t *rng, float p)
+{
+    return rng_uniform(rng, 0.0f, 1.0f) < p;
+}
+
+// ===== Signal model =====
+
+// Body state per sample: pitch (forward lean, rad), roll (right side down, rad),
+// specific-force scale along gravity (1 standing, 0 in free fall) and extra
+// specific force along the current "up" direction (m/s^2, impacts and steps)
+typedef struct {
+    int count;
+    float rate_hz;
+    std::vector<float> pitch;
+    std::vector<float> roll;
+    std::vector<float> scale;
+    std::vector<float> up_force;
+    std::vector<float> forward_force;   // Along device X (gait propulsion)
+} body_t;
+
+static void body_init(body_t *body, int count, float rate_hz)
+{
+    body->count = count;
+    body->rate_hz = rate_hz;
+    body->pitch.assign(count, 0.0f);
+    body->roll.assign(count, 0.0f);
+    body->scale.assign(count, 1.0f);
+    body->up_force.assign(count, 0.0f);
+    body->forward_force.assign(count, 0.0f);
+}
+
+static float sample_time(const body_t *body, int i)
+{
+    return (float)i / body->rate_hz;
+}
+
+// 0 before t0, 1 after t1, smooth in between
+static float smoothstep(float t0, float t1, float t)
+{
+    if (t <= t0) {
+        return 0.0f;
+    }
+    if (t >= t1) {
+        return 1.0f;
+    }
+    float x = (t - t0) / (t1 - t0);
+    return x * x * (3.0f - 2.0f * x);
+}
+
+// Half-sine of height 1 centred on 'center'
+static float pulse(float center, float width, float t)
+{
+    float x = (t - center) / width + 0.5f;
+    if (x <= 0.0f || x >= 1.0f) {
+        return 0.0f;
+    }
+    return sinf(PI_F * x);
+}
+
+// Add an impact or landing of peak |a| 'peak_g' at time 'at'
+static void add_impact(body_t *body, float at, float width_s, float peak_g)
+{
+    float extra = (peak_g - 1.0f) * GRAVITY;
+    for (int i = 0; i < body->count; i++) {
+        body->up_force[i] += extra * pulse(at, width_s, sample_time(body, i));
+    }
+}
+
+// Scale gravity down to 1 - depth between t0 and t1 (free fall, jump flight)
+static void add_freefall(body_t *body, float t0, float t1, float depth)
+{
+    for (int i = 0; i < body->count; i++) {
+        float t = sample_time(body, i);
+        if (t > t0 && t < t1) {
+            float s = 1.0f - depth * sinf(PI_F * (t - t0) / (t1 - t0));
+            if (s < body->scale[i]) {
+                body->scale[i] = s;
+            }
+        }
+    }
+}
+
+// Rotate from the current orientation to (pitch, roll) between t0 and t1 and
+// hold it afterwards
+static void add_rotation(body_t *body, float t0, float t1, float pitch, float roll)
+{
+    for (int i = 0; i < body->count; i++) {
+        float s = smoothstep(t0, t1, sample_time(body, i));
+        body->pitch[i] += pitch * s;
+        body->roll[i] += roll * s;
+    }
+}
+
+// Gait between t0 and t1: vertical bob, forward sway and a heel strike per step
+static void add_gait(body_t *body, rng_t *rng, float t0, float t1, float step_hz, float heel_g)
+{
+    float phase = rng_uniform(rng, 0.0f, 2.0f * PI_F);
+    float bob = rng_uniform(rng, 0.08f, 0.15f) * GRAVITY;
+    float sway = rng_uniform(rng, 2.0f, 4.0f) * DEG_TO_RAD;
+    float heel_width = rng_uniform(rng, 0.05f, 0.08f);
+
+    for (int i = 0; i < body->count; i++) {
+        float t = sample_time(body, i);
+        if (t < t0 || t > t1) {
+            continue;
+        }
+        float fade = smoothstep(t0, t0 + 0.3f, t) * (1.0f - smoothstep(t1 - 0.3f, t1, t));
+        float angle = 2.0f * PI_F * step_hz * (t - t0) + phase;
+        body->up_force[i] += fade * bob * sinf(angle);
+        body->forward_force[i] += fade * 0.5f * bob * cosf(angle);
+        body->pitch[i] += fade * sway * sinf(angle * 0.5f);
+    }
+
+    // Heel strikes once per step, with step-to-step variation
+    float period = 1.0f / step_hz;
+    for (float t = t0 + 0.3f + period * 0.5f; t < t1 - 0.3f; t += period * rng_uniform(rng, 0.95f, 1.05f)) {
+        add_impact(body, t, heel_width, 1.0f + heel_g * rng_uniform(rng, 0.8f, 1.2f));
+    }
+}
+
+// Small postural sway (standing, sitting, lying)
+static void add_sway(body_t *body, rng_t *rng, float t0, float t1)
+{
+    float hz = rng_uniform(rng, 0.2f, 0.5f);
+    float amp = rng_uniform(rng, 0.5f, 1.5f) * DEG_TO_RAD;
+    for (int i = 0; i < body->count; i++) {
+        float t = sample_time(body, i);
+        if (t >= t0 && t <= t1) {
+            body->roll[i] += amp * sinf(2.0f * PI_F * hz * t);
+        }
+    }
+}
+
+// ===== Scenarios =====
+
+// Forward, backward and lateral falls, plus the slower slump. Returns the
+// impact time.
+static float build_fall(body_t *body, rng_t *rng, scenario_t scenario, float duration_s)
+{
+    bool slump = scenario == SCENARIO_FALL_SLUMP;
+    float impact_t = rng_uniform(rng, 0.4f, 0.55f) * duration_s;
+    float fall_s = slump ? rng_uniform(rng, 0.8f, 1.5f) : rng_uniform(rng, 0.35f, 0.6f);
+    float start_t = impact_t - fall_s;
+
+    // Walking or standing until the fall starts
+    if (rng_chance(rng, 0.5f)) {
+        add_gait(body, rng, 0.5f, start_t + 0.2f, rng_uniform(rng, 1.7f, 2.1f), rng_uniform(rng, 0.3f, 0.6f));
+    } else {
+        add_sway(body, rng, 0.0f, start_t);
+    }
+
+    float final_deg = slump ? rng_uniform(rng, 40.0f, 70.0f) : rng_uniform(rng, 70.0f, 95.0f);
+    float final_rad = final_deg * DEG_TO_RAD;
+    float pitch = 0.0f, roll = 0.0f;
+    switch (scenario) {
+    case SCENARIO_FALL_FORWARD:  pitch = final_rad; break;
+    case SCENARIO_FALL_BACKWARD: pitch = -final_rad; break;
+    case SCENARIO_FALL_LATERAL:  roll = rng_chance(rng, 0.5f) ? final_rad : -final_rad; break;
+    default:
+        if (rng_chance(rng, 0.6f)) {
+            pitch = final_rad;
+        } else {
+            roll = rng_chance(rng, 0.5f) ? final_rad : -final_rad;
+        }
+        break;
+    }
+    // Rotation is mostly done by the time the body hits the ground
+    add_rotation(body, start_t, impact_t + 0.05f, pitch, roll);
+
+    float depth = slump ? rng_uniform(rng, 0.2f, 0.4f) : rng_uniform(rng, 0.6f, 0.9f);
+    add_freefall(body, start_t + 0.1f * fall_s, impact_t - 0.02f, depth);
+
+    float peak_g = slump ? rng_uniform(rng, 1.3f, 2.0f) : rng_uniform(rng, 2.5f, 6.0f);
+    float width = rng_uniform(rng, 0.04f, 0.10f);
+    add_impact(body, impact_t, width, peak_g);
+    // Rebound
+    add_impact(body, impact_t + width + rng_uniform(rng, 0.08f, 0.15f), width * 1.5f,
+               1.0f + (peak_g - 1.0f) * rng_uniform(rng, 0.1f, 0.25f));
+
+    add_sway(body, rng, impact_t + 1.0f, duration_s);
+    return impact_t;
+}
+
+// Sitting down hard: lean forward, drop onto the seat, lean back. Returns the
+// seat contact time.
+static float build_sitting(body_t *body, rng_t *rng, float duration_s)
+{
+    float contact_t = rng_uniform(rng, 0.4f, 0.55f) * duration_s;
+    float lean = rng_uniform(rng, 20.0f, 35.0f) * DEG_TO_RAD;
+    float seated = rng_uniform(rng, 5.0f, 15.0f) * DEG_TO_RAD;
+
+    if (rng_chance(rng, 0.5f)) {
+        add_gait(body, rng, 0.5f, contact_t - 1.2f, rng_uniform(rng, 1.7f, 2.1f), rng_uniform(rng, 0.3f, 0.6f));
+    }
+    add_sway(body, rng, 0.0f, duration_s);
+    add_rotation(body, contact_t - 1.0f, contact_t - 0.3f, lean, 0.0f);
+    add_rotation(body, contact_t - 0.1f, contact_t + 0.8f, seated - lean, 0.0f);
+    add_freefall(body, contact_t - 0.3f, contact_t - 0.02f, rng_uniform(rng, 0.2f, 0.4f));
+    add_impact(body, contact_t, rng_uniform(rng, 0.08f, 0.15f), rng_uniform(rng, 1.2f, 2.0f));
+    return contact_t;
+}
+
+// Two to four jumps on the spot. Returns the first landing.
+static float build_jumping(body_t *body, rng_t *rng, float duration_s)
+{
+    int jumps = 2 + (int)(rng_next(rng) % 3);
+    float t = rng_uniform(rng, 0.3f, 0.45f) * duration_s;
+    float first_landing = 0.0f;
+
+    add_sway(body, rng, 0.0f, duration_s);
+    for (int j = 0; j < jumps; j++) {
+        float push = rng_uniform(rng, 0.12f, 0.2f);
+        float flight = rng_uniform(rng, 0.3f, 0.45f);
+        add_impact(body, t + push * 0.5f, push, rng_uniform(rng, 1.5f, 2.2f));
+        add_freefall(body, t + push, t + push + flight, rng_uniform(rng, 0.85f, 0.98f));
+        float landing = t + push + flight;
+        add_impact(body, landing, rng_uniform(rng, 0.05f, 0.1f), rng_uniform(rng, 2.5f, 4.5f));
+        if (j == 0) {
+            first_landing = landing;
+        }
+        t = landing + rng_uniform(rng, 0.4f, 1.0f);
+    }
+    return first_landing;
+}
+
+// Walking (or walking down stairs) for most of the trace. Returns its start.
+static float build_gait(body_t *body, rng_t *rng, bool stairs, float duration_s)
+{
+    float start_t = rng_uniform(rng, 0.5f, 1.5f);
+    float hz = stairs ? rng_uniform(rng, 1.4f, 1.8f) : rng_uniform(rng, 1.7f, 2.1f);
+    float heel_g = stairs ? rng_uniform(rng, 0.6f, 1.2f) : rng_uniform(rng, 0.3f, 0.6f);
+    add_sway(body, rng, 0.0f, start_t);
+    add_gait(body, rng, start_t, duration_s - 0.5f, hz, heel_g);
+    if (stairs) {
+        // Looking down the stairs
+        add_rotation(body, start_t, start_t + 0.5f, rng_uniform(rng, 5.0f, 15.0f) * DEG_TO_RAD, 0.0f);
+    }
+    return start_t;
+}
+
+// Turn the body state into sensor samples
+static void render(const body_t *body, rng_t *rng, const corpus_config_t *config,
+                   std::vector<sensor_data_t> *out)
+{
+    out->resize(body->count);
+    float temp = rng_uniform(rng, 28.0f, 34.0f);
+
+    for (int i = 0; i < body->count; i++) {
+        float sp = sinf(body->pitch[i]), cp = cosf(body->pitch[i]);
+        float sr = sinf(body->roll[i]), cr = cosf(body->roll[i]);
+        // "Up" in the device frame
+        float ux = -sp, uy = sr * cp, uz = cr * cp;
+        float up = body->scale[i] * GRAVITY + body->up_force[i];
+
+        // Angular rates from the orientation change (central difference)
+        int prev = (i > 0) ? i - 1 : i;
+        int next = (i + 1 < body->count) ? i + 1 : i;
+        float dt = (float)(next - prev) / body->rate_hz;
+        float pitch_rate = (dt > 0.0f) ? (body->pitch[next] - body->pitch[prev]) / dt : 0.0f;
+        float roll_rate = (dt > 0.0f) ? (body->roll[next] - body->roll[prev]) / dt : 0.0f;
+
+        sensor_data_t *s = &(*out)[i];
+        s->accel_x = up * ux + body->forward_force[i] + config->accel_noise * rng_gauss(rng);
+        s->accel_y = up * uy + config->accel_noise * rng_gauss(rng);
+        s->accel_z = up * uz + config->accel_noise * rng_gauss(rng);
+        s->gyro_x = roll_rate + config->gyro_noise * rng_gauss(rng);
+        s->gyro_y = pitch_rate + config->gyro_noise * rng_gauss(rng);
+        s->gyro_z = config->gyro_noise * rng_gauss(rng);
+        s->temperature = temp + 0.05f * rng_gauss(rng);
+        s->timestamp = (uint32_t)((uint64_t)i * 1000 / body->rate_hz);
+    }
+}
+
+// ===== Public API =====
+
+void corpus_default_config(corpus_config_t *config)
+{
+    config->rate_hz = 100;
+    config->duration_s = 12.0f;
+    config->accel_noise = 0.1f;
+    config->gyro_noise = 0.01f;
+    config->traces_per_scenario = 40;
+    config->seed = 1;
+}
+
+const char *corpus_scenario_name(scenario_t scenario)
+{
+    return (scenario >= 0 && scenario < SCENARIO_COUNT) ? SCENARIO_NAMES[scenario] : "unknown";
+}
+
+bool corpus_scenario_is_fall(scenario_t scenario)
+{
+    return scenario <= SCENARIO_FALL_SLUMP;
+}
+
+void corpus_generate(const corpus_config_t *config, std::vector<corpus_trace_t> *out)
+{
+    int count = (int)(config->duration_s * config->rate_hz);
+    body_t body;
+    out->clear();
+
+    for (int s = 0; s < SCENARIO_COUNT; s++) {
+        scenario_t scenario = (scenario_t)s;
+        for (int n = 0; n < config->traces_per_scenario; n++) {
+            rng_t rng;
+            rng_seed(&rng, config->seed, (uint32_t)s, (uint32_t)n);
+            body_init(&body, count, config->rate_hz);
+
+            float event_t;
+            switch (scenario) {
+            case SCENARIO_ADL_SITTING: event_t = build_sitting(&body, &rng, config->duration_s); break;
+            case SCENARIO_ADL_JUMPING: event_t = build_jumping(&body, &rng, config->duration_s); break;
+            case SCENARIO_ADL_WALKING: event_t = build_gait(&body, &rng, false, config->duration_s); break;
+            case SCENARIO_ADL_STAIRS:  event_t = build_gait(&body, &rng, true, config->duration_s); break;
+            default:                   event_t = build_fall(&body, &rng, scenario, config->duration_s); break;
+            }
+
+            corpus_trace_t trace;
+            trace.scenario = scenario;
+            trace.is_fall = corpus_scenario_is_fall(scenario);
+            trace.event_ms = (uint32_t)(event_t * 1000.0f);
+            render(&body, &rng, config, &trace.samples);
+            out->push_back(std::move(trace));
+        }
+    }
+}
+
+bool corpus_write(const char *path, const std::vector<corpus_trace_t> &traces)
+{
+    FILE *f = fopen(path, "w");
+    if (f == NULL) {
+        return false;
+    }
+
+    fprintf(f, "%s traces=%zu\n", CORPUS_MAGIC, traces.size());
+    for (size_t t = 0; t < traces.size(); t++) {
+        const corpus_trace_t *trace = &traces[t];
+        fprintf(f, "trace,%zu,%s,%d,%lu,%zu\n", t, corpus_scenario_name(trace->scenario),
+                trace->is_fall ? 1 : 0, (unsigned long)trace->event_ms, trace->samples.size());
+        for (const sensor_data_t &s : trace->samples) {
+            fprintf(f, "%lu,%.4f,%.4f,%.4f,%.5f,%.5f,%.5f,%.2f\n", (unsigned long)s.timestamp,
+                    s.accel_x, s.accel_y, s.accel_z, s.gyro_x, s.gyro_y, s.gyro_z, s.temperature);
+        }
+    }
+
+    bool ok = !ferror(f);
+    fclose(f);
+    return ok;
+}
+
+bool corpus_read(const char *path, std::vector<corpus_trace_t> *out)
+{
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        return false;
+    }
+
+    out->clear();
+    char line[256];
+    bool ok = fgets(line, sizeof(line), f) != NULL &&
+              strncmp(line, CORPUS_MAGIC, strlen(CORPUS_MAGIC)) == 0;
+    corpus_trace_t *trace = NULL;
+    size_t expected = 0;
+
+    while (ok && fgets(line, sizeof(line), f) != NULL) {
+        if (line[0] == '#' || line[0] == '\n') {
+            continue;
+        }
+        if (strncmp(line, "trace,", 6) == 0) {
+            char name[32];
+            unsigned long index, event_ms;
+            int fall;
+            size_t count;
+            if (sscanf(line, "trace,%lu,%31[^,],%d,%lu,%zu", &index, name, &fall, &event_ms, &count) != 5) {
+                ok = false;
+                break;
+            }
+            if (trace != NULL && trace->samples.size() != expected) {
+                ok = false;
+                break;
+            }
+            corpus_trace_t next;
+            next.scenario = SCENARIO_COUNT;
+            for (int s = 0; s < SCENARIO_COUNT; s++) {
+                if (strcmp(name, SCENARIO_NAMES[s]) == 0) {
+                    next.scenario = (scenario_t)s;
+                }
+            }
+            if (next.scenario == SCENARIO_COUNT) {
+                ok = false;
+                break;
+            }
+            next.is_fall = fall != 0;
+            next.event_ms = (uint32_t)event_ms;
+            next.samples.reserve(count);
+            out->push_back(std::move(next));
+            trace = &out->back();
+            expected = count;
+            continue;
+        }
+
+        unsigned long timestamp;
+        sensor_data_t s;
+        if (trace == NULL ||
+            sscanf(line, "%lu,%f,%f,%f,%f,%f,%f,%f", &timestamp, &s.accel_x, &s.accel_y, &s.accel_z,
+                   &s.gyro_x, &s.gyro_y, &s.gyro_z, &s.temperature) != 8) {
+            ok = false;
+            break;
+        }
+        s.timestamp = (uint32_t)timestamp;
+        trace->samples.push_back(s);
+    }
+
+    if (ok && trace != NULL && trace->samples.size() != expected) {
+        ok = false;
+    }
+    fclose(f);
+    return ok;
+}
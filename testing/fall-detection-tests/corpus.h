@@ -0,0 +1,93 @@
+// Fall Corpus - Labeled synthetic sensor_data_t traces for detector evaluation
+// Each trace is a few seconds of one scenario: a fall (forward, backward,
+// lateral, slump) or an activity of daily living that a detector must not
+// report (sitting down, jumping, walking, descending stairs). Signals are
+// built in the wearable's frame (Z up when standing, X forward) from body
+// orientation, specific-force scale (free fall), impact/step pulses and
+// Gaussian sensor noise, with every shape parameter drawn per trace from a
+// seeded generator, so a corpus is reproducible from its configuration.
+
+#ifndef _CORPUS_H_
+#define _CORPUS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <vector>
+#include "protocol.h"
+
+// Scenarios
+typedef enum {
+    SCENARIO_FALL_FORWARD = 0,
+    SCENARIO_FALL_BACKWARD,
+    SCENARIO_FALL_LATERAL,
+    SCENARIO_FALL_SLUMP,        // Slow collapse, weak impact
+    SCENARIO_ADL_SITTING,       // Sitting down hard on a chair
+    SCENARIO_ADL_JUMPING,       // Two to four jumps
+    SCENARIO_ADL_WALKING,
+    SCENARIO_ADL_STAIRS,        // Walking down stairs
+    SCENARIO_COUNT
+} scenario_t;
+
+// Generation parameters
+typedef struct {
+    uint16_t rate_hz;               // Sample rate
+    float duration_s;               // Trace length
+    float accel_noise;              // Accelerometer noise (m/s^2, 1 sigma)
+    float gyro_noise;               // Gyro noise (rad/s, 1 sigma)
+    int traces_per_scenario;
+    uint32_t seed;
+} corpus_config_t;
+
+// One labeled trace
+typedef struct {
+    scenario_t scenario;
+    bool is_fall;
+    uint32_t event_ms;              // Impact (falls) or main event (ADL), sample clock
+    std::vector<sensor_data_t> samples;
+} corpus_trace_t;
+
+/**
+ * Default parameters (100 Hz, 12 s, 40 traces per scenario)
+ * @param config Parameters to fill in
+ */
+void corpus_default_config(corpus_config_t *config);
+
+/**
+ * Scenario name ("fall-forward", "adl-walking", ...)
+ * @param scenario Scenario
+ * @return Name
+ */
+const char *corpus_scenario_name(scenario_t scenario);
+
+/**
+ * Whether a scenario is a fall
+ * @param scenario Scenario
+ * @return true for SCENARIO_FALL_xxx
+ */
+bool corpus_scenario_is_fall(scenario_t scenario);
+
+/**
+ * Generate a corpus
+ * @param config Parameters
+ * @param out Traces (replaced)
+ */
+void corpus_generate(const corpus_config_t *config, std::vector<corpus_trace_t> *out);
+
+/**
+ * Write a corpus as CSV: a "trace,<index>,<scenario>,<fall>,<event_ms>,<samples>"
+ * line before each trace's "timestamp,ax,ay,az,gx,gy,gz,temp" lines
+ * @param path Output path
+ * @param traces Traces
+ * @return true if successful
+ */
+bool corpus_write(const char *path, const std::vector<corpus_trace_t> &traces);
+
+/**
+ * Read a corpus written by corpus_write()
+ * @param path Input path
+ * @param out Traces (replaced)
+ * @return true if successful
+ */
+bool corpus_read(const char *path, std::vector<corpus_trace_t> *out);
+
+#endif // _CORPUS_H_
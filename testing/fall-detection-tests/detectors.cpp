@@ -0,0 +1,208 @@
+// Fall Detectors - Benchmark adapters around the system's fall detectors
+#include "detectors.h"
+#include "fall_classifier.h"
+#include "fall_detector.h"
+#include "impact_capture.h"
+#include "common/burst_codec.h"
+#include <string.h>
+
+// ===== Hub threshold detector (communication-hub/beagleboard) =====
+
+// The daemon's built-in defaults (config.cpp)
+const hub_config_t DETECTOR_HUB_CONFIG = {
+    1.53f,   // fall_threshold_g
+    9.81f,   // normal_gravity
+    2.0f,    // recovery_margin
+    5000,    // suspect_timeout_ms
+    30,      // alert_timeout_s
+    10,      // sampling_rate_hz
+    40,      // heartrate_min
+    150,     // heartrate_max
+    0        // version
+};
+
+// Per-device state as the daemon keeps it
+typedef struct {
+    fall_detector_t fall;
+    orientation_t orientation;
+} threshold_state_t;
+
+static void threshold_init(void *state, uint16_t rate_hz)
+{
+    threshold_state_t *s = (threshold_state_t *)state;
+    (void)rate_hz;
+    fall_detector_init(&s->fall);
+    orientation_init(&s->orientation);
+}
+
+static bool threshold_process(void *state, const sensor_data_t *sample)
+{
+    threshold_state_t *s = (threshold_state_t *)state;
+    orientation_update(&s->orientation, sample);
+    fall_detector_process(&s->fall, sample, &s->orientation, &DETECTOR_HUB_CONFIG);
+    return s->fall.state >= STATE_FALL_SUSPECTED;
+}
+
+// ===== Hub threshold confirmed by the fall classifier (communication-hub/beagleboard) =====
+
+typedef struct {
+    fall_detector_t fall;
+    orientation_t orientation;
+    fall_event_t event;
+    bool confirmed;             // Last settled event was classified as a fall
+} classifier_state_t;
+
+static void classifier_init(void *state, uint16_t rate_hz)
+{
+    classifier_state_t *s = (classifier_state_t *)state;
+    (void)rate_hz;
+    fall_detector_init(&s->fall);
+    orientation_init(&s->orientation);
+    fall_event_init(&s->event);
+    s->confirmed = false;
+}
+
+static bool classifier_process(void *state, const sensor_data_t *sample)
+{
+    classifier_state_t *s = (classifier_state_t *)state;
+    orientation_update(&s->orientation, sample);
+    fall_detector_process(&s->fall, sample, &s->orientation, &DETECTOR_HUB_CONFIG);
+    if (fall_event_update(&s->event, sample, &s->fall, &s->orientation)) {
+        int8_t features[FALL_FEATURE_COUNT];
+        fall_classifier_quantize(s->event.features, features);
+        s->confirmed = fall_classifier_is_fall(fall_classifier_score(features));
+    }
+    return s->confirmed;
+}
+
+// ===== Hub as deployed: 10 Hz stream plus impact burst replay =====
+// The wearable samples at the corpus rate but streams SENSOR_DATA every
+// STREAM_INTERVAL_MS (activity_gate.cpp); its impact capture sends the
+// full-rate window, which the daemon decodes and replays (handle_burst()).
+// Either path's classification can confirm, and a window whose event never
+// settles counts as an alarm because the daemon escalates its report.
+
+typedef struct {
+    classifier_state_t stream;  // Daemon's stream path
+    uint32_t next_stream_ms;
+    impact_capture_t capture;   // Wearable trigger and burst
+    fall_replay_t replay;
+    bool burst_fall;            // Last replayed window was classified as a fall
+} hub_state_t;
+
+static void hub_init(void *state, uint16_t rate_hz)
+{
+    hub_state_t *s = (hub_state_t *)state;
+    classifier_init(&s->stream, rate_hz);
+    s->next_stream_ms = 0;
+    impact_capture_init(&s->capture, NULL, rate_hz);
+    s->burst_fall = false;
+}
+
+bool detector_replay_burst(impact_capture_t *cap, fall_replay_t *replay)
+{
+    fall_detected_t report;
+    impact_burst_t chunk;
+    int16_t samples[255][IMPACT_BURST_CHANNELS];
+    impact_capture_take_report(cap, &report);
+    fall_replay_init(replay);
+
+    size_t len;
+    while ((len = impact_capture_next_chunk(cap, &chunk)) > 0) {
+        int count = burst_decode(&chunk, len, samples, 255);
+        for (int i = 0; i < count; i++) {
+            float accel[3], gyro[3];
+            burst_dequantize(samples[i], accel, gyro);
+            fall_replay_update(replay, chunk.first_index + i, chunk.rate_hz, accel, gyro,
+                               &DETECTOR_HUB_CONFIG);
+        }
+    }
+    fall_replay_finish(replay);
+    return replay->done;
+}
+
+// Replay the window; a report that is never classified is escalated
+static bool replay_burst(hub_state_t *s)
+{
+    if (!detector_replay_burst(&s->capture, &s->replay)) {
+        return true;
+    }
+    int8_t features[FALL_FEATURE_COUNT];
+    fall_classifier_quantize(s->replay.event.features, features);
+    return fall_classifier_is_fall(fall_classifier_score(features));
+}
+
+static bool hub_process(void *state, const sensor_data_t *sample)
+{
+    hub_state_t *s = (hub_state_t *)state;
+    if (sample->timestamp >= s->next_stream_ms) {
+        s->next_stream_ms = sample->timestamp + STREAM_INTERVAL_MS;
+        classifier_process(&s->stream, sample);
+    }
+
+    mpu6050_sample_t m;
+    m.accel.x = sample->accel_x;
+    m.accel.y = sample->accel_y;
+    m.accel.z = sample->accel_z;
+    m.gyro.x = sample->gyro_x;
+    m.gyro.y = sample->gyro_y;
+    m.gyro.z = sample->gyro_z;
+    m.temp.celsius = sample->temperature;
+    if (impact_capture_update(&s->capture, &m, sample->timestamp)) {
+        s->burst_fall = replay_burst(s);
+    }
+    return s->stream.confirmed || s->burst_fall;
+}
+
+// ===== Wearable impact capture (wearable-sensor-module) =====
+
+static void impact_init(void *state, uint16_t rate_hz)
+{
+    impact_capture_init((impact_capture_t *)state, NULL, rate_hz);
+}
+
+static bool impact_process(void *state, const sensor_data_t *sample)
+{
+    impact_capture_t *cap = (impact_capture_t *)state;
+    mpu6050_sample_t s;
+    s.accel.x = sample->accel_x;
+    s.accel.y = sample->accel_y;
+    s.accel.z = sample->accel_z;
+    s.gyro.x = sample->gyro_x;
+    s.gyro.y = sample->gyro_y;
+    s.gyro.z = sample->gyro_z;
+    s.temp.celsius = sample->temperature;
+
+    bool alarming = cap->state != IMPACT_ARMED;
+    if (impact_capture_update(cap, &s, sample->timestamp)) {
+        // Hand out the report and burst as the firmware would, which re-arms
+        fall_detected_t report;
+        impact_burst_t chunk;
+        impact_capture_take_report(cap, &report);
+        while (impact_capture_next_chunk(cap, &chunk) > 0) {
+        }
+    }
+    return alarming || cap->state != IMPACT_ARMED;
+}
+
+const detector_adapter_t DETECTORS[] = {
+    { "threshold", "Hub |a| threshold with orientation (fall_detector.cpp, default config)",
+      sizeof(threshold_state_t), threshold_init, threshold_process },
+    { "classifier", "Hub threshold events confirmed by the tree ensemble (fall_classifier.cpp)",
+      sizeof(classifier_state_t), classifier_init, classifier_process },
+    { "impact", "Wearable impact capture trigger (impact_capture.cpp, 2.5 g)",
+      sizeof(impact_capture_t), impact_init, impact_process },
+    { "hub", "Daemon as deployed: 10 Hz stream classifier plus full-rate impact burst replay",
+      sizeof(hub_state_t), hub_init, hub_process },
+};
+const int DETECTOR_COUNT = (int)(sizeof(DETECTORS) / sizeof(DETECTORS[0]));
+
+const detector_adapter_t *detector_find(const char *name)
+{
+    for (int i = 0; i < DETECTOR_COUNT; i++) {
+        if (strcmp(DETECTORS[i].name, name) == 0) {
+            return &DETECTORS[i];
+        }
+    }
+    return NULL;
+}
@@ -0,0 +1,51 @@
+// Fall Detectors - Benchmark adapters around the system's fall detectors
+// An adapter wraps one detector behind a common per-trace interface: reset
+// state, then feed samples and report whether the detector is raising an
+// alarm. Adding a detector to the benchmark means writing an adapter and
+// listing it in DETECTORS.
+
+#ifndef _DETECTORS_H_
+#define _DETECTORS_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "protocol.h"
+#include "config.h"
+#include "fall_classifier.h"
+#include "impact_capture.h"
+
+// Wearable SENSOR_DATA interval while streaming (activity_gate.cpp, 10 Hz)
+#define STREAM_INTERVAL_MS 100
+
+typedef struct {
+    const char *name;
+    const char *description;
+    size_t state_size;                                      // Bytes of per-trace state
+    void (*init)(void *state, uint16_t rate_hz);
+    bool (*process)(void *state, const sensor_data_t *sample);  // true while alarming
+} detector_adapter_t;
+
+// The daemon's built-in configuration (config.cpp), used by the hub adapters
+extern const hub_config_t DETECTOR_HUB_CONFIG;
+
+// Registered adapters
+extern const detector_adapter_t DETECTORS[];
+extern const int DETECTOR_COUNT;
+
+/**
+ * Hand out a completed capture's report and burst, then decode, dequantize
+ * and replay every chunk through the hub's burst replay, as the daemon does
+ * @param cap Capture that has just completed a window
+ * @param replay Replay state (reset here)
+ * @return true if the window produced an event summary (replay->event.features)
+ */
+bool detector_replay_burst(impact_capture_t *cap, fall_replay_t *replay);
+
+/**
+ * Find an adapter by name
+ * @param name Adapter name
+ * @return Adapter, or NULL if unknown
+ */
+const detector_adapter_t *detector_find(const char *name);
+
+#endif // _DETECTORS_H_
@@ -0,0 +1,251 @@
+// Fall Detection Benchmark - Sensitivity, specificity, latency and throughput
+// Runs detector adapters (detectors.h) over a labeled corpus, either read from
+// a fallgen file or generated in memory, and reports per scenario:
+//   - falls: detected when an alarm starts between 1 s before and 3 s after
+//     the impact; latency is from the impact to that alarm
+//   - ADL: a false alarm when any alarm starts
+// Sensitivity is detected falls / falls and specificity is ADL traces without
+// an alarm / ADL traces. Alarms on fall traces outside the detection window
+// are counted separately. Throughput is single-threaded samples per second,
+// i.e. per core, with detector state reset per trace as in the daemon.
+//
+// Build (from this directory):
+//   g++ -std=c++17 -O2 -I../../protocol -I../../common/include
+//       -I../../communication-hub/beagleboard/include
+//       -I../../wearable-sensor-module/src -I../../wearable-sensor-module/hal/include
+//       fallbench.cpp corpus.cpp detectors.cpp
+//       ../../communication-hub/beagleboard/src/fall_detector.cpp
+//       ../../communication-hub/beagleboard/src/orientation.cpp
+//       ../../wearable-sensor-module/src/impact_capture.cpp
+//       ../../common/src/burst_codec.cpp -o fallbench
+// Usage: fallbench [-c corpus.csv] [-D detector] [-r rate_hz] [-n traces_per_scenario]
+//                  [-a accel_noise] [-g gyro_noise] [-s seed]
+//        Without -D every registered detector is run.
+
+#include "corpus.h"
+#include "detectors.h"
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Fall detection window around the impact
+#define WINDOW_BEFORE_MS 1000
+#define WINDOW_AFTER_MS 3000
+
+// Minimum wall time per throughput measurement
+#define THROUGHPUT_MIN_S 0.5
+
+typedef struct {
+    int traces;
+    int hits;                       // Falls detected / ADL traces with an alarm
+    int other_alarms;               // Fall traces: alarms outside the window
+    std::vector<int> latencies_ms;  // Falls: detection latency
+} scenario_result_t;
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Run one trace; fills alarm start times (ms)
+static void run_trace(const detector_adapter_t *det, void *state, uint16_t rate_hz,
+                      const corpus_trace_t *trace, std::vector<uint32_t> *onsets)
+{
+    det->init(state, rate_hz);
+    onsets->clear();
+    bool alarming = false;
+    for (const sensor_data_t &s : trace->samples) {
+        bool now = det->process(state, &s);
+        if (now && !alarming) {
+            onsets->push_back(s.timestamp);
+        }
+        alarming = now;
+    }
+}
+
+static void evaluate(const detector_adapter_t *det, const std::vector<corpus_trace_t> &traces,
+                     uint16_t rate_hz, size_t total_samples)
+{
+    std::vector<unsigned char> state(det->state_size);
+    std::vector<uint32_t> onsets;
+    scenario_result_t results[SCENARIO_COUNT];
+    for (int s = 0; s < SCENARIO_COUNT; s++) {
+        results[s].traces = 0;
+        results[s].hits = 0;
+        results[s].other_alarms = 0;
+    }
+
+    for (const corpus_trace_t &trace : traces) {
+        scenario_result_t *r = &results[trace.scenario];
+        r->traces++;
+        run_trace(det, state.data(), rate_hz, &trace, &onsets);
+
+        if (!trace.is_fall) {
+            if (!onsets.empty()) {
+                r->hits++;
+            }
+            continue;
+        }
+        bool detected = false;
+        for (uint32_t t : onsets) {
+            int64_t offset = (int64_t)t - (int64_t)trace.event_ms;
+            if (!detected && offset >= -WINDOW_BEFORE_MS && offset <= WINDOW_AFTER_MS) {
+                detected = true;
+                r->latencies_ms.push_back((int)offset);
+            } else {
+                r->other_alarms++;
+            }
+        }
+        if (detected) {
+            r->hits++;
+        }
+    }
+
+    printf("\nFallBench - Detector '%s': %s\n", det->name, det->description);
+    printf("  %-14s %6s %9s %7s %8s %8s %8s\n", "scenario", "traces", "result", "other", "lat-mean", "lat-p50", "lat-max");
+
+    int falls = 0, detected = 0, adl = 0, false_alarms = 0, other = 0;
+    std::vector<int> all_latencies;
+    for (int s = 0; s < SCENARIO_COUNT; s++) {
+        scenario_result_t *r = &results[s];
+        if (r->traces == 0) {
+            continue;
+        }
+        bool fall = corpus_scenario_is_fall((scenario_t)s);
+        char result[32];
+        snprintf(result, sizeof(result), "%5.1f%% %s", 100.0 * r->hits / r->traces, fall ? "det" : "FA ");
+        if (fall && !r->latencies_ms.empty()) {
+            std::vector<int> lat = r->latencies_ms;
+            std::sort(lat.begin(), lat.end());
+            double sum = 0.0;
+            for (int v : lat) {
+                sum += v;
+            }
+            printf("  %-14s %6d %9s %7d %6.0fms %6dms %6dms\n", corpus_scenario_name((scenario_t)s),
+                   r->traces, result, r->other_alarms, sum / lat.size(), lat[lat.size() / 2], lat.back());
+            all_latencies.insert(all_latencies.end(), lat.begin(), lat.end());
+        } else {
+            printf("  %-14s %6d %9s %7s %8s %8s %8s\n", corpus_scenario_name((scenario_t)s),
+                   r->traces, result, fall ? "0" : "-", "-", "-", "-");
+        }
+        if (fall) {
+            falls += r->traces;
+            detected += r->hits;
+            other += r->other_alarms;
+        } else {
+            adl += r->traces;
+            false_alarms += r->hits;
+        }
+    }
+
+    printf("  Sensitivity: %.1f%% (%d/%d)   Specificity: %.1f%% (%d/%d)   Off-window alarms on falls: %d\n",
+           falls > 0 ? 100.0 * detected / falls : 0.0, detected, falls,
+           adl > 0 ? 100.0 * (adl - false_alarms) / adl : 0.0, adl - false_alarms, adl, other);
+    if (!all_latencies.empty()) {
+        std::sort(all_latencies.begin(), all_latencies.end());
+        printf("  Latency: p50 %d ms, p95 %d ms, max %d ms\n",
+               all_latencies[all_latencies.size() / 2],
+               all_latencies[all_latencies.size() * 95 / 100], all_latencies.back());
+    }
+
+    // Throughput: whole corpus, repeated until the measurement is long enough
+    unsigned alarm_samples = 0;     // Keeps the work observable
+    int passes = 0;
+    double start = now_s(), elapsed;
+    do {
+        for (const corpus_trace_t &trace : traces) {
+            det->init(state.data(), rate_hz);
+            for (const sensor_data_t &s : trace.samples) {
+                alarm_samples += det->process(state.data(), &s) ? 1 : 0;
+            }
+        }
+        passes++;
+        elapsed = now_s() - start;
+    } while (elapsed < THROUGHPUT_MIN_S);
+    double rate = (double)total_samples * passes / elapsed;
+    printf("  Throughput: %.2f M samples/s per core (%.1f ns/sample, %d passes, %u alarm samples/pass)\n",
+           rate / 1e6, 1e9 / rate, passes, alarm_samples / passes);
+}
+
+int main(int argc, char *argv[])
+{
+    corpus_config_t config;
+    corpus_default_config(&config);
+    const char *corpus_path = NULL;
+    const char *detector_name = NULL;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const char *value = argv[i + 1];
+        if (strcmp(argv[i], "-c") == 0) {
+            corpus_path = value;
+        } else if (strcmp(argv[i], "-D") == 0) {
+            detector_name = value;
+        } else if (strcmp(argv[i], "-r") == 0) {
+            config.rate_hz = (uint16_t)atoi(value);
+        } else if (strcmp(argv[i], "-n") == 0) {
+            config.traces_per_scenario = atoi(value);
+        } else if (strcmp(argv[i], "-a") == 0) {
+            config.accel_noise = (float)atof(value);
+        } else if (strcmp(argv[i], "-g") == 0) {
+            config.gyro_noise = (float)atof(value);
+        } else if (strcmp(argv[i], "-s") == 0) {
+            config.seed = (uint32_t)strtoul(value, NULL, 0);
+        } else {
+            fprintf(stderr, "Usage: %s [-c corpus.csv] [-D detector] [-r rate_hz] [-n traces_per_scenario]\n"
+                            "       [-a accel_noise] [-g gyro_noise] [-s seed]\n", argv[0]);
+            return 1;
+        }
+    }
+    if ((argc - 1) % 2 != 0) {
+        fprintf(stderr, "FallBench - Option %s needs a value\n", argv[argc - 1]);
+        return 1;
+    }
+
+    std::vector<corpus_trace_t> traces;
+    if (corpus_path != NULL) {
+        if (!corpus_read(corpus_path, &traces) || traces.empty()) {
+            fprintf(stderr, "FallBench - Cannot read corpus %s\n", corpus_path);
+            return 1;
+        }
+        // Rate from the sample spacing of the first trace
+        const std::vector<sensor_data_t> &s = traces[0].samples;
+        if (s.size() >= 2 && s.back().timestamp > s.front().timestamp) {
+            config.rate_hz = (uint16_t)((s.size() - 1) * 1000.0 / (s.back().timestamp - s.front().timestamp) + 0.5);
+        }
+    } else {
+        if (config.rate_hz == 0 || config.traces_per_scenario <= 0) {
+            fprintf(stderr, "FallBench - Need rate > 0 and traces > 0\n");
+            return 1;
+        }
+        corpus_generate(&config, &traces);
+    }
+
+    size_t total_samples = 0;
+    for (const corpus_trace_t &trace : traces) {
+        total_samples += trace.samples.size();
+    }
+    printf("FallBench - %zu traces, %zu samples at %u Hz (%s)\n", traces.size(), total_samples,
+           config.rate_hz, corpus_path != NULL ? corpus_path : "generated");
+
+    if (detector_name != NULL) {
+        const detector_adapter_t *det = detector_find(detector_name);
+        if (det == NULL) {
+            fprintf(stderr, "FallBench - Unknown detector '%s'; available:", detector_name);
+            for (int i = 0; i < DETECTOR_COUNT; i++) {
+                fprintf(stderr, " %s", DETECTORS[i].name);
+            }
+            fprintf(stderr, "\n");
+            return 1;
+        }
+        evaluate(det, traces, config.rate_hz, total_samples);
+    } else {
+        for (int i = 0; i < DETECTOR_COUNT; i++) {
+            evaluate(&DETECTORS[i], traces, config.rate_hz, total_samples);
+        }
+    }
+    return 0;
+}
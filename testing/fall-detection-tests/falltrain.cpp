@@ -0,0 +1,550 @@
+// Fall Classifier Trainer - Fits the hub's fall_model.h on a synthetic corpus
+// Runs every trace of a training corpus through the daemon's chain
+// (orientation filter, threshold fall detector, fall_event_t) three ways, as
+// the hub sees it: at the corpus rate, on the 10 Hz SENSOR_DATA stream, and as
+// the replay of each wearable impact burst. Each settled event is labeled a
+// fall when it overlaps the detection window of a fall trace (1 s before to
+// 3 s after the impact, as in fallbench), otherwise not. The
+// features are quantized to int8 over the central 99% of the training range,
+// then gradient boosting with logistic loss grows oblivious trees level by
+// level (one feature/threshold per level, picked from 256-bin histograms).
+// Leaves are rounded to int8 as the tree is added, so training sees exactly
+// the scores the hub will compute. Falls can be weighted above other events
+// because a missed fall costs more than a false alarm.
+//
+// A validation corpus (the next seed) is scored with the written tables, and
+// the inference cost per event is measured one event at a time and batched.
+// The default seed differs from fallbench's, so fallbench reports held-out
+// results for the "classifier" detector.
+//
+// Build (from this directory):
+//   g++ -std=c++17 -O2 -I../../protocol -I../../common/include
+//       -I../../communication-hub/beagleboard/include
+//       -I../../wearable-sensor-module/src -I../../wearable-sensor-module/hal/include
+//       falltrain.cpp corpus.cpp detectors.cpp
+//       ../../communication-hub/beagleboard/src/fall_classifier.cpp
+//       ../../communication-hub/beagleboard/src/fall_detector.cpp
+//       ../../communication-hub/beagleboard/src/orientation.cpp
+//       ../../wearable-sensor-module/src/impact_capture.cpp
+//       ../../common/src/burst_codec.cpp -o falltrain
+// Usage: falltrain [-o fall_model.h] [-t trees] [-w fall_weight] [-r rate_hz]
+//                  [-n traces_per_scenario] [-s seed]
+//        Rebuild fallbench and the daemon after writing a new model.
+
+#include "corpus.h"
+#include "detectors.h"
+#include "fall_classifier.h"
+#include <algorithm>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static const char *DEFAULT_OUTPUT = "../../communication-hub/beagleboard/include/fall_model.h";
+
+// Same window as fallbench
+#define WINDOW_BEFORE_MS 1000
+#define WINDOW_AFTER_MS 3000
+
+#define TREE_DEPTH 4
+#define LEAVES (1 << TREE_DEPTH)
+#define MAX_TREES 64
+#define LEAF_SCALE 16.0f        // Leaf units per unit of log-odds
+#define LEARNING_RATE 0.3
+#define L2_REGULARIZATION 1.0
+#define QUANT_TAIL 0.005        // Fraction of events saturating at each end
+
+typedef struct {
+    float raw[FALL_FEATURE_COUNT];
+    int8_t q[FALL_FEATURE_COUNT];
+    bool fall;
+    scenario_t scenario;
+} event_sample_t;
+
+typedef struct {
+    float offset[FALL_FEATURE_COUNT];
+    float scale[FALL_FEATURE_COUNT];
+    int trees;
+    uint8_t feature[MAX_TREES][TREE_DEPTH];
+    int8_t threshold[MAX_TREES][TREE_DEPTH];
+    int8_t leaf[MAX_TREES][LEAVES];
+    int32_t bias;
+} model_t;
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// ===== Events =====
+
+typedef struct {
+    fall_detector_t det;
+    orientation_t orient;
+    fall_event_t ev;
+} event_chain_t;
+
+static void chain_init(event_chain_t *c)
+{
+    fall_detector_init(&c->det);
+    orientation_init(&c->orient);
+    fall_event_init(&c->ev);
+}
+
+static bool chain_update(event_chain_t *c, const sensor_data_t *s)
+{
+    orientation_update(&c->orient, s);
+    fall_detector_process(&c->det, s, &c->orient, &DETECTOR_HUB_CONFIG);
+    return fall_event_update(&c->ev, s, &c->det, &c->orient);
+}
+
+static void push_event(const float *features, const corpus_trace_t &trace, bool fall,
+                       std::vector<event_sample_t> *out)
+{
+    event_sample_t e;
+    memcpy(e.raw, features, sizeof(e.raw));
+    e.scenario = trace.scenario;
+    e.fall = trace.is_fall && fall;
+    out->push_back(e);
+}
+
+static bool in_window(const corpus_trace_t &trace, int64_t start_ms, int64_t end_ms)
+{
+    return start_ms <= (int64_t)trace.event_ms + WINDOW_AFTER_MS &&
+           end_ms >= (int64_t)trace.event_ms - WINDOW_BEFORE_MS;
+}
+
+// Every event the hub classifies: the full-rate chain, the same chain on the
+// 10 Hz SENSOR_DATA stream, and the replay of each wearable impact burst
+static void extract_events(const std::vector<corpus_trace_t> &traces, uint16_t rate_hz,
+                           std::vector<event_sample_t> *out)
+{
+    event_chain_t full, stream;
+    static impact_capture_t capture;
+    fall_replay_t replay;
+    out->clear();
+    for (const corpus_trace_t &trace : traces) {
+        chain_init(&full);
+        chain_init(&stream);
+        impact_capture_init(&capture, NULL, rate_hz);
+        uint32_t next_stream_ms = 0;
+        for (const sensor_data_t &s : trace.samples) {
+            if (chain_update(&full, &s)) {
+                push_event(full.ev.features, trace, in_window(trace, full.ev.start_ms, full.ev.end_ms), out);
+            }
+            if (s.timestamp >= next_stream_ms) {
+                next_stream_ms = s.timestamp + STREAM_INTERVAL_MS;
+                if (chain_update(&stream, &s)) {
+                    push_event(stream.ev.features, trace,
+                               in_window(trace, stream.ev.start_ms, stream.ev.end_ms), out);
+                }
+            }
+
+            mpu6050_sample_t m;
+            m.accel.x = s.accel_x;
+            m.accel.y = s.accel_y;
+            m.accel.z = s.accel_z;
+            m.gyro.x = s.gyro_x;
+            m.gyro.y = s.gyro_y;
+            m.gyro.z = s.gyro_z;
+            m.temp.celsius = s.temperature;
+            if (impact_capture_update(&capture, &m, s.timestamp) &&
+                detector_replay_burst(&capture, &replay)) {
+                // The window completes its post-impact time after the impact
+                push_event(replay.event.features, trace, in_window(trace, s.timestamp, s.timestamp), out);
+            }
+        }
+    }
+}
+
+// Round a constant to what the generated header will hold
+static float as_written(float v)
+{
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.6g", v);
+    return strtof(buf, NULL);
+}
+
+static void fit_quantization(model_t *m, const std::vector<event_sample_t> &events)
+{
+    std::vector<float> values(events.size());
+    for (int f = 0; f < FALL_FEATURE_COUNT; f++) {
+        for (size_t i = 0; i < events.size(); i++) {
+            values[i] = events[i].raw[f];
+        }
+        std::sort(values.begin(), values.end());
+        size_t tail = (size_t)(values.size() * QUANT_TAIL);
+        float lo = values[tail], hi = values[values.size() - 1 - tail];
+        float half = (hi - lo) * 0.5f;
+        m->offset[f] = as_written(lo + half);
+        m->scale[f] = as_written(127.0f / (half > 1e-6f ? half : 1e-6f));
+    }
+}
+
+static void quantize_events(const model_t *m, std::vector<event_sample_t> *events)
+{
+    for (event_sample_t &e : *events) {
+        for (int f = 0; f < FALL_FEATURE_COUNT; f++) {
+            e.q[f] = fall_classifier_quantize_value(e.raw[f], m->offset[f], m->scale[f]);
+        }
+    }
+}
+
+// ===== Boosting =====
+
+static int leaf_index(const model_t *m, int tree, const int8_t *q)
+{
+    int leaf = 0;
+    for (int d = 0; d < TREE_DEPTH; d++) {
+        leaf |= (q[m->feature[tree][d]] > m->threshold[tree][d]) << d;
+    }
+    return leaf;
+}
+
+static int32_t model_score(const model_t *m, const int8_t *q)
+{
+    int32_t score = m->bias;
+    for (int t = 0; t < m->trees; t++) {
+        score += m->leaf[t][leaf_index(m, t, q)];
+    }
+    return score;
+}
+
+static void train(model_t *m, const std::vector<event_sample_t> &events, int trees, double fall_weight)
+{
+    size_t n = events.size();
+    std::vector<double> weight(n), score(n), grad(n), hess(n);
+    std::vector<int> node(n);
+    double w_fall = 0.0, w_other = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        weight[i] = events[i].fall ? fall_weight : 1.0;
+        (events[i].fall ? w_fall : w_other) += weight[i];
+    }
+    // Balance the classes, then apply the fall weight
+    for (size_t i = 0; i < n; i++) {
+        weight[i] *= events[i].fall ? 0.5 * n / w_fall * fall_weight : 0.5 * n / w_other;
+        weight[i] /= events[i].fall ? fall_weight : 1.0;
+    }
+    m->bias = 0;
+    m->trees = 0;
+    for (size_t i = 0; i < n; i++) {
+        score[i] = 0.0;
+    }
+
+    static double g_hist[LEAVES][256], h_hist[LEAVES][256];
+    for (int t = 0; t < trees; t++) {
+        for (size_t i = 0; i < n; i++) {
+            double p = 1.0 / (1.0 + exp(-score[i]));
+            double y = events[i].fall ? 1.0 : 0.0;
+            grad[i] = weight[i] * (p - y);
+            hess[i] = weight[i] * std::max(p * (1.0 - p), 1e-6);
+            node[i] = 0;
+        }
+
+        for (int d = 0; d < TREE_DEPTH; d++) {
+            int leaves = 1 << d;
+            double best_gain = -1.0;
+            int best_feature = 0, best_threshold = 127;
+            for (int f = 0; f < FALL_FEATURE_COUNT; f++) {
+                memset(g_hist, 0, sizeof(g_hist));
+                memset(h_hist, 0, sizeof(h_hist));
+                for (size_t i = 0; i < n; i++) {
+                    g_hist[node[i]][events[i].q[f] + 128] += grad[i];
+                    h_hist[node[i]][events[i].q[f] + 128] += hess[i];
+                }
+                double g_total[LEAVES], h_total[LEAVES], g_left[LEAVES], h_left[LEAVES];
+                for (int l = 0; l < leaves; l++) {
+                    g_total[l] = h_total[l] = g_left[l] = h_left[l] = 0.0;
+                    for (int b = 0; b < 256; b++) {
+                        g_total[l] += g_hist[l][b];
+                        h_total[l] += h_hist[l][b];
+                    }
+                }
+                // Left: q <= threshold
+                for (int b = 0; b < 255; b++) {
+                    double gain = 0.0;
+                    for (int l = 0; l < leaves; l++) {
+                        g_left[l] += g_hist[l][b];
+                        h_left[l] += h_hist[l][b];
+                        double g_right = g_total[l] - g_left[l], h_right = h_total[l] - h_left[l];
+                        gain += g_left[l] * g_left[l] / (h_left[l] + L2_REGULARIZATION) +
+                                g_right * g_right / (h_right + L2_REGULARIZATION);
+                    }
+                    if (gain > best_gain) {
+                        best_gain = gain;
+                        best_feature = f;
+                        best_threshold = b - 128;
+                    }
+                }
+            }
+            m->feature[t][d] = (uint8_t)best_feature;
+            m->threshold[t][d] = (int8_t)best_threshold;
+            for (size_t i = 0; i < n; i++) {
+                node[i] |= (events[i].q[best_feature] > best_threshold) << d;
+            }
+        }
+
+        double g_leaf[LEAVES] = { 0 }, h_leaf[LEAVES] = { 0 };
+        for (size_t i = 0; i < n; i++) {
+            g_leaf[node[i]] += grad[i];
+            h_leaf[node[i]] += hess[i];
+        }
+        for (int l = 0; l < LEAVES; l++) {
+            double value = -g_leaf[l] / (h_leaf[l] + L2_REGULARIZATION) * LEARNING_RATE;
+            double units = std::min(127.0, std::max(-127.0, round(value * LEAF_SCALE)));
+            m->leaf[t][l] = (int8_t)units;
+        }
+        for (size_t i = 0; i < n; i++) {
+            score[i] += m->leaf[t][node[i]] / LEAF_SCALE;
+        }
+        m->trees = t + 1;
+    }
+}
+
+// ===== Reporting =====
+
+typedef struct {
+    int falls, falls_confirmed;
+    int others, others_rejected;
+} event_result_t;
+
+static event_result_t evaluate(const model_t *m, const std::vector<event_sample_t> &events,
+                               event_result_t per_scenario[SCENARIO_COUNT])
+{
+    event_result_t total;
+    memset(&total, 0, sizeof(total));
+    memset(per_scenario, 0, sizeof(event_result_t) * SCENARIO_COUNT);
+    for (const event_sample_t &e : events) {
+        bool fall = model_score(m, e.q) > 0;
+        event_result_t *r = &per_scenario[e.scenario];
+        if (e.fall) {
+            r->falls++;
+            r->falls_confirmed += fall;
+        } else {
+            r->others++;
+            r->others_rejected += !fall;
+        }
+    }
+    for (int s = 0; s < SCENARIO_COUNT; s++) {
+        total.falls += per_scenario[s].falls;
+        total.falls_confirmed += per_scenario[s].falls_confirmed;
+        total.others += per_scenario[s].others;
+        total.others_rejected += per_scenario[s].others_rejected;
+    }
+    return total;
+}
+
+static void print_results(const char *name, const model_t *m, const std::vector<event_sample_t> &events)
+{
+    event_result_t per_scenario[SCENARIO_COUNT];
+    event_result_t total = evaluate(m, events, per_scenario);
+    printf("\nFallTrain - %s: %zu events\n", name, events.size());
+    printf("  %-14s %14s %16s\n", "scenario", "falls conf.", "others rejected");
+    for (int s = 0; s < SCENARIO_COUNT; s++) {
+        const event_result_t *r = &per_scenario[s];
+        printf("  %-14s %6d / %-5d %7d / %-6d\n", corpus_scenario_name((scenario_t)s),
+               r->falls_confirmed, r->falls, r->others_rejected, r->others);
+    }
+    printf("  Falls confirmed: %.1f%%   Other events rejected: %.1f%%\n",
+           total.falls ? 100.0 * total.falls_confirmed / total.falls : 0.0,
+           total.others ? 100.0 * total.others_rejected / total.others : 0.0);
+}
+
+// ns per event with the shipped inference code (the tables compiled into this binary)
+static void measure_inference(const std::vector<event_sample_t> &events)
+{
+    std::vector<int8_t> q(events.size() * FALL_FEATURE_COUNT);
+    for (size_t i = 0; i < events.size(); i++) {
+        fall_classifier_quantize(events[i].raw, &q[i * FALL_FEATURE_COUNT]);
+    }
+
+    volatile int32_t sink = 0;
+    size_t scored = 0;
+    double start = now_s(), elapsed;
+    do {
+        for (size_t i = 0; i < events.size(); i++) {
+            sink = sink + fall_classifier_score(&q[i * FALL_FEATURE_COUNT]);
+        }
+        scored += events.size();
+        elapsed = now_s() - start;
+    } while (elapsed < 0.3);
+    double single_ns = elapsed * 1e9 / scored;
+
+    fall_batch_t batch;
+    int32_t scores[FALL_CLASSIFIER_BATCH_MAX];
+    scored = 0;
+    start = now_s();
+    do {
+        for (size_t i = 0; i < events.size(); i += FALL_CLASSIFIER_BATCH_MAX) {
+            fall_classifier_batch_init(&batch);
+            for (size_t j = i; j < events.size() && j < i + FALL_CLASSIFIER_BATCH_MAX; j++) {
+                fall_classifier_batch_add(&batch, events[j].raw);
+            }
+            fall_classifier_batch_score(&batch, scores);
+            sink = sink + scores[0];
+            scored += batch.count;
+        }
+        elapsed = now_s() - start;
+    } while (elapsed < 0.3);
+    double batch_ns = elapsed * 1e9 / scored;
+    (void)sink;
+
+    printf("\nFallTrain - Inference with the compiled-in model: %.1f ns/event single, "
+           "%.1f ns/event in batches of %d (including quantization)\n",
+           single_ns, batch_ns, FALL_CLASSIFIER_BATCH_MAX);
+}
+
+// ===== Output =====
+
+static bool write_model(const char *path, const model_t *m, const corpus_config_t *config,
+                        double fall_weight, const std::vector<event_sample_t> &validation)
+{
+    FILE *fp = fopen(path, "w");
+    if (fp == NULL) {
+        return false;
+    }
+    event_result_t per_scenario[SCENARIO_COUNT];
+    event_result_t v = evaluate(m, validation, per_scenario);
+
+    fprintf(fp, "// Fall Model - Tables for the fall classifier (fall_classifier.h)\n");
+    fprintf(fp, "// Generated by testing/fall-detection-tests/falltrain; do not edit.\n");
+    fprintf(fp, "// Corpus: %u Hz, %d traces per scenario, seed %lu (events at that rate, on\n",
+            config->rate_hz, config->traces_per_scenario, (unsigned long)config->seed);
+    fprintf(fp, "// the %d ms stream and from impact bursts); %d trees of depth %d,\n",
+            STREAM_INTERVAL_MS, m->trees, TREE_DEPTH);
+    fprintf(fp, "// fall weight %.1f. Validation (seed %lu): %d/%d fall events confirmed,\n",
+            fall_weight, (unsigned long)config->seed + 1, v.falls_confirmed, v.falls);
+    fprintf(fp, "// %d/%d other events rejected.\n\n", v.others_rejected, v.others);
+    fprintf(fp, "#ifndef _FALL_MODEL_H_\n#define _FALL_MODEL_H_\n\n#include <stdint.h>\n\n");
+    fprintf(fp, "#define FALL_MODEL_FEATURES %d\n", FALL_FEATURE_COUNT);
+    fprintf(fp, "#define FALL_MODEL_TREES %d\n", m->trees);
+    fprintf(fp, "#define FALL_MODEL_DEPTH %d\n\n", TREE_DEPTH);
+    fprintf(fp, "// Leaf units per unit of log-odds\n#define FALL_MODEL_LEAF_SCALE %.1ff\n\n", LEAF_SCALE);
+    fprintf(fp, "// Prior log-odds (leaf units)\n#define FALL_MODEL_BIAS %d\n\n", (int)m->bias);
+
+    fprintf(fp, "// Input quantization: q = (x - offset) * scale, rounded and saturated to int8\n");
+    fprintf(fp, "// (");
+    for (int f = 0; f < FALL_FEATURE_COUNT; f++) {
+        fprintf(fp, "%s%s", f ? ", " : "", fall_feature_name(f));
+    }
+    fprintf(fp, ")\n");
+    const float *rows[2] = { m->offset, m->scale };
+    const char *names[2] = { "OFFSET", "SCALE" };
+    for (int r = 0; r < 2; r++) {
+        fprintf(fp, "static constexpr float FALL_MODEL_%s[FALL_MODEL_FEATURES] = {\n    ", names[r]);
+        for (int f = 0; f < FALL_FEATURE_COUNT; f++) {
+            char value[32];
+            snprintf(value, sizeof(value), "%.6g", rows[r][f]);
+            bool integral = strpbrk(value, ".e") == NULL;
+            fprintf(fp, "%s%s%sf", f ? ", " : "", value, integral ? ".0" : "");
+        }
+        fprintf(fp, "\n};\n");
+    }
+
+    fprintf(fp, "\n// Per tree and level: feature tested and threshold (index bit set when q > threshold)\n");
+    fprintf(fp, "static constexpr uint8_t FALL_MODEL_SPLIT_FEATURE[FALL_MODEL_TREES][FALL_MODEL_DEPTH] = {\n");
+    for (int t = 0; t < m->trees; t++) {
+        fprintf(fp, "    {");
+        for (int d = 0; d < TREE_DEPTH; d++) {
+            fprintf(fp, "%s%d", d ? ", " : " ", m->feature[t][d]);
+        }
+        fprintf(fp, " },\n");
+    }
+    fprintf(fp, "};\n");
+    fprintf(fp, "static constexpr int8_t FALL_MODEL_SPLIT_THRESHOLD[FALL_MODEL_TREES][FALL_MODEL_DEPTH] = {\n");
+    for (int t = 0; t < m->trees; t++) {
+        fprintf(fp, "    {");
+        for (int d = 0; d < TREE_DEPTH; d++) {
+            fprintf(fp, "%s%d", d ? ", " : " ", m->threshold[t][d]);
+        }
+        fprintf(fp, " },\n");
+    }
+    fprintf(fp, "};\n");
+
+    fprintf(fp, "\n// Per tree: log-odds by leaf index (leaf units)\n");
+    fprintf(fp, "static constexpr int8_t FALL_MODEL_LEAF[FALL_MODEL_TREES][1 << FALL_MODEL_DEPTH] = {\n");
+    for (int t = 0; t < m->trees; t++) {
+        fprintf(fp, "    {");
+        for (int l = 0; l < LEAVES; l++) {
+            fprintf(fp, "%s%d", l ? ", " : " ", m->leaf[t][l]);
+        }
+        fprintf(fp, " },\n");
+    }
+    fprintf(fp, "};\n\n#endif // _FALL_MODEL_H_\n");
+    return fclose(fp) == 0;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *output = DEFAULT_OUTPUT;
+    int trees = 16;
+    double fall_weight = 2.0;
+    corpus_config_t config;
+    corpus_default_config(&config);
+    config.seed = 1000;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const char *value = argv[i + 1];
+        if (strcmp(argv[i], "-o") == 0) {
+            output = value;
+        } else if (strcmp(argv[i], "-t") == 0) {
+            trees = atoi(value);
+        } else if (strcmp(argv[i], "-w") == 0) {
+            fall_weight = atof(value);
+        } else if (strcmp(argv[i], "-r") == 0) {
+            config.rate_hz = (uint16_t)atoi(value);
+        } else if (strcmp(argv[i], "-n") == 0) {
+            config.traces_per_scenario = atoi(value);
+        } else if (strcmp(argv[i], "-s") == 0) {
+            config.seed = (uint32_t)strtoul(value, NULL, 0);
+        } else {
+            fprintf(stderr, "FallTrain - Unknown option %s\n", argv[i]);
+            return 1;
+        }
+    }
+    if (trees < 1 || trees > MAX_TREES || fall_weight <= 0.0 || config.rate_hz == 0 ||
+        config.traces_per_scenario <= 0) {
+        fprintf(stderr, "FallTrain - Need 1-%d trees, fall weight > 0, rate > 0 and traces > 0\n", MAX_TREES);
+        return 1;
+    }
+
+    std::vector<corpus_trace_t> traces;
+    std::vector<event_sample_t> training, validation;
+    corpus_generate(&config, &traces);
+    extract_events(traces, config.rate_hz, &training);
+    corpus_config_t validation_config = config;
+    validation_config.seed = config.seed + 1;
+    corpus_generate(&validation_config, &traces);
+    extract_events(traces, config.rate_hz, &validation);
+
+    int falls = 0;
+    for (const event_sample_t &e : training) {
+        falls += e.fall;
+    }
+    if (falls == 0 || falls == (int)training.size()) {
+        fprintf(stderr, "FallTrain - Training corpus needs both fall and other events\n");
+        return 1;
+    }
+    printf("FallTrain - %zu training events (%d falls), %u Hz, seed %lu\n",
+           training.size(), falls, config.rate_hz, (unsigned long)config.seed);
+
+    static model_t model;
+    fit_quantization(&model, training);
+    quantize_events(&model, &training);
+    quantize_events(&model, &validation);
+    train(&model, training, trees, fall_weight);
+
+    print_results("Training", &model, training);
+    print_results("Validation", &model, validation);
+    measure_inference(validation);
+
+    if (!write_model(output, &model, &config, fall_weight, validation)) {
+        fprintf(stderr, "FallTrain - Cannot write %s\n", output);
+        return 1;
+    }
+    printf("\nFallTrain - Wrote %d trees to %s\n", model.trees, output);
+    return 0;
+}
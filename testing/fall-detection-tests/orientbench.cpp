@@ -0,0 +1,183 @@
+// Orientation Benchmark - Cost and post-fall posture accuracy of the hub's orientation filter
+// Runs the BeagleBoard daemon's orientation filter (orientation.h) over a
+// generated corpus (corpus.h), once per device as the daemon does and once in
+// SoA batches of ORIENTATION_BATCH_MAX devices (one trace per lane). Reports
+// ns per device-sample and the devices one core could follow at the corpus
+// rate for both, the largest tilt difference between them, and how often the
+// posture 1.5 s after a fall's impact matches the fall direction.
+//
+// Build (from this directory):
+//   g++ -std=c++17 -O2 -I../../protocol -I../../communication-hub/beagleboard/include
+//       orientbench.cpp corpus.cpp ../../communication-hub/beagleboard/src/orientation.cpp
+//       -o orientbench
+//   (add -O3 -fno-math-errno to let the compiler vectorize the batch loop)
+// Usage: orientbench [-r rate_hz] [-n traces_per_scenario] [-s seed]
+
+#include "corpus.h"
+#include "orientation.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Posture is sampled this long after the impact (ms)
+#define POSTURE_DELAY_MS 1500
+
+// Minimum wall time per throughput measurement
+#define THROUGHPUT_MIN_S 0.3
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Expected posture after a fall (POSTURE_UNKNOWN: any lying posture)
+static bool posture_matches(scenario_t scenario, posture_t posture)
+{
+    switch (scenario) {
+    case SCENARIO_FALL_FORWARD:  return posture == POSTURE_PRONE;
+    case SCENARIO_FALL_BACKWARD: return posture == POSTURE_SUPINE;
+    case SCENARIO_FALL_LATERAL:  return posture == POSTURE_LEFT_SIDE || posture == POSTURE_RIGHT_SIDE;
+    default:                     return posture != POSTURE_UPRIGHT && posture != POSTURE_UNKNOWN;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    corpus_config_t config;
+    corpus_default_config(&config);
+    for (int i = 1; i < argc; i += 2) {
+        if (i + 1 >= argc) {
+            fprintf(stderr, "Usage: %s [-r rate_hz] [-n traces_per_scenario] [-s seed]\n", argv[0]);
+            return 1;
+        }
+        if (strcmp(argv[i], "-r") == 0) {
+            config.rate_hz = (uint16_t)atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], "-n") == 0) {
+            config.traces_per_scenario = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], "-s") == 0) {
+            config.seed = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+        } else {
+            fprintf(stderr, "Usage: %s [-r rate_hz] [-n traces_per_scenario] [-s seed]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (config.rate_hz == 0 || config.traces_per_scenario <= 0) {
+        fprintf(stderr, "OrientBench - Need rate > 0 and traces > 0\n");
+        return 1;
+    }
+
+    std::vector<corpus_trace_t> traces;
+    corpus_generate(&config, &traces);
+    int trace_count = (int)traces.size();
+    int steps = (int)traces[0].samples.size();
+    uint64_t device_samples = (uint64_t)trace_count * steps;
+    printf("OrientBench - %d traces of %d samples at %u Hz\n", trace_count, steps, config.rate_hz);
+
+    // ===== Per device (as the daemon runs it) =====
+    std::vector<orientation_t> scalar(trace_count);
+    int matched[SCENARIO_COUNT] = { 0 };
+    int falls[SCENARIO_COUNT] = { 0 };
+    for (int t = 0; t < trace_count; t++) {
+        const corpus_trace_t &trace = traces[t];
+        orientation_init(&scalar[t]);
+        bool sampled = false;
+        for (const sensor_data_t &s : trace.samples) {
+            orientation_update(&scalar[t], &s);
+            if (trace.is_fall && !sampled && s.timestamp >= trace.event_ms + POSTURE_DELAY_MS) {
+                sampled = true;
+                falls[trace.scenario]++;
+                matched[trace.scenario] += posture_matches(trace.scenario, orientation_posture(&scalar[t])) ? 1 : 0;
+            }
+        }
+    }
+
+    float checksum = 0.0f;      // Keeps the timed work observable
+    int passes = 0;
+    double start = now_s(), elapsed;
+    do {
+        for (int t = 0; t < trace_count; t++) {
+            orientation_t o;
+            orientation_init(&o);
+            for (const sensor_data_t &s : traces[t].samples) {
+                orientation_update(&o, &s);
+            }
+            checksum += o.q0;
+        }
+        passes++;
+        elapsed = now_s() - start;
+    } while (elapsed < THROUGHPUT_MIN_S);
+    double scalar_ns = elapsed * 1e9 / ((double)device_samples * passes);
+
+    // ===== SoA batches: one trace per lane, inputs laid out per step =====
+    int batches = (trace_count + ORIENTATION_BATCH_MAX - 1) / ORIENTATION_BATCH_MAX;
+    std::vector<orientation_input_t> inputs((size_t)batches * steps);
+    for (int b = 0; b < batches; b++) {
+        for (int j = 0; j < steps; j++) {
+            orientation_input_t *in = &inputs[(size_t)b * steps + j];
+            memset(in, 0, sizeof(*in));
+            for (int lane = 0; lane < ORIENTATION_BATCH_MAX; lane++) {
+                int t = b * ORIENTATION_BATCH_MAX + lane;
+                if (t >= trace_count) {
+                    break;
+                }
+                const sensor_data_t &s = traces[t].samples[j];
+                in->ax[lane] = s.accel_x;
+                in->ay[lane] = s.accel_y;
+                in->az[lane] = s.accel_z;
+                in->gx[lane] = s.gyro_x;
+                in->gy[lane] = s.gyro_y;
+                in->gz[lane] = s.gyro_z;
+            }
+        }
+    }
+
+    float dt = 1.0f / config.rate_hz;
+    std::vector<orientation_batch_t> batch(batches);
+    passes = 0;
+    start = now_s();
+    do {
+        for (int b = 0; b < batches; b++) {
+            int lanes = trace_count - b * ORIENTATION_BATCH_MAX;
+            orientation_batch_init(&batch[b], lanes < ORIENTATION_BATCH_MAX ? lanes : ORIENTATION_BATCH_MAX);
+            for (int lane = 0; lane < batch[b].count; lane++) {
+                const orientation_input_t *first = &inputs[(size_t)b * steps];
+                orientation_batch_seed(&batch[b], lane, first->ax[lane], first->ay[lane], first->az[lane]);
+            }
+            for (int j = 1; j < steps; j++) {
+                orientation_batch_update(&batch[b], &inputs[(size_t)b * steps + j], dt);
+            }
+            checksum += batch[b].q0[0];
+        }
+        passes++;
+        elapsed = now_s() - start;
+    } while (elapsed < THROUGHPUT_MIN_S);
+    double batch_ns = elapsed * 1e9 / ((double)device_samples * passes);
+
+    // Both paths must agree (the scalar one integrates timestamp differences)
+    float worst_deg = 0.0f;
+    for (int t = 0; t < trace_count; t++) {
+        float diff = fabsf(orientation_tilt_deg(&scalar[t]) -
+                           orientation_batch_tilt_deg(&batch[t / ORIENTATION_BATCH_MAX], t % ORIENTATION_BATCH_MAX));
+        if (diff > worst_deg) {
+            worst_deg = diff;
+        }
+    }
+
+    printf("OrientBench - Per device: %.1f ns/sample, %.0f devices at %u Hz per core\n",
+           scalar_ns, 1e9 / (scalar_ns * config.rate_hz), config.rate_hz);
+    printf("OrientBench - SoA batch:  %.1f ns/sample, %.0f devices at %u Hz per core (%.2fx)\n",
+           batch_ns, 1e9 / (batch_ns * config.rate_hz), config.rate_hz, scalar_ns / batch_ns);
+    printf("OrientBench - Largest final tilt difference between the two: %.3f deg (checksum %.1f)\n",
+           worst_deg, checksum);
+    for (int s = 0; s < SCENARIO_COUNT; s++) {
+        if (falls[s] > 0) {
+            printf("OrientBench - %-14s posture after impact as expected in %d/%d\n",
+                   corpus_scenario_name((scenario_t)s), matched[s], falls[s]);
+        }
+    }
+    return 0;
+}
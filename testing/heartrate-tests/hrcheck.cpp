@@ -0,0 +1,111 @@
+// Heart Rate Check - Drives the hub's heart rate analyzer from the simulator
+// Runs every hr_sim profile over several seeds through hr_analyzer_update()
+// with the default config.json limits and checks that each is classified as
+// expected once the window has HR_MIN_READINGS readings:
+//   normal -> OK, bradycardia -> LOW, tachycardia -> HIGH,
+//   irregular -> IRREGULAR, hypoxia -> LOW once SpO2 is below HR_SPO2_MIN
+// A profile passes when at least MIN_AGREEMENT of its classified readings
+// have the expected status (for hypoxia: of those with SpO2 below the limit).
+// Exits non-zero if any profile fails.
+//
+// Build (from this directory):
+//   g++ -std=c++17 -O2 -I../../protocol -I../../communication-hub/beagleboard/include
+//       hrcheck.cpp ../../communication-hub/beagleboard/src/heartrate_analyzer.cpp
+//       ../../communication-hub/beagleboard/src/heartrate_sim.cpp -o hrcheck
+// Usage: hrcheck [-n readings] [-s seeds]
+
+#include "heartrate_analyzer.h"
+#include "heartrate_sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Share of classified readings that must match the expected status
+#define MIN_AGREEMENT 0.95
+
+typedef struct {
+    hr_sim_profile_t profile;
+    const char *name;
+    uint8_t expected;
+} profile_case_t;
+
+static const profile_case_t CASES[] = {
+    { HR_SIM_NORMAL,      "normal",      HR_STATUS_OK },
+    { HR_SIM_BRADYCARDIA, "bradycardia", HR_STATUS_LOW },
+    { HR_SIM_TACHYCARDIA, "tachycardia", HR_STATUS_HIGH },
+    { HR_SIM_IRREGULAR,   "irregular",   HR_STATUS_IRREGULAR },
+    { HR_SIM_HYPOXIA,     "hypoxia",     HR_STATUS_LOW },
+};
+
+static const char *status_name(uint8_t status)
+{
+    switch (status) {
+    case HR_STATUS_OK:        return "OK";
+    case HR_STATUS_LOW:       return "LOW";
+    case HR_STATUS_HIGH:      return "HIGH";
+    case HR_STATUS_IRREGULAR: return "IRREGULAR";
+    default:                  return "ERROR";
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int readings = 200;
+    int seeds = 20;
+    int opt;
+    while ((opt = getopt(argc, argv, "n:s:")) != -1) {
+        switch (opt) {
+        case 'n': readings = atoi(optarg); break;
+        case 's': seeds = atoi(optarg); break;
+        default:
+            fprintf(stderr, "Usage: %s [-n readings] [-s seeds]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    // Heart rate limits from config/config.json
+    hub_config_t cfg;
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.heartrate_min = 40;
+    cfg.heartrate_max = 150;
+
+    printf("%-12s %-10s %8s %8s %8s %8s %10s  %s\n",
+           "profile", "expected", "OK", "LOW", "HIGH", "IRREG", "agreement", "result");
+    int failures = 0;
+    for (const profile_case_t &c : CASES) {
+        unsigned counts[HR_STATUS_ERROR + 1] = {0};
+        unsigned judged = 0;
+        unsigned matched = 0;
+        for (int seed = 1; seed <= seeds; seed++) {
+            hr_sim_t sim;
+            hr_analyzer_t hr;
+            hr_sim_init(&sim, c.profile, (uint32_t)seed * 2654435761u, 1000);
+            hr_analyzer_init(&hr);
+            for (int i = 0; i < readings; i++) {
+                heartrate_t reading;
+                hr_sim_next(&sim, &reading);
+                uint8_t status = hr_analyzer_update(&hr, &reading, &cfg);
+                if (hr.count < HR_MIN_READINGS) {
+                    continue;
+                }
+                if (c.profile == HR_SIM_HYPOXIA && reading.spo2 >= HR_SPO2_MIN) {
+                    continue;
+                }
+                counts[status]++;
+                judged++;
+                matched += (status == c.expected);
+            }
+        }
+
+        double agreement = (judged > 0) ? (double)matched / judged : 0.0;
+        bool pass = judged > 0 && agreement >= MIN_AGREEMENT;
+        failures += !pass;
+        printf("%-12s %-10s %8u %8u %8u %8u %9.1f%%  %s\n", c.name, status_name(c.expected),
+               counts[HR_STATUS_OK], counts[HR_STATUS_LOW], counts[HR_STATUS_HIGH],
+               counts[HR_STATUS_IRREGULAR], agreement * 100.0, pass ? "PASS" : "FAIL");
+    }
+
+    printf("%s\n", failures == 0 ? "All profiles classified as expected" : "Classification check FAILED");
+    return failures == 0 ? 0 : 1;
+}
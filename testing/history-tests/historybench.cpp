@@ -0,0 +1,186 @@
+// History Benchmark - Ingest cost and range query latency of the hub's sensor history
+// Fills one device's pyramid (history.h) with a week of synthetic samples at
+// the given rate, reporting ns per history_add(), then times history_query()
+// over the last hour, 6 hours, day and week at several output widths, plus a
+// range that runs past the newest sample. Every query's sample counts are
+// checked against the samples actually ingested in its range; the tool exits
+// non-zero on a mismatch or if a week query takes longer than WEEK_QUERY_MAX_MS.
+//
+// Build (from this directory):
+//   g++ -std=c++17 -O2 -I../../protocol -I../../common/include
+//       -I../../communication-hub/beagleboard/include historybench.cpp
+//       ../../communication-hub/beagleboard/src/history.cpp ../../common/src/pool.cpp -o historybench
+// Usage: historybench [-r rate_hz] [-d days]
+
+#include "history.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define DAY_MS (24ULL * 3600 * 1000)
+
+// Acceptance target for rendering a week
+#define WEEK_QUERY_MAX_MS 5.0
+
+// Minimum wall time per query measurement
+#define QUERY_MIN_S 0.2
+
+// Widest chart tested
+#define MAX_POINTS 4000
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Slow daily activity cycle plus per-sample wobble (m/s^2)
+static void make_sample(uint64_t t_ms, sensor_data_t *data)
+{
+    float day = (float)(t_ms % DAY_MS) / (float)DAY_MS;
+    float activity = 0.5f + 0.5f * sinf(6.2831853f * day);
+    float wobble = sinf((float)(t_ms % 1000) * 0.0314f);
+    memset(data, 0, sizeof(*data));
+    data->accel_x = 0.8f * activity * wobble;
+    data->accel_y = 0.3f * activity;
+    data->accel_z = 9.81f + 1.5f * activity * wobble;
+    data->gyro_x = 0.2f * activity * wobble;
+    data->temperature = 31.0f + 2.0f * activity;
+    data->timestamp = (uint32_t)t_ms;
+}
+
+// Samples the fill put in [start_ms, end_ms)
+static uint64_t expected_count(uint64_t start_ms, uint64_t end_ms, uint64_t first_ms,
+                               uint64_t last_ms, uint64_t step_ms)
+{
+    if (start_ms < first_ms) start_ms = first_ms;
+    if (end_ms > last_ms + 1) end_ms = last_ms + 1;
+    if (end_ms <= start_ms) return 0;
+    uint64_t lo = (start_ms - first_ms + step_ms - 1) / step_ms;
+    uint64_t hi = (end_ms - first_ms + step_ms - 1) / step_ms;
+    return hi - lo;
+}
+
+int main(int argc, char *argv[])
+{
+    int rate_hz = 100;
+    int days = 7;
+    for (int i = 1; i < argc; i += 2) {
+        if (i + 1 >= argc) {
+            fprintf(stderr, "Usage: %s [-r rate_hz] [-d days]\n", argv[0]);
+            return 1;
+        }
+        if (strcmp(argv[i], "-r") == 0) {
+            rate_hz = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], "-d") == 0) {
+            days = atoi(argv[i + 1]);
+        } else {
+            fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return 1;
+        }
+    }
+    if (rate_hz <= 0 || rate_hz > 1000 || days <= 0 || days > 30) {
+        fprintf(stderr, "Rate must be 1-1000 Hz and days 1-30 (the coarsest level keeps 30 days)\n");
+        return 1;
+    }
+
+    history_t *hist = history_pool_init(1) ? history_create() : NULL;
+    if (hist == NULL) {
+        fprintf(stderr, "Cannot create history\n");
+        return 1;
+    }
+
+    // Fill
+    uint64_t step_ms = 1000 / (uint64_t)rate_hz;
+    uint64_t first_ms = 1700000000000ULL;
+    uint64_t last_ms = first_ms;
+    uint64_t samples = (uint64_t)days * DAY_MS / step_ms;
+    sensor_data_t data;
+    double t0 = now_s();
+    for (uint64_t i = 0; i < samples; i++) {
+        last_ms = first_ms + i * step_ms;
+        make_sample(last_ms, &data);
+        history_add(hist, last_ms, &data);
+    }
+    double fill_s = now_s() - t0;
+    printf("Filled %d days at %d Hz: %llu samples, %.1f ns/sample (%.1f s)\n\n", days, rate_hz,
+           (unsigned long long)samples, fill_s * 1e9 / (double)samples, fill_s);
+
+    static history_point_t points[MAX_POINTS];
+    static const struct { const char *name; uint64_t span_ms; } RANGES[] = {
+        { "1 hour", 3600ULL * 1000 },
+        { "6 hours", 6ULL * 3600 * 1000 },
+        { "1 day", DAY_MS },
+        { "1 week", 7 * DAY_MS },
+    };
+    static const uint32_t WIDTHS[] = { 200, 1000, MAX_POINTS };
+
+    printf("%-22s %7s %9s %10s %10s  %s\n", "range", "points", "bucket", "us/query", "samples", "check");
+    int failures = 0;
+    double worst_week_ms = 0.0;
+    for (const auto &range : RANGES) {
+        // Ranges longer than the fill just start earlier (no data there)
+        uint64_t end_ms = last_ms + 1;
+        uint64_t start_ms = end_ms - range.span_ms;
+        for (uint32_t width : WIDTHS) {
+            uint32_t bucket_ms = 0;
+            int runs = 0;
+            double q0 = now_s();
+            double elapsed;
+            do {
+                bucket_ms = history_query(hist, start_ms, end_ms, width, points);
+                runs++;
+                elapsed = now_s() - q0;
+            } while (elapsed < QUERY_MIN_S);
+            double us = elapsed * 1e6 / runs;
+
+            // Buckets straddling start_ms are counted whole, so allow one bucket of slack
+            uint64_t got = 0;
+            for (uint32_t p = 0; p < width; p++) {
+                got += points[p].count;
+            }
+            uint64_t want = expected_count(start_ms, end_ms, first_ms, last_ms, step_ms);
+            uint64_t slack = bucket_ms / step_ms;
+            bool ok = bucket_ms > 0 && got >= want && got <= want + slack;
+            failures += !ok;
+            if (range.span_ms == 7 * DAY_MS && us / 1000.0 > worst_week_ms) {
+                worst_week_ms = us / 1000.0;
+            }
+            printf("%-22s %7u %7.0f s %10.1f %10llu  %s\n", range.name, width, bucket_ms / 1000.0, us,
+                   (unsigned long long)got, ok ? "ok" : "MISMATCH");
+        }
+    }
+
+    // A range ending far past the newest sample must cost no more than one ending at it
+    {
+        uint64_t start_ms = last_ms + 1 - 7 * DAY_MS;
+        uint64_t end_ms = start_ms + 365 * DAY_MS;
+        int runs = 0;
+        double q0 = now_s();
+        double elapsed;
+        do {
+            history_query(hist, start_ms, end_ms, 1000, points);
+            runs++;
+            elapsed = now_s() - q0;
+        } while (elapsed < QUERY_MIN_S);
+        uint64_t got = 0;
+        for (uint32_t p = 0; p < 1000; p++) {
+            got += points[p].count;
+        }
+        uint64_t want = expected_count(start_ms, end_ms, first_ms, last_ms, step_ms);
+        bool ok = got >= want && got <= want + 600000 / step_ms;
+        failures += !ok;
+        printf("%-22s %7u %9s %10.1f %10llu  %s\n", "1 week + 358 d ahead", 1000, "", elapsed * 1e6 / runs,
+               (unsigned long long)got, ok ? "ok" : "MISMATCH");
+    }
+
+    bool fast = worst_week_ms <= WEEK_QUERY_MAX_MS;
+    printf("\nWorst week query %.3f ms (target %.1f ms): %s\n", worst_week_ms, WEEK_QUERY_MAX_MS,
+           fast ? "ok" : "TOO SLOW");
+    history_destroy(hist);
+    history_pool_cleanup();
+    return (failures == 0 && fast) ? 0 : 1;
+}
@@ -0,0 +1,182 @@
+// Ingest Check - Floods the hub's admission path with mixed traffic
+// Simulates the ESP32 hub's receive path one millisecond at a time: every
+// peer offers SENSOR_DATA, SENSOR_SUMMARY, TIME_SYNC and ACK frames far above
+// its budget, a few peers report falls (FALL_DETECTED followed by
+// IMPACT_BURST chunks, four per wearable loop), and loop() drains a fixed
+// number of frames per millisecond. Admission goes through
+// ingest_limit_admit() with 'saturated' set as the hub sets it, and admitted
+// frames take a block from a receive pool of the hub's size.
+// Checks that every alert was admitted and got a block, and that while
+// saturated no non-alert type was admitted. Exits non-zero on failure.
+//
+// Build (from this directory):
+//   g++ -std=c++17 -O2 -I../../protocol -I../../common/include
+//       ingestcheck.cpp ../../common/src/ingest_limit.cpp -o ingestcheck
+// Usage: ingestcheck [-p peers] [-t seconds] [-d drain_per_ms]
+
+#include "common/ingest_limit.h"
+#include "protocol.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Receive pool as in communication-hub/esp32/src/main.cpp
+#define RX_QUEUE_DEPTH 16
+#define RX_ALERT_RESERVE 4
+
+// Offered load per peer and frame type (frames/s), about 12x the budget
+#define FLOOD_RATE_HZ 400
+
+// Fall reports: one every this many ms on the falling peers, each followed
+// by BURST_CHUNKS chunks sent four per WEARABLE_LOOP_MS
+#define FALL_PERIOD_MS 700
+#define BURST_CHUNKS 12
+#define WEARABLE_LOOP_MS 10
+
+static const uint8_t FLOOD_TYPES[] = {
+    PKT_SENSOR_DATA, PKT_SENSOR_SUMMARY, PKT_TIME_SYNC, PKT_ACK
+};
+#define FLOOD_TYPE_COUNT (int)(sizeof(FLOOD_TYPES) / sizeof(FLOOD_TYPES[0]))
+
+typedef struct {
+    uint32_t offered;
+    uint32_t admitted;
+    uint32_t admitted_saturated;    // Admitted while the hub was saturated
+    uint32_t no_block;              // Admitted but the pool was empty
+} type_counts_t;
+
+static type_counts_t counts[256];
+static int pool_in_use = 0;
+
+// Offer one frame the way onDataRecv() does
+static void offer(ingest_limit_t *limit, const uint8_t mac[6], uint8_t type, uint64_t now_us)
+{
+    type_counts_t *c = &counts[type];
+    c->offered++;
+    bool saturated = pool_in_use >= RX_QUEUE_DEPTH - RX_ALERT_RESERVE;
+    if (!ingest_limit_admit(limit, mac, type, now_us, saturated)) {
+        return;
+    }
+    c->admitted++;
+    if (saturated) {
+        c->admitted_saturated++;
+    }
+    if (pool_in_use == RX_QUEUE_DEPTH) {
+        c->no_block++;
+        return;
+    }
+    pool_in_use++;
+}
+
+static const char *type_name(uint8_t type)
+{
+    switch (type) {
+    case PKT_SENSOR_DATA:    return "SENSOR_DATA";
+    case PKT_SENSOR_SUMMARY: return "SENSOR_SUMMARY";
+    case PKT_TIME_SYNC:      return "TIME_SYNC";
+    case PKT_ACK:            return "ACK";
+    case PKT_FALL_DETECTED:  return "FALL_DETECTED";
+    case PKT_IMPACT_BURST:   return "IMPACT_BURST";
+    default:                 return "?";
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int peers = 8;
+    int seconds = 10;
+    int drain_per_ms = 2;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "p:t:d:")) != -1) {
+        switch (opt) {
+        case 'p': peers = atoi(optarg); break;
+        case 't': seconds = atoi(optarg); break;
+        case 'd': drain_per_ms = atoi(optarg); break;
+        default:
+            fprintf(stderr, "Usage: %s [-p peers] [-t seconds] [-d drain_per_ms]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (peers < 1 || peers > 64 || seconds < 1 || drain_per_ms < 1) {
+        fprintf(stderr, "Peers must be 1-64, seconds and drain at least 1\n");
+        return 1;
+    }
+
+    ingest_limit_t limit;
+    ingest_limit_init(&limit, NULL);
+    memset(counts, 0, sizeof(counts));
+
+    // Every other peer falls, staggered so reports overlap
+    int falling = (peers + 1) / 2;
+    uint64_t saturated_ms = 0;
+
+    for (uint64_t ms = 0; ms < (uint64_t)seconds * 1000; ms++) {
+        uint64_t now_us = ms * 1000;
+        for (int p = 0; p < peers; p++) {
+            uint8_t mac[6] = { 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, (uint8_t)p };
+
+            // Flood: each type at FLOOD_RATE_HZ, phase-shifted per peer
+            for (int t = 0; t < FLOOD_TYPE_COUNT; t++) {
+                uint64_t before = (ms * FLOOD_RATE_HZ + p * 97 + t * 31) / 1000;
+                uint64_t after = ((ms + 1) * FLOOD_RATE_HZ + p * 97 + t * 31) / 1000;
+                for (uint64_t n = before; n < after; n++) {
+                    offer(&limit, mac, FLOOD_TYPES[t], now_us);
+                }
+            }
+
+            // Falls: FALL_DETECTED, then the burst four chunks per wearable loop
+            if (p % 2 == 0) {
+                uint64_t phase = (ms + (uint64_t)p * 53) % FALL_PERIOD_MS;
+                if (phase == 0) {
+                    offer(&limit, mac, PKT_FALL_DETECTED, now_us);
+                }
+                if (phase > 0 && phase % WEARABLE_LOOP_MS == 0 &&
+                    phase / WEARABLE_LOOP_MS <= (BURST_CHUNKS + 3) / 4) {
+                    for (int c = 0; c < 4; c++) {
+                        offer(&limit, mac, PKT_IMPACT_BURST, now_us);
+                    }
+                }
+            }
+        }
+
+        if (pool_in_use >= RX_QUEUE_DEPTH - RX_ALERT_RESERVE) {
+            saturated_ms++;
+        }
+        // loop() processes a few frames and frees their blocks
+        pool_in_use = (pool_in_use > drain_per_ms) ? pool_in_use - drain_per_ms : 0;
+    }
+
+    printf("IngestCheck - %d peers (%d falling), %d s, pool %d (%d for alerts), drain %d/ms, "
+           "saturated %.1f%% of the time\n\n",
+           peers, falling, seconds, RX_QUEUE_DEPTH, RX_ALERT_RESERVE, drain_per_ms,
+           100.0 * saturated_ms / (seconds * 1000.0));
+    printf("  %-15s %9s %9s %11s %9s\n", "type", "offered", "admitted", "saturated", "no block");
+
+    static const uint8_t REPORT[] = {
+        PKT_SENSOR_DATA, PKT_SENSOR_SUMMARY, PKT_TIME_SYNC, PKT_ACK,
+        PKT_FALL_DETECTED, PKT_IMPACT_BURST
+    };
+    int failures = 0;
+    for (size_t i = 0; i < sizeof(REPORT); i++) {
+        uint8_t type = REPORT[i];
+        const type_counts_t *c = &counts[type];
+        bool alert = ingest_limit_is_alert(type);
+        bool ok = alert ? (c->admitted == c->offered && c->no_block == 0)
+                        : (c->admitted_saturated == 0);
+        printf("  %-15s %9u %9u %11u %9u  %s\n", type_name(type), (unsigned)c->offered,
+               (unsigned)c->admitted, (unsigned)c->admitted_saturated, (unsigned)c->no_block,
+               ok ? "ok" : "FAIL");
+        if (!ok) {
+            failures++;
+        }
+    }
+
+    if (saturated_ms == 0) {
+        printf("\nThe hub never saturated; raise -p or lower -d\n");
+        failures++;
+    }
+    printf("\n%s\n", failures == 0 ? "Every alert admitted and given a block" : "FAILED");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,239 @@
+// Sensor Calibration Tool - Derives MPU-6050 bias/scale from a six-orientation session
+// Record the wearable resting still for a few seconds on each of its six faces
+// (+X, -X, +Y, -Y, +Z, -Z pointing up), in any order, moving it between them.
+// The session is a trace in the host backend format ("ax,ay,az,gx,gy,gz,temp"
+// per line in m/s^2, rad/s, Celsius; '#' lines and unparsable lines are
+// skipped), e.g. captured from a wearable built with -DCALIBRATION_DUMP.
+//
+// The session is cut into fixed windows; still windows (low accelerometer and
+// gyro variance) are assigned to the face whose axis carries gravity. Per
+// accelerometer axis, with u and d the readings facing up and down:
+//   bias = (u + d) / 2        scale = (u - d) / (2 g)
+// Gyro bias is the mean rate over all still windows. Gyro scale needs a known
+// rotation rate, which a static session cannot provide, so it is written as 1.
+//
+// Build: g++ -std=c++17 -O2 calibrate.cpp -o calibrate
+// Usage: calibrate <session.csv> <MAC> [calibration.csv]
+//        Prints the calibration line; with a table path, adds or replaces
+//        the MAC's entry (communication-hub/beagleboard/config/calibration.csv).
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#define GRAVITY 9.80665
+
+// Samples per analysis window (0.5 s at the NORMAL profile's 100 Hz)
+#define WINDOW_SAMPLES 50
+
+// Still-window limits: per-axis standard deviation
+#define STILL_ACCEL_STDDEV 0.15     // m/s^2
+#define STILL_GYRO_STDDEV 0.02      // rad/s
+
+// Gravity must be this much of |a| on the face's axis (about 25 degrees of tilt)
+#define FACE_ALIGNMENT 0.9
+
+// Still windows needed per face (1 s)
+#define MIN_WINDOWS_PER_FACE 2
+
+static const char *FACE_NAMES[6] = { "+X up", "-X up", "+Y up", "-Y up", "+Z up", "-Z up" };
+
+typedef struct {
+    int windows;
+    double accel[3];            // Sum of window means
+    double gyro[3];
+} face_t;
+
+static bool parse_sample(const char *line, double v[6])
+{
+    if (line[0] == '#') {
+        return false;
+    }
+    float f[7];
+    int fields = sscanf(line, "%f,%f,%f,%f,%f,%f,%f", &f[0], &f[1], &f[2], &f[3], &f[4], &f[5], &f[6]);
+    if (fields < 6) {
+        return false;
+    }
+    for (int i = 0; i < 6; i++) {
+        v[i] = f[i];
+    }
+    return true;
+}
+
+// Classify one window; returns the face index or -1 if it is not still and aligned
+static int classify_window(const double (*w)[6], int n, double mean[6])
+{
+    double var[6] = {0};
+    for (int c = 0; c < 6; c++) {
+        mean[c] = 0.0;
+        for (int i = 0; i < n; i++) mean[c] += w[i][c];
+        mean[c] /= n;
+        for (int i = 0; i < n; i++) var[c] += (w[i][c] - mean[c]) * (w[i][c] - mean[c]);
+        var[c] /= n;
+    }
+    for (int c = 0; c < 3; c++) {
+        if (sqrt(var[c]) > STILL_ACCEL_STDDEV || sqrt(var[c + 3]) > STILL_GYRO_STDDEV) {
+            return -1;
+        }
+    }
+
+    double mag = sqrt(mean[0] * mean[0] + mean[1] * mean[1] + mean[2] * mean[2]);
+    if (mag < 0.7 * GRAVITY || mag > 1.3 * GRAVITY) {
+        return -1;
+    }
+    int axis = 0;
+    for (int c = 1; c < 3; c++) {
+        if (fabs(mean[c]) > fabs(mean[axis])) axis = c;
+    }
+    if (fabs(mean[axis]) < FACE_ALIGNMENT * mag) {
+        return -1;
+    }
+    return axis * 2 + (mean[axis] > 0 ? 0 : 1);
+}
+
+// Add or replace the MAC's line in the calibration table
+static bool update_table(const char *path, const char *mac, const std::string &entry)
+{
+    std::vector<std::string> lines;
+    FILE *in = fopen(path, "r");
+    if (in != NULL) {
+        char line[512];
+        while (fgets(line, sizeof(line), in) != NULL) {
+            if (strncasecmp(line, mac, strlen(mac)) != 0) {
+                lines.push_back(line);
+            }
+        }
+        fclose(in);
+    } else {
+        lines.push_back("# MAC,ax_bias,ay_bias,az_bias,gx_bias,gy_bias,gz_bias,"
+                        "ax_scale,ay_scale,az_scale,gx_scale,gy_scale,gz_scale\n");
+    }
+    lines.push_back(entry);
+
+    FILE *out = fopen(path, "w");
+    if (out == NULL) {
+        fprintf(stderr, "Calibrate - Cannot write %s\n", path);
+        return false;
+    }
+    for (const std::string &line : lines) {
+        fputs(line.c_str(), out);
+    }
+    fclose(out);
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3) {
+        fprintf(stderr, "Usage: %s <session.csv> <MAC> [calibration.csv]\n", argv[0]);
+        return 1;
+    }
+    unsigned m[6];
+    if (sscanf(argv[2], "%x:%x:%x:%x:%x:%x", &m[0], &m[1], &m[2], &m[3], &m[4], &m[5]) != 6) {
+        fprintf(stderr, "Calibrate - Bad MAC %s (expected AA:BB:CC:DD:EE:FF)\n", argv[2]);
+        return 1;
+    }
+    char mac[18];
+    snprintf(mac, sizeof(mac), "%02X:%02X:%02X:%02X:%02X:%02X", m[0], m[1], m[2], m[3], m[4], m[5]);
+
+    FILE *in = fopen(argv[1], "r");
+    if (in == NULL) {
+        fprintf(stderr, "Calibrate - Cannot open %s\n", argv[1]);
+        return 1;
+    }
+
+    face_t faces[6];
+    memset(faces, 0, sizeof(faces));
+    double window[WINDOW_SAMPLES][6];
+    int filled = 0, windows = 0, still = 0;
+    long samples = 0;
+    char line[256];
+    while (fgets(line, sizeof(line), in) != NULL) {
+        if (!parse_sample(line, window[filled])) {
+            continue;
+        }
+        samples++;
+        if (++filled < WINDOW_SAMPLES) {
+            continue;
+        }
+        filled = 0;
+        windows++;
+
+        double mean[6];
+        int face = classify_window(window, WINDOW_SAMPLES, mean);
+        if (face < 0) {
+            continue;
+        }
+        still++;
+        faces[face].windows++;
+        for (int c = 0; c < 3; c++) {
+            faces[face].accel[c] += mean[c];
+            faces[face].gyro[c] += mean[c + 3];
+        }
+    }
+    fclose(in);
+    printf("Calibrate - %ld samples, %d windows, %d still\n", samples, windows, still);
+
+    bool complete = true;
+    for (int f = 0; f < 6; f++) {
+        printf("Calibrate - %-6s %3d windows\n", FACE_NAMES[f], faces[f].windows);
+        if (faces[f].windows < MIN_WINDOWS_PER_FACE) {
+            complete = false;
+        }
+    }
+    if (!complete) {
+        fprintf(stderr, "Calibrate - Every face needs at least %d still windows (%d samples each)\n",
+                MIN_WINDOWS_PER_FACE, WINDOW_SAMPLES);
+        return 1;
+    }
+
+    double bias[6], scale[6];
+    double gyro_sum[3] = {0};
+    for (int axis = 0; axis < 3; axis++) {
+        const face_t *up = &faces[axis * 2];
+        const face_t *down = &faces[axis * 2 + 1];
+        double u = up->accel[axis] / up->windows;
+        double d = down->accel[axis] / down->windows;
+        bias[axis] = (u + d) / 2.0;
+        scale[axis] = (u - d) / (2.0 * GRAVITY);
+    }
+    for (int f = 0; f < 6; f++) {
+        for (int c = 0; c < 3; c++) {
+            gyro_sum[c] += faces[f].gyro[c];
+        }
+    }
+    for (int c = 0; c < 3; c++) {
+        bias[c + 3] = gyro_sum[c] / still;
+        scale[c + 3] = 1.0;
+    }
+
+    // Residual: |a| per face before and after correction
+    printf("Calibrate - |a| per face, raw -> corrected (m/s^2, ideal %.3f)\n", GRAVITY);
+    for (int f = 0; f < 6; f++) {
+        double raw = 0.0, fixed = 0.0;
+        for (int c = 0; c < 3; c++) {
+            double a = faces[f].accel[c] / faces[f].windows;
+            double corrected = (a - bias[c]) / scale[c];
+            raw += a * a;
+            fixed += corrected * corrected;
+        }
+        printf("Calibrate - %-6s %.3f -> %.3f\n", FACE_NAMES[f], sqrt(raw), sqrt(fixed));
+    }
+
+    char entry[256];
+    snprintf(entry, sizeof(entry), "%s,%.4f,%.4f,%.4f,%.5f,%.5f,%.5f,%.5f,%.5f,%.5f,%.5f,%.5f,%.5f\n",
+             mac, bias[0], bias[1], bias[2], bias[3], bias[4], bias[5],
+             scale[0], scale[1], scale[2], scale[3], scale[4], scale[5]);
+    fputs(entry, stdout);
+
+    if (argc > 3) {
+        if (!update_table(argv[3], mac, entry)) {
+            return 1;
+        }
+        printf("Calibrate - %s written to %s\n", mac, argv[3]);
+    }
+    return 0;
+}
@@ -0,0 +1,62 @@
+// Host Backend Controls - Linux-only extensions of the MPU6050 and OLED HALs
+// The Linux backends (hal/src/linux/) implement hal/mpu6050.h and hal/oled.h
+// without hardware: IMU samples come from a recorded trace or a synthetic
+// generator, and the display renders into an in-memory framebuffer.
+
+#ifndef _HAL_HOST_H_
+#define _HAL_HOST_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Sample timing of the simulated MPU-6050
+typedef enum {
+    MPU6050_HOST_REALTIME = 0,  // Samples become available at the profile rate in wall-clock time
+    MPU6050_HOST_VIRTUAL        // Every read advances the sample clock (runs as fast as possible)
+} mpu6050_host_clock_t;
+
+/**
+ * Replay a recorded trace instead of the synthetic generator
+ * Trace format: one sample per line, "ax,ay,az,gx,gy,gz,temp" in m/s^2,
+ * rad/s and Celsius; lines starting with '#' are ignored. Samples are played
+ * at the active profile rate, converted to raw counts (saturating at the
+ * configured range) and the trace loops at its end. Call before mpu6050_init().
+ * @param path Trace file path
+ * @return true if the trace was loaded, false otherwise
+ */
+bool mpu6050_host_load_trace(const char *path);
+
+/**
+ * Select the synthetic generator (default): gravity on Z and sensor noise,
+ * with a minute of walking-like oscillation every eight minutes and one
+ * fall (free fall, impact, lying still) half an hour into every hour
+ * @param seed Noise seed (same seed, same sample sequence)
+ */
+void mpu6050_host_synthetic(uint32_t seed);
+
+/**
+ * Select the sample clock (default MPU6050_HOST_REALTIME)
+ * @param clock Clock mode
+ */
+void mpu6050_host_set_clock(mpu6050_host_clock_t clock);
+
+/**
+ * Number of samples produced since mpu6050_init()
+ * @return Sample count
+ */
+uint64_t mpu6050_host_sample_count(void);
+
+/**
+ * Write the panel contents (last flushed frame) as a binary PBM image
+ * @param path Output file path
+ * @return true if successful, false otherwise
+ */
+bool oled_host_dump_pbm(const char *path);
+
+/**
+ * Get the panel contents (last flushed frame, SSD1306 page layout)
+ * @return Pointer to OLED_BUFFER_SIZE bytes
+ */
+const uint8_t *oled_host_framebuffer(void);
+
+#endif // _HAL_HOST_H_
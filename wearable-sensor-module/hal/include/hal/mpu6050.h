@@ -5,6 +5,7 @@
 #define _MPU6050_H_
 
 #include <stdbool.h>
+#include <stdint.h>
 
 // Data structure for accelerometer readings
 typedef struct {
@@ -25,12 +26,95 @@ typedef struct {
     float celsius;  // Temperature in Celsius
 } mpu6050_temp_t;
 
+// One complete sample (as produced by the FIFO)
+typedef struct {
+    mpu6050_accel_t accel;
+    mpu6050_gyro_t gyro;
+    mpu6050_temp_t temp;
+} mpu6050_sample_t;
+
+// Raw sensor counts in register order (as read from the sensor)
+typedef struct {
+    int16_t accel_x;
+    int16_t accel_y;
+    int16_t accel_z;
+    int16_t temp;
+    int16_t gyro_x;
+    int16_t gyro_y;
+    int16_t gyro_z;
+} mpu6050_raw_t;
+
+// Conversion from raw counts to SI units for the configured ranges
+// value = raw * scale (+ offset for temperature)
+typedef struct {
+    float accel_scale;  // m/s^2 per LSB
+    float gyro_scale;   // rad/s per LSB
+    float temp_scale;   // Celsius per LSB
+    float temp_offset;  // Celsius at raw 0
+} mpu6050_scale_t;
+
+// Named sensor profiles
+typedef enum {
+    MPU6050_PROFILE_LOW_POWER = 0,  // Idle: +-4g, +-250 deg/s, 10 Hz DLPF, 25 Hz
+    MPU6050_PROFILE_NORMAL,         // Monitoring: +-8g, +-500 deg/s, 44 Hz DLPF, 100 Hz
+    MPU6050_PROFILE_IMPACT,         // Impact capture: +-16g, +-2000 deg/s, 184 Hz DLPF, 500 Hz
+    MPU6050_PROFILE_COUNT
+} mpu6050_profile_t;
+
+// Sensor configuration (one profile)
+typedef struct {
+    uint8_t accel_range_g;      // 2, 4, 8 or 16
+    uint16_t gyro_range_dps;    // 250, 500, 1000 or 2000
+    uint16_t bandwidth_hz;      // DLPF: 260, 184, 94, 44, 21, 10 or 5
+    uint16_t rate_hz;           // Output/FIFO sample rate (4 to 1000 Hz)
+} mpu6050_config_t;
+
+// FIFO capacity of the sensor in samples (1024 bytes / 14 bytes per sample)
+#define MPU6050_FIFO_MAX_SAMPLES 73
+
 /**
  * Initialize the MPU6050 sensor
  * @return true if successful, false otherwise
  */
 bool mpu6050_init(void);
 
+/**
+ * Switch to a named profile
+ * Range, DLPF and sample-rate divider are written in a single I2C burst and
+ * the FIFO (if running) is reset so no sample mixes old and new scales.
+ * Call from the sampling context.
+ * @param profile Profile to apply
+ * @return true if successful, false otherwise
+ */
+bool mpu6050_set_profile(mpu6050_profile_t profile);
+
+/**
+ * Get the active profile
+ * @return Active profile (MPU6050_PROFILE_COUNT if a custom config is applied)
+ */
+mpu6050_profile_t mpu6050_get_profile(void);
+
+/**
+ * Apply a custom configuration (same guarantees as mpu6050_set_profile)
+ * @param config Configuration (values are rounded to the nearest supported setting)
+ * @return true if successful, false otherwise
+ */
+bool mpu6050_configure(const mpu6050_config_t *config);
+
+/**
+ * Get the active configuration
+ * @param config Pointer to store the configuration
+ */
+void mpu6050_get_config(mpu6050_config_t *config);
+
+/**
+ * Pick the lightest profile that delivers a requested sample rate
+ * (used to map CFG_SAMPLING_RATE onto a profile)
+ * @param rate_hz Requested rate (Hz)
+ * @return Profile
+ */
+mpu6050_profile_t mpu6050_profile_for_rate(uint32_t rate_hz);
+
 /**
  * Read accelerometer data from MPU6050
  * @param accel Pointer to store accelerometer data
@@ -61,6 +145,65 @@ bool mpu6050_read_temp(mpu6050_temp_t *temp);
  */
 bool mpu6050_read_all(mpu6050_accel_t *accel, mpu6050_gyro_t *gyro, mpu6050_temp_t *temp);
 
+/**
+ * Read all sensors as raw counts in one I2C transaction (no float work)
+ * @param raw Pointer to store raw counts
+ * @return true if successful, false otherwise
+ */
+bool mpu6050_read_raw(mpu6050_raw_t *raw);
+
+/**
+ * Get the raw-to-SI scale for the current configuration
+ * The descriptor changes only when the sensor ranges change.
+ * @param scale Pointer to store the scale descriptor
+ * @return true if successful, false otherwise
+ */
+bool mpu6050_get_scale(mpu6050_scale_t *scale);
+
+/**
+ * Convert an array of raw samples to SI units in one pass
+ * @param raw Input raw samples
+ * @param out Output samples
+ * @param count Number of samples
+ * @param scale Scale descriptor captured when the samples were read
+ */
+void mpu6050_convert(const mpu6050_raw_t *raw, mpu6050_sample_t *out, int count,
+                     const mpu6050_scale_t *scale);
+
+/**
+ * Start FIFO mode: the sensor samples accel, temperature and gyro at a fixed
+ * rate into its internal 1 KB FIFO, to be drained with mpu6050_fifo_read()
+ * @param rate_hz Sample rate (4 to 1000 Hz, rounded to the nearest divider),
+ *                or 0 to keep the active profile's rate
+ * @return true if successful, false otherwise
+ */
+bool mpu6050_fifo_start(uint16_t rate_hz);
+
+/**
+ * Drain buffered samples from the FIFO using burst I2C reads
+ * On overflow the FIFO is reset (its contents are misaligned) and no samples
+ * are returned; call at least every MPU6050_FIFO_MAX_SAMPLES / rate_hz seconds.
+ * @param samples Output array
+ * @param max_samples Capacity of 'samples'
+ * @param overflow Set to true if the FIFO overflowed since the last read (may be NULL)
+ * @return Number of samples read, or -1 on error
+ */
+int mpu6050_fifo_read(mpu6050_sample_t *samples, int max_samples, bool *overflow);
+
+/**
+ * Drain buffered samples from the FIFO as raw counts (see mpu6050_fifo_read)
+ * @param raw Output array
+ * @param max_samples Capacity of 'raw'
+ * @param overflow Set to true if the FIFO overflowed since the last read (may be NULL)
+ * @return Number of samples read, or -1 on error
+ */
+int mpu6050_fifo_read_raw(mpu6050_raw_t *raw, int max_samples, bool *overflow);
+
+/**
+ * Stop FIFO mode
+ */
+void mpu6050_fifo_stop(void);
+
 /**
  * Cleanup and release MPU6050 resources
  */
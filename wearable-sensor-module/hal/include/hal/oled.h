@@ -1,5 +1,9 @@
 // OLED Display Hardware Abstraction Layer
 // Provides interface for displaying text and graphics on OLED screen
+// Drawing goes to a back buffer; oled_display() publishes a copy to a flush
+// task pinned to the other core, which transfers only the columns of each
+// 8-pixel page that changed since the previous flush. Callers never block on
+// display I/O.
 
 #ifndef _OLED_H_
 #define _OLED_H_
@@ -11,6 +15,23 @@
 #define OLED_WIDTH  128
 #define OLED_HEIGHT 64
 
+// Framebuffer size (one bit per pixel, 8-pixel pages)
+#define OLED_PAGES (OLED_HEIGHT / 8)
+#define OLED_BUFFER_SIZE (OLED_WIDTH * OLED_PAGES)
+
+// Flush task placement (loop() and the sampler run on core 1)
+#define OLED_FLUSH_TASK_CORE 0
+#define OLED_FLUSH_TASK_PRIORITY 1
+
+// Transfer statistics
+typedef struct {
+    uint32_t frames;            // Frames flushed to the panel
+    uint32_t frames_dropped;    // Frames replaced by a newer one before being flushed
+    uint32_t last_frame_bytes;  // I2C bytes sent for the last flushed frame
+    uint32_t last_dirty_pages;  // Pages refreshed in the last flushed frame
+    uint32_t total_bytes;       // I2C bytes sent since oled_init()
+} oled_stats_t;
+
 // Text sizes
 typedef enum {
     OLED_TEXT_SIZE_SMALL = 1,   // 6x8 pixels per character
@@ -31,10 +52,34 @@ void oled_clear(void);
 
 /**
  * Update the display with buffered content
- * Must be called after drawing operations to see changes
+ * Must be called after drawing operations to see changes. Copies the back
+ * buffer (1 KB memcpy) and returns; the flush task sends only the changed
+ * column span of each page, so an unchanged frame costs no I2C traffic. If
+ * frames are published faster than the panel accepts them, only the newest
+ * is flushed.
  */
 void oled_display(void);
 
+/**
+ * Force the next oled_display() to send the whole framebuffer
+ * (e.g. after the panel was reset or written by other code)
+ */
+void oled_invalidate(void);
+
+/**
+ * Set panel brightness (SSD1306 contrast)
+ * Applied by the flush task before its next frame, so it never blocks the
+ * caller or interleaves with a frame transfer.
+ * @param level Brightness (0 = dimmest, 255 = brightest)
+ */
+void oled_set_brightness(uint8_t level);
+
+/**
+ * Get transfer statistics
+ * @param stats Pointer to store the statistics
+ */
+void oled_get_stats(oled_stats_t *stats);
+
 /**
  * Set cursor position for text
  * @param x X coordinate (0 to OLED_WIDTH-1)
@@ -93,6 +138,15 @@ void oled_draw_vline(uint8_t x, uint8_t y, uint8_t height);
  */
 void oled_draw_rect(uint8_t x, uint8_t y, uint8_t width, uint8_t height, bool fill);
 
+/**
+ * Clear a rectangular area (set pixels off)
+ * @param x X coordinate of top-left corner
+ * @param y Y coordinate of top-left corner
+ * @param width Width of area
+ * @param height Height of area
+ */
+void oled_clear_rect(uint8_t x, uint8_t y, uint8_t width, uint8_t height);
+
 /**
  * Cleanup and release OLED resources
  */
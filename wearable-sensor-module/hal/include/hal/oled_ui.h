@@ -0,0 +1,130 @@
+// OLED Status UI - Retained-mode widgets on top of the OLED HAL
+// Widgets (labels, numeric fields, progress bars) keep the value they last
+// rendered. Setting a value that looks the same at display precision costs a
+// comparison; only widgets whose displayed text or bar length changed are
+// re-formatted and redrawn, and redraws are rate-limited independently of how
+// often values are set. Text is clipped to the field width (6 px per character).
+
+#ifndef _OLED_UI_H_
+#define _OLED_UI_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Maximum number of widgets on screen
+#define OLED_UI_MAX_WIDGETS 16
+
+// Longest widget text (one full line of small text)
+#define OLED_UI_TEXT_SIZE 22
+
+// Rendering statistics
+typedef struct {
+    uint32_t refreshes;         // oled_ui_refresh() calls that redrew something
+    uint32_t widgets_drawn;     // Widgets re-rendered
+    uint32_t updates;           // Value updates received
+    uint32_t updates_unchanged; // Updates skipped (same at display precision)
+} oled_ui_stats_t;
+
+/**
+ * Initialize the widget layer (oled_init() must have succeeded)
+ * @param min_refresh_ms Minimum time between two screen refreshes
+ * @return true if successful, false otherwise
+ */
+bool oled_ui_init(uint32_t min_refresh_ms);
+
+/**
+ * Remove all widgets and clear the screen
+ */
+void oled_ui_clear(void);
+
+/**
+ * Add a static or updatable text label (small text, one line)
+ * @param x X coordinate
+ * @param y Y coordinate
+ * @param width Field width in pixels (cleared on redraw)
+ * @param text Initial text
+ * @return Widget id, or -1 if no widget slot is free
+ */
+int oled_ui_add_label(uint8_t x, uint8_t y, uint8_t width, const char *text);
+
+/**
+ * Add a numeric field showing a float
+ * @param x X coordinate
+ * @param y Y coordinate
+ * @param width Field width in pixels
+ * @param format printf format for one float (e.g. "%5.1f")
+ * @param resolution Smallest displayed step (e.g. 0.1 for "%.1f")
+ * @return Widget id, or -1 if no widget slot is free
+ */
+int oled_ui_add_number(uint8_t x, uint8_t y, uint8_t width, const char *format, float resolution);
+
+/**
+ * Add a numeric field showing an integer counter
+ * @param x X coordinate
+ * @param y Y coordinate
+ * @param width Field width in pixels
+ * @param format printf format for one long (e.g. "%lu")
+ * @return Widget id, or -1 if no widget slot is free
+ */
+int oled_ui_add_counter(uint8_t x, uint8_t y, uint8_t width, const char *format);
+
+/**
+ * Add a horizontal progress bar (outline with 0-100% fill)
+ * @param x X coordinate
+ * @param y Y coordinate
+ * @param width Width in pixels
+ * @param height Height in pixels
+ * @return Widget id, or -1 if no widget slot is free
+ */
+int oled_ui_add_bar(uint8_t x, uint8_t y, uint8_t width, uint8_t height);
+
+/**
+ * Set a label's text
+ * @param id Label id
+ * @param text New text
+ */
+void oled_ui_set_text(int id, const char *text);
+
+/**
+ * Set a numeric field's value
+ * @param id Number id
+ * @param value New value
+ */
+void oled_ui_set_number(int id, float value);
+
+/**
+ * Set a counter's value
+ * @param id Counter id
+ * @param value New value
+ */
+void oled_ui_set_counter(int id, uint32_t value);
+
+/**
+ * Set a progress bar's fill
+ * @param id Bar id
+ * @param percent Fill (clamped to 0-100)
+ */
+void oled_ui_set_percent(int id, int percent);
+
+/**
+ * Show or hide a widget (hidden widgets leave their area blank)
+ * @param id Widget id
+ * @param visible true to show
+ */
+void oled_ui_set_visible(int id, bool visible);
+
+/**
+ * Redraw changed widgets and flush the display, at most once per
+ * min_refresh_ms
+ * @param now_ms Current time (ms)
+ * @return true if the screen was updated
+ */
+bool oled_ui_refresh(uint32_t now_ms);
+
+/**
+ * Get rendering statistics
+ * @param stats Pointer to store the statistics
+ */
+void oled_ui_get_stats(oled_ui_stats_t *stats);
+
+#endif // _OLED_UI_H_
@@ -0,0 +1,80 @@
+// Sampler Hardware Abstraction Layer
+// Fixed-rate IMU sampling decoupled from display and radio work. A hardware
+// timer wakes a dedicated high-priority task that reads the MPU-6050 and
+// pushes timestamped samples into a single-producer/single-consumer ring
+// buffer, so the sample period no longer depends on how long loop() spends
+// drawing the OLED or sending packets.
+
+#ifndef _SAMPLER_H_
+#define _SAMPLER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "hal/mpu6050.h"
+
+// Ring buffer capacity in samples (power of two; ~2.5 s at 100 Hz)
+#define SAMPLER_RING_SIZE 256
+
+// Sampling task priority and core (loop() runs at priority 1 on core 1)
+#define SAMPLER_TASK_PRIORITY 5
+#define SAMPLER_TASK_CORE 1
+
+// One timestamped sample
+typedef struct {
+    mpu6050_sample_t data;
+    uint32_t time_us;           // Timer tick that triggered the read (micros())
+} sampler_sample_t;
+
+// Sampling statistics
+typedef struct {
+    uint32_t rate_hz;           // Active sample rate
+    uint32_t samples;           // Samples pushed into the ring
+    uint32_t ring_overruns;     // Samples dropped because the consumer fell behind
+    uint32_t missed_ticks;      // Timer ticks with no read (task was late)
+    uint32_t read_errors;       // Failed I2C reads
+    uint32_t max_latency_us;    // Worst delay from timer tick to completed read
+} sampler_stats_t;
+
+/**
+ * Start fixed-rate sampling at the active MPU-6050 profile rate
+ * mpu6050_init() must have succeeded. After this call only the sampling task
+ * touches the sensor; use sampler_set_profile() to change its configuration.
+ * @return true if successful, false otherwise
+ */
+bool sampler_start(void);
+
+/**
+ * Request an MPU-6050 profile change
+ * Applied by the sampling task between two reads, and the timer period is
+ * retuned to the new profile rate, so no sample is read with one scale and
+ * converted with another.
+ * @param profile Profile to apply
+ */
+void sampler_set_profile(mpu6050_profile_t profile);
+
+/**
+ * Pop the oldest buffered samples (consumer side, e.g. loop())
+ * @param out Output array
+ * @param max Capacity of 'out'
+ * @return Number of samples copied
+ */
+int sampler_read(sampler_sample_t *out, int max);
+
+/**
+ * Number of samples waiting in the ring
+ * @return Sample count
+ */
+int sampler_available(void);
+
+/**
+ * Get sampling statistics
+ * @param stats Pointer to store the statistics
+ */
+void sampler_get_stats(sampler_stats_t *stats);
+
+/**
+ * Stop the timer and the sampling task
+ */
+void sampler_stop(void);
+
+#endif // _SAMPLER_H_
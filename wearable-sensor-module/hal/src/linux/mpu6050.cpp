@@ -0,0 +1,513 @@
+// MPU6050 Hardware Abstraction Layer - Linux Implementation
+// Replays a recorded trace or a synthetic signal at the active profile rate.
+#include "hal/mpu6050.h"
+#include "hal/host.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define GRAVITY 9.80665f
+#define DEG_TO_RAD_F 0.017453292f
+#define TRACE_FIELDS 7          // ax, ay, az, gx, gy, gz, temp
+#define SYNTH_PERIOD_S 480      // Synthetic day: walk for SYNTH_WALK_S of every period
+#define SYNTH_WALK_S 60
+#define SYNTH_FALL_PERIOD_MS 3600000    // One fall per hour, SYNTH_FALL_MS into it
+#define SYNTH_FALL_MS 1800000
+
+static bool is_initialized = false;
+static bool fifo_enabled = false;
+static mpu6050_scale_t current_scale;
+static mpu6050_config_t active_config;
+static mpu6050_profile_t active_profile = MPU6050_PROFILE_COUNT;
+
+static const mpu6050_config_t PROFILES[MPU6050_PROFILE_COUNT] = {
+    {4, 250, 10, 25},       // MPU6050_PROFILE_LOW_POWER
+    {8, 500, 44, 100},      // MPU6050_PROFILE_NORMAL
+    {16, 2000, 184, 500},   // MPU6050_PROFILE_IMPACT
+};
+
+// DLPF_CFG 0..6 bandwidths (Hz)
+static const uint16_t DLPF_BANDWIDTHS[7] = {260, 184, 94, 44, 21, 10, 5};
+
+// Sample source
+static float *trace = NULL;             // TRACE_FIELDS floats per sample
+static uint32_t trace_length = 0;
+static uint32_t noise_state = 1;
+static mpu6050_host_clock_t sample_clock = MPU6050_HOST_REALTIME;
+
+// Sample clock: 'produced' samples exist; in realtime mode the count grows
+// with wall-clock time since 'epoch_ns' (rebased on rate changes)
+static uint64_t produced = 0;
+static uint64_t epoch_count = 0;
+static uint64_t epoch_ns = 0;
+static mpu6050_raw_t latest;
+
+// Simulated 1 KB sensor FIFO
+static mpu6050_raw_t fifo[MPU6050_FIFO_MAX_SAMPLES];
+static int fifo_head = 0;
+static int fifo_count = 0;
+static bool fifo_overflow = false;
+
+static uint64_t monotonic_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// Uniform noise in [-1, 1]
+static float noise(void)
+{
+    noise_state ^= noise_state << 13;
+    noise_state ^= noise_state >> 17;
+    noise_state ^= noise_state << 5;
+    return (float)(noise_state & 0xFFFF) / 32767.5f - 1.0f;
+}
+
+static int16_t to_raw(float value, float scale)
+{
+    float counts = roundf(value / scale);
+    if (counts > 32767.0f) return 32767;
+    if (counts < -32768.0f) return -32768;
+    return (int16_t)counts;
+}
+
+// Produce sample number 'n' as raw counts at the current scale
+static void generate(uint64_t n, mpu6050_raw_t *raw)
+{
+    float v[TRACE_FIELDS];
+
+    if (trace != NULL) {
+        memcpy(v, &trace[(n % trace_length) * TRACE_FIELDS], sizeof(v));
+    } else {
+        // Walking at 1.8 steps/s with sway, then resting, plus sensor noise
+        float t = (float)n / (float)active_config.rate_hz;
+        float walking = ((n / active_config.rate_hz) % SYNTH_PERIOD_S < SYNTH_WALK_S) ? 1.0f : 0.0f;
+        float step = walking * sinf(2.0f * (float)M_PI * 1.8f * t);
+        float sway = walking * sinf(2.0f * (float)M_PI * 0.9f * t);
+        v[0] = 0.8f * step + 0.05f * noise();
+        v[1] = 0.3f * sway + 0.05f * noise();
+        v[2] = GRAVITY + walking * 1.2f * sinf(2.0f * (float)M_PI * 1.8f * t + 0.5f) + 0.05f * noise();
+        v[3] = 0.3f * sway + 0.01f * noise();
+        v[4] = 0.2f * step + 0.01f * noise();
+        v[5] = 0.01f * noise();
+        v[6] = 31.0f + 0.05f * noise();
+
+        // Fall: 400 ms free fall, 50 ms impact, then two minutes lying on the side
+        uint64_t fall_ms = n * 1000 / active_config.rate_hz % SYNTH_FALL_PERIOD_MS;
+        if (fall_ms >= SYNTH_FALL_MS && fall_ms < SYNTH_FALL_MS + 400) {
+            v[0] = 0.5f + 0.05f * noise();
+            v[1] = 0.3f + 0.05f * noise();
+            v[2] = 0.8f + 0.05f * noise();
+            v[3] = 3.0f + 0.1f * noise();
+            v[4] = 1.5f + 0.1f * noise();
+        } else if (fall_ms >= SYNTH_FALL_MS + 400 && fall_ms < SYNTH_FALL_MS + 450) {
+            v[0] = 25.0f + 1.0f * noise();
+            v[1] = 5.0f + 1.0f * noise();
+            v[2] = 30.0f + 1.0f * noise();
+            v[3] = -4.0f + 0.2f * noise();
+            v[4] = 2.0f + 0.2f * noise();
+        } else if (fall_ms >= SYNTH_FALL_MS + 450 && fall_ms < SYNTH_FALL_MS + 120000) {
+            v[0] = GRAVITY + 0.05f * noise();
+            v[1] = 0.05f * noise();
+            v[2] = 0.05f * noise();
+            v[3] = 0.01f * noise();
+            v[4] = 0.01f * noise();
+        }
+    }
+
+    raw->accel_x = to_raw(v[0], current_scale.accel_scale);
+    raw->accel_y = to_raw(v[1], current_scale.accel_scale);
+    raw->accel_z = to_raw(v[2], current_scale.accel_scale);
+    raw->gyro_x = to_raw(v[3], current_scale.gyro_scale);
+    raw->gyro_y = to_raw(v[4], current_scale.gyro_scale);
+    raw->gyro_z = to_raw(v[5], current_scale.gyro_scale);
+    raw->temp = to_raw(v[6] - current_scale.temp_offset, current_scale.temp_scale);
+}
+
+// Generate samples up to 'target', feeding the FIFO like the sensor would
+static void advance_to(uint64_t target)
+{
+    while (produced < target) {
+        generate(produced++, &latest);
+        if (!fifo_enabled) {
+            continue;
+        }
+        if (fifo_count == MPU6050_FIFO_MAX_SAMPLES) {
+            fifo_overflow = true;
+            fifo_head = (fifo_head + 1) % MPU6050_FIFO_MAX_SAMPLES;
+            fifo_count--;
+        }
+        fifo[(fifo_head + fifo_count) % MPU6050_FIFO_MAX_SAMPLES] = latest;
+        fifo_count++;
+    }
+}
+
+// Bring the realtime sample clock up to date
+static void advance_realtime(void)
+{
+    if (sample_clock != MPU6050_HOST_REALTIME) {
+        return;
+    }
+    uint64_t elapsed = monotonic_ns() - epoch_ns;
+    advance_to(epoch_count + elapsed * active_config.rate_hz / 1000000000ULL);
+}
+
+static void rebase_clock(void)
+{
+    advance_realtime();
+    epoch_count = produced;
+    epoch_ns = monotonic_ns();
+}
+
+static uint8_t full_scale_select(uint32_t value, uint32_t base)
+{
+    uint8_t sel = 0;
+    while (sel < 3 && (base << sel) < value) {
+        sel++;
+    }
+    return sel;
+}
+
+static uint8_t dlpf_select(uint16_t bandwidth_hz)
+{
+    uint8_t best = 0;
+    for (uint8_t i = 1; i < 7; i++) {
+        if (abs((int)DLPF_BANDWIDTHS[i] - (int)bandwidth_hz) <
+            abs((int)DLPF_BANDWIDTHS[best] - (int)bandwidth_hz)) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+// Same rounding rules as the sensor registers on the device
+static bool apply_config(const mpu6050_config_t *config)
+{
+    uint8_t accel_sel = full_scale_select(config->accel_range_g, 2);
+    uint8_t gyro_sel = full_scale_select(config->gyro_range_dps, 250);
+    uint8_t dlpf = dlpf_select(config->bandwidth_hz);
+
+    uint32_t base_hz = (dlpf == 0) ? 8000 : 1000;
+    uint32_t rate_hz = (config->rate_hz > 0) ? config->rate_hz : 1;
+    uint32_t divider = (base_hz + rate_hz / 2) / rate_hz;
+    if (divider < 1) divider = 1;
+    if (divider > 256) divider = 256;
+
+    rebase_clock();
+
+    active_config.accel_range_g = (uint8_t)(2 << accel_sel);
+    active_config.gyro_range_dps = (uint16_t)(250 << gyro_sel);
+    active_config.bandwidth_hz = DLPF_BANDWIDTHS[dlpf];
+    active_config.rate_hz = (uint16_t)(base_hz / divider);
+
+    current_scale.accel_scale = GRAVITY / (float)(16384 >> accel_sel);
+    current_scale.gyro_scale = DEG_TO_RAD_F / (131.0f / (float)(1 << gyro_sel));
+    current_scale.temp_scale = 1.0f / 340.0f;
+    current_scale.temp_offset = 36.53f;
+
+    fifo_head = 0;
+    fifo_count = 0;
+    fifo_overflow = false;
+    return true;
+}
+
+bool mpu6050_host_load_trace(const char *path)
+{
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        printf("MPU6050 - Cannot open trace %s\n", path);
+        return false;
+    }
+
+    free(trace);
+    trace = NULL;
+    trace_length = 0;
+    uint32_t capacity = 0;
+
+    char line[256];
+    while (fgets(line, sizeof(line), file) != NULL) {
+        float v[TRACE_FIELDS];
+        if (line[0] == '#' ||
+            sscanf(line, "%f,%f,%f,%f,%f,%f,%f", &v[0], &v[1], &v[2], &v[3], &v[4], &v[5],
+                   &v[6]) != TRACE_FIELDS) {
+            continue;
+        }
+        if (trace_length == capacity) {
+            capacity = (capacity > 0) ? capacity * 2 : 1024;
+            float *grown = (float *)realloc(trace, capacity * TRACE_FIELDS * sizeof(float));
+            if (grown == NULL) {
+                break;
+            }
+            trace = grown;
+        }
+        memcpy(&trace[trace_length * TRACE_FIELDS], v, sizeof(v));
+        trace_length++;
+    }
+    fclose(file);
+
+    if (trace_length == 0) {
+        printf("MPU6050 - Trace %s has no samples\n", path);
+        free(trace);
+        trace = NULL;
+        return false;
+    }
+    printf("MPU6050 - Loaded %u trace samples from %s\n", (unsigned)trace_length, path);
+    return true;
+}
+
+void mpu6050_host_synthetic(uint32_t seed)
+{
+    free(trace);
+    trace = NULL;
+    trace_length = 0;
+    noise_state = (seed != 0) ? seed : 1;
+}
+
+void mpu6050_host_set_clock(mpu6050_host_clock_t clock)
+{
+    rebase_clock();
+    sample_clock = clock;
+}
+
+uint64_t mpu6050_host_sample_count(void)
+{
+    return produced;
+}
+
+bool mpu6050_init(void)
+{
+    printf("MPU6050 - Initializing (%s)\n", trace != NULL ? "trace replay" : "synthetic");
+
+    if (is_initialized) {
+        printf("MPU6050 - Already initialized\n");
+        return false;
+    }
+
+    produced = 0;
+    fifo_enabled = false;
+    is_initialized = true;
+    mpu6050_set_profile(MPU6050_PROFILE_NORMAL);
+
+    printf("MPU6050 - Initialized successfully\n");
+    return true;
+}
+
+bool mpu6050_set_profile(mpu6050_profile_t profile)
+{
+    if (!is_initialized || profile >= MPU6050_PROFILE_COUNT) {
+        return false;
+    }
+    apply_config(&PROFILES[profile]);
+    active_profile = profile;
+    return true;
+}
+
+mpu6050_profile_t mpu6050_get_profile(void)
+{
+    return active_profile;
+}
+
+bool mpu6050_configure(const mpu6050_config_t *config)
+{
+    if (!is_initialized || config == NULL) {
+        return false;
+    }
+    apply_config(config);
+    active_profile = MPU6050_PROFILE_COUNT;
+    return true;
+}
+
+void mpu6050_get_config(mpu6050_config_t *config)
+{
+    if (config != NULL) {
+        *config = active_config;
+    }
+}
+
+mpu6050_profile_t mpu6050_profile_for_rate(uint32_t rate_hz)
+{
+    for (int p = 0; p < MPU6050_PROFILE_COUNT; p++) {
+        if (PROFILES[p].rate_hz >= rate_hz) {
+            return (mpu6050_profile_t)p;
+        }
+    }
+    return MPU6050_PROFILE_IMPACT;
+}
+
+bool mpu6050_read_raw(mpu6050_raw_t *raw)
+{
+    if (!is_initialized || raw == NULL) {
+        return false;
+    }
+
+    if (sample_clock == MPU6050_HOST_VIRTUAL) {
+        advance_to(produced + 1);
+    } else {
+        advance_realtime();
+        if (produced == 0) {
+            advance_to(1);
+        }
+    }
+    *raw = latest;
+    return true;
+}
+
+bool mpu6050_read_all(mpu6050_accel_t *accel, mpu6050_gyro_t *gyro, mpu6050_temp_t *temp)
+{
+    if (accel == NULL || gyro == NULL || temp == NULL) {
+        return false;
+    }
+
+    mpu6050_raw_t raw;
+    if (!mpu6050_read_raw(&raw)) {
+        return false;
+    }
+
+    mpu6050_sample_t sample;
+    mpu6050_convert(&raw, &sample, 1, &current_scale);
+    *accel = sample.accel;
+    *gyro = sample.gyro;
+    *temp = sample.temp;
+    return true;
+}
+
+bool mpu6050_read_accel(mpu6050_accel_t *accel)
+{
+    mpu6050_gyro_t gyro;
+    mpu6050_temp_t temp;
+    return mpu6050_read_all(accel, &gyro, &temp);
+}
+
+bool mpu6050_read_gyro(mpu6050_gyro_t *gyro)
+{
+    mpu6050_accel_t accel;
+    mpu6050_temp_t temp;
+    return mpu6050_read_all(&accel, gyro, &temp);
+}
+
+bool mpu6050_read_temp(mpu6050_temp_t *temp)
+{
+    mpu6050_accel_t accel;
+    mpu6050_gyro_t gyro;
+    return mpu6050_read_all(&accel, &gyro, temp);
+}
+
+bool mpu6050_get_scale(mpu6050_scale_t *scale)
+{
+    if (!is_initialized || scale == NULL) {
+        return false;
+    }
+
+    *scale = current_scale;
+    return true;
+}
+
+void mpu6050_convert(const mpu6050_raw_t *raw, mpu6050_sample_t *out, int count,
+                     const mpu6050_scale_t *scale)
+{
+    const float as = scale->accel_scale;
+    const float gs = scale->gyro_scale;
+    const float ts = scale->temp_scale;
+    const float to = scale->temp_offset;
+
+    for (int i = 0; i < count; i++) {
+        out[i].accel.x = raw[i].accel_x * as;
+        out[i].accel.y = raw[i].accel_y * as;
+        out[i].accel.z = raw[i].accel_z * as;
+        out[i].gyro.x = raw[i].gyro_x * gs;
+        out[i].gyro.y = raw[i].gyro_y * gs;
+        out[i].gyro.z = raw[i].gyro_z * gs;
+        out[i].temp.celsius = raw[i].temp * ts + to;
+    }
+}
+
+bool mpu6050_fifo_start(uint16_t rate_hz)
+{
+    if (!is_initialized) {
+        return false;
+    }
+
+    if (rate_hz != 0 && rate_hz != active_config.rate_hz) {
+        mpu6050_config_t config = active_config;
+        config.rate_hz = rate_hz;
+        apply_config(&config);
+        active_profile = MPU6050_PROFILE_COUNT;
+    }
+
+    rebase_clock();
+    fifo_head = 0;
+    fifo_count = 0;
+    fifo_overflow = false;
+    fifo_enabled = true;
+    printf("MPU6050 - FIFO started at %u Hz\n", active_config.rate_hz);
+    return true;
+}
+
+int mpu6050_fifo_read_raw(mpu6050_raw_t *raw, int max_samples, bool *overflow)
+{
+    if (!is_initialized || !fifo_enabled || raw == NULL) {
+        return -1;
+    }
+    if (overflow != NULL) {
+        *overflow = false;
+    }
+
+    if (sample_clock == MPU6050_HOST_VIRTUAL) {
+        int wanted = (max_samples < MPU6050_FIFO_MAX_SAMPLES) ? max_samples : MPU6050_FIFO_MAX_SAMPLES;
+        if (fifo_count < wanted) {
+            advance_to(produced + (wanted - fifo_count));
+        }
+    } else {
+        advance_realtime();
+    }
+
+    if (fifo_overflow) {
+        // The device loses frame alignment and resets; do the same
+        fifo_head = 0;
+        fifo_count = 0;
+        fifo_overflow = false;
+        if (overflow != NULL) {
+            *overflow = true;
+        }
+        return 0;
+    }
+
+    int count = (fifo_count < max_samples) ? fifo_count : max_samples;
+    for (int i = 0; i < count; i++) {
+        raw[i] = fifo[(fifo_head + i) % MPU6050_FIFO_MAX_SAMPLES];
+    }
+    fifo_head = (fifo_head + count) % MPU6050_FIFO_MAX_SAMPLES;
+    fifo_count -= count;
+    return count;
+}
+
+int mpu6050_fifo_read(mpu6050_sample_t *samples, int max_samples, bool *overflow)
+{
+    if (samples == NULL) {
+        return -1;
+    }
+
+    mpu6050_raw_t raw[MPU6050_FIFO_MAX_SAMPLES];
+    int limit = (max_samples < MPU6050_FIFO_MAX_SAMPLES) ? max_samples : MPU6050_FIFO_MAX_SAMPLES;
+    int count = mpu6050_fifo_read_raw(raw, limit, overflow);
+    if (count > 0) {
+        mpu6050_convert(raw, samples, count, &current_scale);
+    }
+    return count;
+}
+
+void mpu6050_fifo_stop(void)
+{
+    fifo_enabled = false;
+    fifo_count = 0;
+}
+
+void mpu6050_cleanup(void)
+{
+    printf("MPU6050 - Cleanup\n");
+    mpu6050_fifo_stop();
+    is_initialized = false;
+}
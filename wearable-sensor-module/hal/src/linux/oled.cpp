@@ -0,0 +1,310 @@
+// OLED Display Hardware Abstraction Layer - Linux Implementation
+// Renders into an in-memory SSD1306-layout framebuffer with the same 6x8
+// character cell as the device, and tracks the same dirty-region transfer
+// statistics a real flush would produce.
+#include "hal/oled.h"
+#include "hal/host.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#define CHAR_WIDTH 6
+#define CHAR_HEIGHT 8
+#define FONT_FIRST 0x20
+#define FONT_LAST 0x7E
+
+// Classic 5x7 font, one byte per column, LSB at the top (ASCII 0x20-0x7E)
+static const uint8_t FONT[FONT_LAST - FONT_FIRST + 1][5] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00}, {0x00, 0x00, 0x5F, 0x00, 0x00}, {0x00, 0x07, 0x00, 0x07, 0x00},
+    {0x14, 0x7F, 0x14, 0x7F, 0x14}, {0x24, 0x2A, 0x7F, 0x2A, 0x12}, {0x23, 0x13, 0x08, 0x64, 0x62},
+    {0x36, 0x49, 0x55, 0x22, 0x50}, {0x00, 0x05, 0x03, 0x00, 0x00}, {0x00, 0x1C, 0x22, 0x41, 0x00},
+    {0x00, 0x41, 0x22, 0x1C, 0x00}, {0x14, 0x08, 0x3E, 0x08, 0x14}, {0x08, 0x08, 0x3E, 0x08, 0x08},
+    {0x00, 0x50, 0x30, 0x00, 0x00}, {0x08, 0x08, 0x08, 0x08, 0x08}, {0x00, 0x60, 0x60, 0x00, 0x00},
+    {0x20, 0x10, 0x08, 0x04, 0x02}, {0x3E, 0x51, 0x49, 0x45, 0x3E}, {0x00, 0x42, 0x7F, 0x40, 0x00},
+    {0x42, 0x61, 0x51, 0x49, 0x46}, {0x21, 0x41, 0x45, 0x4B, 0x31}, {0x18, 0x14, 0x12, 0x7F, 0x10},
+    {0x27, 0x45, 0x45, 0x45, 0x39}, {0x3C, 0x4A, 0x49, 0x49, 0x30}, {0x01, 0x71, 0x09, 0x05, 0x03},
+    {0x36, 0x49, 0x49, 0x49, 0x36}, {0x06, 0x49, 0x49, 0x29, 0x1E}, {0x00, 0x36, 0x36, 0x00, 0x00},
+    {0x00, 0x56, 0x36, 0x00, 0x00}, {0x08, 0x14, 0x22, 0x41, 0x00}, {0x14, 0x14, 0x14, 0x14, 0x14},
+    {0x00, 0x41, 0x22, 0x14, 0x08}, {0x02, 0x01, 0x51, 0x09, 0x06}, {0x32, 0x49, 0x79, 0x41, 0x3E},
+    {0x7E, 0x11, 0x11, 0x11, 0x7E}, {0x7F, 0x49, 0x49, 0x49, 0x36}, {0x3E, 0x41, 0x41, 0x41, 0x22},
+    {0x7F, 0x41, 0x41, 0x22, 0x1C}, {0x7F, 0x49, 0x49, 0x49, 0x41}, {0x7F, 0x09, 0x09, 0x09, 0x01},
+    {0x3E, 0x41, 0x49, 0x49, 0x7A}, {0x7F, 0x08, 0x08, 0x08, 0x7F}, {0x00, 0x41, 0x7F, 0x41, 0x00},
+    {0x20, 0x40, 0x41, 0x3F, 0x01}, {0x7F, 0x08, 0x14, 0x22, 0x41}, {0x7F, 0x40, 0x40, 0x40, 0x40},
+    {0x7F, 0x02, 0x0C, 0x02, 0x7F}, {0x7F, 0x04, 0x08, 0x10, 0x7F}, {0x3E, 0x41, 0x41, 0x41, 0x3E},
+    {0x7F, 0x09, 0x09, 0x09, 0x06}, {0x3E, 0x41, 0x51, 0x21, 0x5E}, {0x7F, 0x09, 0x19, 0x29, 0x46},
+    {0x46, 0x49, 0x49, 0x49, 0x31}, {0x01, 0x01, 0x7F, 0x01, 0x01}, {0x3F, 0x40, 0x40, 0x40, 0x3F},
+    {0x1F, 0x20, 0x40, 0x20, 0x1F}, {0x3F, 0x40, 0x38, 0x40, 0x3F}, {0x63, 0x14, 0x08, 0x14, 0x63},
+    {0x07, 0x08, 0x70, 0x08, 0x07}, {0x61, 0x51, 0x49, 0x45, 0x43}, {0x00, 0x7F, 0x41, 0x41, 0x00},
+    {0x02, 0x04, 0x08, 0x10, 0x20}, {0x00, 0x41, 0x41, 0x7F, 0x00}, {0x04, 0x02, 0x01, 0x02, 0x04},
+    {0x40, 0x40, 0x40, 0x40, 0x40}, {0x00, 0x01, 0x02, 0x04, 0x00}, {0x20, 0x54, 0x54, 0x54, 0x78},
+    {0x7F, 0x48, 0x44, 0x44, 0x38}, {0x38, 0x44, 0x44, 0x44, 0x20}, {0x38, 0x44, 0x44, 0x48, 0x7F},
+    {0x38, 0x54, 0x54, 0x54, 0x18}, {0x08, 0x7E, 0x09, 0x01, 0x02}, {0x0C, 0x52, 0x52, 0x52, 0x3E},
+    {0x7F, 0x08, 0x04, 0x04, 0x78}, {0x00, 0x44, 0x7D, 0x40, 0x00}, {0x20, 0x40, 0x44, 0x3D, 0x00},
+    {0x7F, 0x10, 0x28, 0x44, 0x00}, {0x00, 0x41, 0x7F, 0x40, 0x00}, {0x7C, 0x04, 0x18, 0x04, 0x78},
+    {0x7C, 0x08, 0x04, 0x04, 0x78}, {0x38, 0x44, 0x44, 0x44, 0x38}, {0x7C, 0x14, 0x14, 0x14, 0x08},
+    {0x08, 0x14, 0x14, 0x18, 0x7C}, {0x7C, 0x08, 0x04, 0x04, 0x08}, {0x48, 0x54, 0x54, 0x54, 0x20},
+    {0x04, 0x3F, 0x44, 0x40, 0x20}, {0x3C, 0x40, 0x40, 0x20, 0x7C}, {0x1C, 0x20, 0x40, 0x20, 0x1C},
+    {0x3C, 0x40, 0x30, 0x40, 0x3C}, {0x44, 0x28, 0x10, 0x28, 0x44}, {0x0C, 0x50, 0x50, 0x50, 0x3C},
+    {0x44, 0x64, 0x54, 0x4C, 0x44}, {0x00, 0x08, 0x36, 0x41, 0x00}, {0x00, 0x00, 0x7F, 0x00, 0x00},
+    {0x00, 0x41, 0x36, 0x08, 0x00}, {0x08, 0x04, 0x08, 0x10, 0x08},
+};
+
+// Bytes a device flush spends on one page window (control + 6 command bytes)
+#define WINDOW_BYTES 7
+// Data bytes per I2C transaction on the device (plus one control byte)
+#define DATA_CHUNK 31
+// Bytes a device contrast change costs (control + command + value)
+#define CONTRAST_BYTES 3
+
+static uint8_t buffer[OLED_BUFFER_SIZE];    // Back buffer (drawing target)
+static uint8_t panel[OLED_BUFFER_SIZE];     // Last flushed frame
+static bool panel_valid = false;
+static oled_stats_t stats;
+static int cursor_x = 0;
+static int cursor_y = 0;
+static int text_size = 1;
+static bool is_initialized = false;
+
+static void set_pixel(int x, int y, bool on)
+{
+    if (x < 0 || x >= OLED_WIDTH || y < 0 || y >= OLED_HEIGHT) {
+        return;
+    }
+    uint8_t *byte = &buffer[(y / 8) * OLED_WIDTH + x];
+    uint8_t mask = (uint8_t)(1 << (y & 7));
+    if (on) {
+        *byte |= mask;
+    } else {
+        *byte &= (uint8_t)~mask;
+    }
+}
+
+static void fill_rect(int x, int y, int width, int height, bool on)
+{
+    for (int j = y; j < y + height; j++) {
+        for (int i = x; i < x + width; i++) {
+            set_pixel(i, j, on);
+        }
+    }
+}
+
+// Draw one character cell (transparent background, like the Adafruit default)
+static void draw_char(int x, int y, char c)
+{
+    if (c < FONT_FIRST || c > FONT_LAST) {
+        c = '?';
+    }
+    const uint8_t *glyph = FONT[c - FONT_FIRST];
+    for (int col = 0; col < 5; col++) {
+        for (int row = 0; row < 7; row++) {
+            if (glyph[col] & (1 << row)) {
+                fill_rect(x + col * text_size, y + row * text_size, text_size, text_size, true);
+            }
+        }
+    }
+}
+
+static void write_text(const char *str)
+{
+    for (; *str != '\0'; str++) {
+        if (*str == '\n') {
+            cursor_x = 0;
+            cursor_y += CHAR_HEIGHT * text_size;
+            continue;
+        }
+        if (*str == '\r') {
+            continue;
+        }
+        if (cursor_x + CHAR_WIDTH * text_size > OLED_WIDTH) {
+            cursor_x = 0;
+            cursor_y += CHAR_HEIGHT * text_size;
+        }
+        draw_char(cursor_x, cursor_y, *str);
+        cursor_x += CHAR_WIDTH * text_size;
+    }
+}
+
+bool oled_init(void)
+{
+    printf("OLED - Initializing (in-memory framebuffer)\n");
+
+    if (is_initialized) {
+        printf("OLED - Already initialized\n");
+        return false;
+    }
+
+    memset(buffer, 0, sizeof(buffer));
+    memset(panel, 0, sizeof(panel));
+    memset(&stats, 0, sizeof(stats));
+    panel_valid = true;
+    cursor_x = 0;
+    cursor_y = 0;
+    text_size = 1;
+
+    is_initialized = true;
+    printf("OLED - Initialized successfully\n");
+    return true;
+}
+
+void oled_clear(void)
+{
+    if (!is_initialized) return;
+    memset(buffer, 0, sizeof(buffer));
+    cursor_x = 0;
+    cursor_y = 0;
+}
+
+void oled_display(void)
+{
+    if (!is_initialized) return;
+
+    // Same per-page dirty span as the device flush, counted instead of sent
+    uint32_t bytes = 0;
+    uint32_t pages = 0;
+    for (int page = 0; page < OLED_PAGES; page++) {
+        const uint8_t *row = buffer + page * OLED_WIDTH;
+        uint8_t *old = panel + page * OLED_WIDTH;
+
+        int first = 0;
+        int last = OLED_WIDTH - 1;
+        if (panel_valid) {
+            while (first < OLED_WIDTH && row[first] == old[first]) first++;
+            if (first == OLED_WIDTH) continue;
+            while (row[last] == old[last]) last--;
+        }
+
+        uint32_t span = (uint32_t)(last - first + 1);
+        bytes += WINDOW_BYTES + span + (span + DATA_CHUNK - 1) / DATA_CHUNK;
+        memcpy(old + first, row + first, span);
+        pages++;
+    }
+
+    panel_valid = true;
+    stats.frames++;
+    stats.last_frame_bytes = bytes;
+    stats.last_dirty_pages = pages;
+    stats.total_bytes += bytes;
+}
+
+void oled_set_brightness(uint8_t level)
+{
+    if (!is_initialized) return;
+    (void)level;
+    stats.total_bytes += CONTRAST_BYTES;
+}
+
+void oled_invalidate(void)
+{
+    panel_valid = false;
+}
+
+void oled_get_stats(oled_stats_t *out)
+{
+    if (out == NULL) return;
+    *out = stats;
+}
+
+void oled_set_cursor(uint8_t x, uint8_t y)
+{
+    if (!is_initialized) return;
+    cursor_x = x;
+    cursor_y = y;
+}
+
+void oled_set_text_size(oled_text_size_t size)
+{
+    if (!is_initialized) return;
+    text_size = (int)size;
+}
+
+void oled_print(const char *str)
+{
+    if (!is_initialized || str == NULL) return;
+    write_text(str);
+}
+
+void oled_println(const char *str)
+{
+    if (!is_initialized || str == NULL) return;
+    write_text(str);
+    write_text("\n");
+}
+
+void oled_printf(const char *format, ...)
+{
+    if (!is_initialized || format == NULL) return;
+
+    char text[128];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+
+    write_text(text);
+}
+
+void oled_draw_hline(uint8_t x, uint8_t y, uint8_t width)
+{
+    if (!is_initialized) return;
+    fill_rect(x, y, width, 1, true);
+}
+
+void oled_draw_vline(uint8_t x, uint8_t y, uint8_t height)
+{
+    if (!is_initialized) return;
+    fill_rect(x, y, 1, height, true);
+}
+
+void oled_draw_rect(uint8_t x, uint8_t y, uint8_t width, uint8_t height, bool fill)
+{
+    if (!is_initialized || width == 0 || height == 0) return;
+
+    if (fill) {
+        fill_rect(x, y, width, height, true);
+    } else {
+        fill_rect(x, y, width, 1, true);
+        fill_rect(x, y + height - 1, width, 1, true);
+        fill_rect(x, y, 1, height, true);
+        fill_rect(x + width - 1, y, 1, height, true);
+    }
+}
+
+void oled_clear_rect(uint8_t x, uint8_t y, uint8_t width, uint8_t height)
+{
+    if (!is_initialized) return;
+    fill_rect(x, y, width, height, false);
+}
+
+void oled_cleanup(void)
+{
+    printf("OLED - Cleanup\n");
+    is_initialized = false;
+}
+
+bool oled_host_dump_pbm(const char *path)
+{
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+        printf("OLED - Cannot write %s\n", path);
+        return false;
+    }
+
+    // P4: rows of packed bits, MSB first, 1 = black; lit pixels are drawn black
+    fprintf(file, "P4\n%d %d\n", OLED_WIDTH, OLED_HEIGHT);
+    for (int y = 0; y < OLED_HEIGHT; y++) {
+        uint8_t row[OLED_WIDTH / 8] = {0};
+        for (int x = 0; x < OLED_WIDTH; x++) {
+            if (panel[(y / 8) * OLED_WIDTH + x] & (1 << (y & 7))) {
+                row[x / 8] |= (uint8_t)(0x80 >> (x & 7));
+            }
+        }
+        fwrite(row, 1, sizeof(row), file);
+    }
+    fclose(file);
+    return true;
+}
+
+const uint8_t *oled_host_framebuffer(void)
+{
+    return panel;
+}
@@ -3,15 +3,176 @@
 #include <Arduino.h>
 #include <Adafruit_MPU6050.h>
 #include <Adafruit_Sensor.h>
+#include <Wire.h>
+
+// Register map (subset read directly, bypassing sensors_event_t)
+#define MPU6050_ADDR            0x68
+#define REG_SMPLRT_DIV          0x19    // Followed by CONFIG, GYRO_CONFIG, ACCEL_CONFIG
+#define REG_FIFO_EN             0x23
+#define REG_INT_ENABLE          0x38
+#define REG_INT_STATUS          0x3A
+#define REG_ACCEL_XOUT_H        0x3B
+#define REG_TEMP_OUT_H          0x41
+#define REG_GYRO_XOUT_H         0x43
+#define REG_USER_CTRL           0x6A
+#define REG_FIFO_COUNTH         0x72
+#define REG_FIFO_R_W            0x74
+
+#define FIFO_EN_TEMP_GYRO_ACCEL 0xF8    // TEMP | XG | YG | ZG | ACCEL
+#define USER_CTRL_FIFO_EN       0x40
+#define USER_CTRL_FIFO_RESET    0x04
+#define INT_FIFO_OFLOW          0x10
+#define FIFO_SIZE_BYTES         1024
+#define SAMPLE_BYTES            14      // accel(6) + temp(2) + gyro(6)
+
+// Samples per I2C burst (ESP32 Wire buffer is 128 bytes)
+#define FIFO_BURST_SAMPLES      9
 
 // Static MPU6050 object
 static Adafruit_MPU6050 mpu;
 static bool is_initialized = false;
+static bool fifo_enabled = false;
+static mpu6050_scale_t current_scale;
+static mpu6050_config_t active_config;
+static mpu6050_profile_t active_profile = MPU6050_PROFILE_COUNT;
+
+static const mpu6050_config_t PROFILES[MPU6050_PROFILE_COUNT] = {
+    {4, 250, 10, 25},       // MPU6050_PROFILE_LOW_POWER
+    {8, 500, 44, 100},      // MPU6050_PROFILE_NORMAL
+    {16, 2000, 184, 500},   // MPU6050_PROFILE_IMPACT
+};
+
+// DLPF_CFG 0..6 bandwidths (Hz)
+static const uint16_t DLPF_BANDWIDTHS[7] = {260, 184, 94, 44, 21, 10, 5};
+
+static bool write_reg(uint8_t reg, uint8_t value)
+{
+    Wire.beginTransmission(MPU6050_ADDR);
+    Wire.write(reg);
+    Wire.write(value);
+    return Wire.endTransmission() == 0;
+}
+
+static bool write_regs(uint8_t reg, const uint8_t *values, size_t len)
+{
+    Wire.beginTransmission(MPU6050_ADDR);
+    Wire.write(reg);
+    Wire.write(values, len);
+    return Wire.endTransmission() == 0;
+}
+
+static bool read_regs(uint8_t reg, uint8_t *buf, size_t len)
+{
+    Wire.beginTransmission(MPU6050_ADDR);
+    Wire.write(reg);
+    if (Wire.endTransmission(false) != 0) {
+        return false;
+    }
+    if (Wire.requestFrom((uint8_t)MPU6050_ADDR, (uint8_t)len) != len) {
+        return false;
+    }
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = Wire.read();
+    }
+    return true;
+}
+
+static inline int16_t be16(const uint8_t *p)
+{
+    return (int16_t)((p[0] << 8) | p[1]);
+}
+
+// Unpack one 14-byte register/FIFO frame
+static void unpack_raw(const uint8_t *p, mpu6050_raw_t *raw)
+{
+    raw->accel_x = be16(p + 0);
+    raw->accel_y = be16(p + 2);
+    raw->accel_z = be16(p + 4);
+    raw->temp = be16(p + 6);
+    raw->gyro_x = be16(p + 8);
+    raw->gyro_y = be16(p + 10);
+    raw->gyro_z = be16(p + 12);
+}
+
+// Smallest full-scale setting (0..3) that covers 'value' given the +-'base' range
+static uint8_t full_scale_select(uint32_t value, uint32_t base)
+{
+    uint8_t sel = 0;
+    while (sel < 3 && (base << sel) < value) {
+        sel++;
+    }
+    return sel;
+}
+
+// DLPF setting whose bandwidth is closest to 'bandwidth_hz'
+static uint8_t dlpf_select(uint16_t bandwidth_hz)
+{
+    uint8_t best = 0;
+    for (uint8_t i = 1; i < 7; i++) {
+        if (abs((int)DLPF_BANDWIDTHS[i] - (int)bandwidth_hz) <
+            abs((int)DLPF_BANDWIDTHS[best] - (int)bandwidth_hz)) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+static void fifo_reset(void);
+
+// Write divider, DLPF and both ranges in one burst and update the scale
+static bool apply_config(const mpu6050_config_t *config)
+{
+    uint8_t accel_sel = full_scale_select(config->accel_range_g, 2);
+    uint8_t gyro_sel = full_scale_select(config->gyro_range_dps, 250);
+    uint8_t dlpf = dlpf_select(config->bandwidth_hz);
+
+    // Gyro output rate is 8 kHz with the DLPF off (260 Hz band), 1 kHz otherwise
+    uint32_t base_hz = (dlpf == 0) ? 8000 : 1000;
+    uint32_t rate_hz = (config->rate_hz > 0) ? config->rate_hz : 1;
+    uint32_t divider = (base_hz + rate_hz / 2) / rate_hz;
+    divider = constrain(divider, 1, 256);
+
+    // SMPLRT_DIV, CONFIG, GYRO_CONFIG, ACCEL_CONFIG are consecutive registers
+    uint8_t regs[4] = {
+        (uint8_t)(divider - 1),
+        dlpf,
+        (uint8_t)(gyro_sel << 3),
+        (uint8_t)(accel_sel << 3),
+    };
+    if (!write_regs(REG_SMPLRT_DIV, regs, sizeof(regs))) {
+        Serial.println("MPU6050 - Configuration write failed");
+        return false;
+    }
+
+    active_config.accel_range_g = (uint8_t)(2 << accel_sel);
+    active_config.gyro_range_dps = (uint16_t)(250 << gyro_sel);
+    active_config.bandwidth_hz = DLPF_BANDWIDTHS[dlpf];
+    active_config.rate_hz = (uint16_t)(base_hz / divider);
+
+    // 16384 LSB/g at +-2g halving per range step; 131 LSB/(deg/s) at +-250 deg/s
+    current_scale.accel_scale = SENSORS_GRAVITY_STANDARD / (float)(16384 >> accel_sel);
+    current_scale.gyro_scale = SENSORS_DPS_TO_RADS / (131.0f / (float)(1 << gyro_sel));
+    current_scale.temp_scale = 1.0f / 340.0f;
+    current_scale.temp_offset = 36.53f;
+
+    // Samples already queued were taken with the old scale
+    if (fifo_enabled) {
+        fifo_reset();
+    }
+    return true;
+}
+
+static void fifo_reset(void)
+{
+    write_reg(REG_USER_CTRL, 0);
+    write_reg(REG_USER_CTRL, USER_CTRL_FIFO_RESET);
+    write_reg(REG_USER_CTRL, USER_CTRL_FIFO_EN);
+}
 
 bool mpu6050_init(void)
 {
     Serial.println("MPU6050 - Initializing");
-    
+
     if (is_initialized) {
         Serial.println("MPU6050 - Already initialized");
         return false;
@@ -24,27 +185,76 @@ bool mpu6050_init(void)
     }
 
     // Configure MPU6050
-    mpu.setAccelerometerRange(MPU6050_RANGE_8_G);
-    mpu.setGyroRange(MPU6050_RANGE_500_DEG);
-    mpu.setFilterBandwidth(MPU6050_BAND_21_HZ);
-
     is_initialized = true;
+    if (!mpu6050_set_profile(MPU6050_PROFILE_NORMAL)) {
+        is_initialized = false;
+        return false;
+    }
+
     Serial.println("MPU6050 - Initialized successfully");
     return true;
 }
 
+bool mpu6050_set_profile(mpu6050_profile_t profile)
+{
+    if (!is_initialized || profile >= MPU6050_PROFILE_COUNT) {
+        return false;
+    }
+    if (!apply_config(&PROFILES[profile])) {
+        return false;
+    }
+    active_profile = profile;
+    return true;
+}
+
+mpu6050_profile_t mpu6050_get_profile(void)
+{
+    return active_profile;
+}
+
+bool mpu6050_configure(const mpu6050_config_t *config)
+{
+    if (!is_initialized || config == NULL) {
+        return false;
+    }
+    if (!apply_config(config)) {
+        return false;
+    }
+    active_profile = MPU6050_PROFILE_COUNT;
+    return true;
+}
+
+void mpu6050_get_config(mpu6050_config_t *config)
+{
+    if (config != NULL) {
+        *config = active_config;
+    }
+}
+
+mpu6050_profile_t mpu6050_profile_for_rate(uint32_t rate_hz)
+{
+    for (int p = 0; p < MPU6050_PROFILE_COUNT; p++) {
+        if (PROFILES[p].rate_hz >= rate_hz) {
+            return (mpu6050_profile_t)p;
+        }
+    }
+    return MPU6050_PROFILE_IMPACT;
+}
+
 bool mpu6050_read_accel(mpu6050_accel_t *accel)
 {
     if (!is_initialized || accel == NULL) {
         return false;
     }
 
-    sensors_event_t a, g, temp;
-    mpu.getEvent(&a, &g, &temp);
-    
-    accel->x = a.acceleration.x;
-    accel->y = a.acceleration.y;
-    accel->z = a.acceleration.z;
+    uint8_t buf[6];
+    if (!read_regs(REG_ACCEL_XOUT_H, buf, sizeof(buf))) {
+        return false;
+    }
+
+    accel->x = be16(buf + 0) * current_scale.accel_scale;
+    accel->y = be16(buf + 2) * current_scale.accel_scale;
+    accel->z = be16(buf + 4) * current_scale.accel_scale;
 
     return true;
 }
@@ -55,12 +265,14 @@ bool mpu6050_read_gyro(mpu6050_gyro_t *gyro)
         return false;
     }
 
-    sensors_event_t a, g, temp;
-    mpu.getEvent(&a, &g, &temp);
-    
-    gyro->x = g.gyro.x;
-    gyro->y = g.gyro.y;
-    gyro->z = g.gyro.z;
+    uint8_t buf[6];
+    if (!read_regs(REG_GYRO_XOUT_H, buf, sizeof(buf))) {
+        return false;
+    }
+
+    gyro->x = be16(buf + 0) * current_scale.gyro_scale;
+    gyro->y = be16(buf + 2) * current_scale.gyro_scale;
+    gyro->z = be16(buf + 4) * current_scale.gyro_scale;
 
     return true;
 }
@@ -71,10 +283,12 @@ bool mpu6050_read_temp(mpu6050_temp_t *temp)
         return false;
     }
 
-    sensors_event_t a, g, t;
-    mpu.getEvent(&a, &g, &t);
-    
-    temp->celsius = t.temperature;
+    uint8_t buf[2];
+    if (!read_regs(REG_TEMP_OUT_H, buf, sizeof(buf))) {
+        return false;
+    }
+
+    temp->celsius = be16(buf) * current_scale.temp_scale + current_scale.temp_offset;
 
     return true;
 }
@@ -86,24 +300,164 @@ bool mpu6050_read_all(mpu6050_accel_t *accel, mpu6050_gyro_t *gyro, mpu6050_temp
     }
 
     // Read all sensors at once (more efficient)
-    sensors_event_t a, g, t;
-    mpu.getEvent(&a, &g, &t);
-    
-    accel->x = a.acceleration.x;
-    accel->y = a.acceleration.y;
-    accel->z = a.acceleration.z;
-    
-    gyro->x = g.gyro.x;
-    gyro->y = g.gyro.y;
-    gyro->z = g.gyro.z;
-    
-    temp->celsius = t.temperature;
+    mpu6050_raw_t raw;
+    if (!mpu6050_read_raw(&raw)) {
+        return false;
+    }
+
+    mpu6050_sample_t sample;
+    mpu6050_convert(&raw, &sample, 1, &current_scale);
+    *accel = sample.accel;
+    *gyro = sample.gyro;
+    *temp = sample.temp;
 
     return true;
 }
 
+bool mpu6050_read_raw(mpu6050_raw_t *raw)
+{
+    if (!is_initialized || raw == NULL) {
+        return false;
+    }
+
+    uint8_t buf[SAMPLE_BYTES];
+    if (!read_regs(REG_ACCEL_XOUT_H, buf, sizeof(buf))) {
+        return false;
+    }
+    unpack_raw(buf, raw);
+
+    return true;
+}
+
+bool mpu6050_get_scale(mpu6050_scale_t *scale)
+{
+    if (!is_initialized || scale == NULL) {
+        return false;
+    }
+
+    *scale = current_scale;
+    return true;
+}
+
+void mpu6050_convert(const mpu6050_raw_t *raw, mpu6050_sample_t *out, int count,
+                     const mpu6050_scale_t *scale)
+{
+    const float as = scale->accel_scale;
+    const float gs = scale->gyro_scale;
+    const float ts = scale->temp_scale;
+    const float to = scale->temp_offset;
+
+    // Straight-line multiply per field; no branches inside the loop
+    for (int i = 0; i < count; i++) {
+        out[i].accel.x = raw[i].accel_x * as;
+        out[i].accel.y = raw[i].accel_y * as;
+        out[i].accel.z = raw[i].accel_z * as;
+        out[i].gyro.x = raw[i].gyro_x * gs;
+        out[i].gyro.y = raw[i].gyro_y * gs;
+        out[i].gyro.z = raw[i].gyro_z * gs;
+        out[i].temp.celsius = raw[i].temp * ts + to;
+    }
+}
+
+bool mpu6050_fifo_start(uint16_t rate_hz)
+{
+    if (!is_initialized) {
+        return false;
+    }
+
+    if (rate_hz != 0 && rate_hz != active_config.rate_hz) {
+        mpu6050_config_t config = active_config;
+        config.rate_hz = rate_hz;
+        if (!apply_config(&config)) {
+            return false;
+        }
+        active_profile = MPU6050_PROFILE_COUNT;
+    }
+
+    if (!write_reg(REG_FIFO_EN, FIFO_EN_TEMP_GYRO_ACCEL) ||
+        !write_reg(REG_INT_ENABLE, INT_FIFO_OFLOW)) {
+        Serial.println("MPU6050 - FIFO configuration failed");
+        return false;
+    }
+
+    uint8_t status;
+    read_regs(REG_INT_STATUS, &status, 1);  // Clear stale overflow flag
+    fifo_reset();
+
+    fifo_enabled = true;
+    Serial.printf("MPU6050 - FIFO started at %u Hz\n", active_config.rate_hz);
+    return true;
+}
+
+int mpu6050_fifo_read_raw(mpu6050_raw_t *raw, int max_samples, bool *overflow)
+{
+    if (!is_initialized || !fifo_enabled || raw == NULL) {
+        return -1;
+    }
+    if (overflow != NULL) {
+        *overflow = false;
+    }
+
+    uint8_t buf[FIFO_BURST_SAMPLES * SAMPLE_BYTES];
+    uint8_t status;
+    if (!read_regs(REG_INT_STATUS, &status, 1) || !read_regs(REG_FIFO_COUNTH, buf, 2)) {
+        return -1;
+    }
+    uint16_t count = (uint16_t)((buf[0] << 8) | buf[1]);
+
+    if ((status & INT_FIFO_OFLOW) || count >= FIFO_SIZE_BYTES) {
+        // Oldest bytes were overwritten, so frame alignment is lost
+        fifo_reset();
+        if (overflow != NULL) {
+            *overflow = true;
+        }
+        return 0;
+    }
+
+    int available = count / SAMPLE_BYTES;
+    int total = min(available, max_samples);
+    int done = 0;
+    while (done < total) {
+        int burst = min(total - done, FIFO_BURST_SAMPLES);
+        if (!read_regs(REG_FIFO_R_W, buf, burst * SAMPLE_BYTES)) {
+            return (done > 0) ? done : -1;
+        }
+        for (int i = 0; i < burst; i++) {
+            unpack_raw(buf + i * SAMPLE_BYTES, &raw[done + i]);
+        }
+        done += burst;
+    }
+    return done;
+}
+
+int mpu6050_fifo_read(mpu6050_sample_t *samples, int max_samples, bool *overflow)
+{
+    if (samples == NULL) {
+        return -1;
+    }
+
+    mpu6050_raw_t raw[MPU6050_FIFO_MAX_SAMPLES];
+    int count = mpu6050_fifo_read_raw(raw, min(max_samples, MPU6050_FIFO_MAX_SAMPLES), overflow);
+    if (count > 0) {
+        mpu6050_convert(raw, samples, count, &current_scale);
+    }
+    return count;
+}
+
+void mpu6050_fifo_stop(void)
+{
+    if (!is_initialized || !fifo_enabled) {
+        return;
+    }
+    write_reg(REG_FIFO_EN, 0);
+    write_reg(REG_INT_ENABLE, 0);
+    write_reg(REG_USER_CTRL, USER_CTRL_FIFO_RESET);
+    fifo_enabled = false;
+}
+
 void mpu6050_cleanup(void)
 {
     Serial.println("MPU6050 - Cleanup");
+    mpu6050_fifo_stop();
     is_initialized = false;
 }
@@ -4,6 +4,7 @@
 #include <Adafruit_GFX.h>
 #include <Adafruit_SSD1306.h>
 #include <Wire.h>
+#include <atomic>
 #include <stdarg.h>
 
 // Display configuration
@@ -12,10 +13,134 @@
 #define OLED_RESET -1
 #define SCREEN_ADDRESS 0x3C
 
+// SSD1306 I2C control bytes and addressing commands
+#define CONTROL_COMMANDS 0x00
+#define CONTROL_DATA 0x40
+#define CMD_COLUMN_ADDR 0x21
+#define CMD_PAGE_ADDR 0x22
+#define CMD_SET_CONTRAST 0x81
+
+// Data bytes per I2C transaction (plus one control byte)
+#define DATA_CHUNK 31
+
+// Frame slots shared with the flush task: one being written by oled_display(),
+// one published, one being flushed. FRAME_FRESH marks an unflushed publication.
+#define FRAME_SLOTS 3
+#define FRAME_INDEX_MASK 0x03
+#define FRAME_FRESH 0x04
+
 // Static display object
 static Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET);
 static bool is_initialized = false;
 
+// Framebuffer contents as last sent to the panel (owned by the flusher)
+static uint8_t shadow[OLED_BUFFER_SIZE];
+static std::atomic<bool> shadow_valid{false};
+static oled_stats_t stats;
+
+// Lock-free frame exchange between oled_display() and the flush task
+static uint8_t frames[FRAME_SLOTS][OLED_BUFFER_SIZE];
+static std::atomic<uint8_t> published{1};
+static uint8_t write_slot = 0;             // Only touched by oled_display()
+static uint8_t flush_slot = 2;             // Only touched by the flusher
+static TaskHandle_t flush_task = NULL;
+static volatile bool flush_running = false;
+static volatile bool flush_exited = false;
+
+// Contrast waiting to be sent by the flusher (BRIGHTNESS_NONE if nothing pending)
+#define BRIGHTNESS_NONE 0xFFFF
+static std::atomic<uint16_t> pending_brightness{BRIGHTNESS_NONE};
+
+// Send one page's column span [first, last] and return the I2C bytes used
+static uint32_t flush_span(uint8_t page, uint8_t first, uint8_t last, const uint8_t *data)
+{
+    Wire.beginTransmission(SCREEN_ADDRESS);
+    Wire.write(CONTROL_COMMANDS);
+    Wire.write(CMD_COLUMN_ADDR);
+    Wire.write(first);
+    Wire.write(last);
+    Wire.write(CMD_PAGE_ADDR);
+    Wire.write(page);
+    Wire.write(page);
+    Wire.endTransmission();
+    uint32_t bytes = 7;
+
+    uint32_t remaining = last - first + 1;
+    while (remaining > 0) {
+        uint32_t chunk = min(remaining, (uint32_t)DATA_CHUNK);
+        Wire.beginTransmission(SCREEN_ADDRESS);
+        Wire.write(CONTROL_DATA);
+        Wire.write(data, chunk);
+        Wire.endTransmission();
+        data += chunk;
+        remaining -= chunk;
+        bytes += chunk + 1;
+    }
+    return bytes;
+}
+
+// Send a pending contrast change, if any
+static void flush_brightness(void)
+{
+    uint16_t level = pending_brightness.exchange(BRIGHTNESS_NONE);
+    if (level == BRIGHTNESS_NONE) {
+        return;
+    }
+    Wire.beginTransmission(SCREEN_ADDRESS);
+    Wire.write(CONTROL_COMMANDS);
+    Wire.write(CMD_SET_CONTRAST);
+    Wire.write((uint8_t)level);
+    Wire.endTransmission();
+    stats.total_bytes += 3;
+}
+
+// Send the parts of 'buffer' that differ from the panel contents
+static void flush_frame(const uint8_t *buffer)
+{
+    bool valid = shadow_valid.exchange(true);
+    uint32_t bytes = 0;
+    uint32_t pages = 0;
+
+    for (uint8_t page = 0; page < OLED_PAGES; page++) {
+        const uint8_t *row = buffer + page * OLED_WIDTH;
+        uint8_t *old = shadow + page * OLED_WIDTH;
+
+        int first = 0;
+        int last = OLED_WIDTH - 1;
+        if (valid) {
+            while (first < OLED_WIDTH && row[first] == old[first]) first++;
+            if (first == OLED_WIDTH) continue;  // Page unchanged
+            while (row[last] == old[last]) last--;
+        }
+
+        bytes += flush_span(page, first, last, row + first);
+        memcpy(old + first, row + first, last - first + 1);
+        pages++;
+    }
+
+    stats.frames++;
+    stats.last_frame_bytes = bytes;
+    stats.last_dirty_pages = pages;
+    stats.total_bytes += bytes;
+}
+
+// Flush task on the core that does not run loop() or the sampler
+static void flush_main(void *arg)
+{
+    while (flush_running) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
+        flush_brightness();
+        if (!(published.load(std::memory_order_acquire) & FRAME_FRESH)) {
+            continue;
+        }
+        flush_slot = published.exchange(flush_slot, std::memory_order_acq_rel) & FRAME_INDEX_MASK;
+        flush_frame(frames[flush_slot]);
+    }
+
+    flush_exited = true;
+    vTaskDelete(NULL);
+}
+
 bool oled_init(void)
 {
     Serial.println("OLED - Initializing");
@@ -31,9 +156,27 @@ bool oled_init(void)
         return false;
     }
 
+    // The MPU-6050 on the same bus supports fast mode as well
+    Wire.setClock(400000);
+
     display.clearDisplay();
     display.setTextColor(SSD1306_WHITE);
     display.display();
+    memset(shadow, 0, sizeof(shadow));
+    shadow_valid = true;
+    memset(&stats, 0, sizeof(stats));
+
+    write_slot = 0;
+    published.store(1);
+    flush_slot = 2;
+    flush_running = true;
+    flush_exited = false;
+    if (xTaskCreatePinnedToCore(flush_main, "oled", 4096, NULL, OLED_FLUSH_TASK_PRIORITY,
+                                &flush_task, OLED_FLUSH_TASK_CORE) != pdPASS) {
+        Serial.println("OLED - Flush task creation failed, flushing synchronously");
+        flush_running = false;
+        flush_task = NULL;
+    }
 
     is_initialized = true;
     Serial.println("OLED - Initialized successfully");
@@ -49,7 +192,44 @@ void oled_clear(void)
 void oled_display(void)
 {
     if (!is_initialized) return;
-    display.display();
+
+    if (flush_task == NULL) {
+        flush_frame(display.getBuffer());
+        return;
+    }
+
+    // Publish a copy and hand the previously published slot back for writing.
+    // Never waits for the panel; a frame not yet flushed is simply replaced.
+    memcpy(frames[write_slot], display.getBuffer(), OLED_BUFFER_SIZE);
+    uint8_t previous = published.exchange(write_slot | FRAME_FRESH, std::memory_order_acq_rel);
+    if (previous & FRAME_FRESH) {
+        stats.frames_dropped++;
+    }
+    write_slot = previous & FRAME_INDEX_MASK;
+    xTaskNotifyGive(flush_task);
+}
+
+void oled_set_brightness(uint8_t level)
+{
+    if (!is_initialized) return;
+
+    pending_brightness.store(level);
+    if (flush_task == NULL) {
+        flush_brightness();
+        return;
+    }
+    xTaskNotifyGive(flush_task);
+}
+
+void oled_invalidate(void)
+{
+    shadow_valid = false;
+}
+
+void oled_get_stats(oled_stats_t *out)
+{
+    if (out == NULL) return;
+    *out = stats;
 }
 
 void oled_set_cursor(uint8_t x, uint8_t y)
@@ -112,10 +292,24 @@ void oled_draw_rect(uint8_t x, uint8_t y, uint8_t width, uint8_t height, bool fi
     }
 }
 
+void oled_clear_rect(uint8_t x, uint8_t y, uint8_t width, uint8_t height)
+{
+    if (!is_initialized) return;
+    display.fillRect(x, y, width, height, SSD1306_BLACK);
+}
+
 void oled_cleanup(void)
 {
     Serial.println("OLED - Cleanup");
     if (is_initialized) {
+        if (flush_task != NULL) {
+            flush_running = false;
+            xTaskNotifyGive(flush_task);
+            while (!flush_exited) {
+                vTaskDelay(1);
+            }
+            flush_task = NULL;
+        }
         display.clearDisplay();
         display.display();
     }
@@ -0,0 +1,257 @@
+// OLED Status UI - Retained-mode widgets on top of the OLED HAL
+#include "hal/oled_ui.h"
+#include "hal/oled.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+// Small text line height and character width (pixels)
+#define LINE_HEIGHT 8
+#define CHAR_WIDTH 6
+
+typedef enum {
+    WIDGET_LABEL,
+    WIDGET_NUMBER,
+    WIDGET_COUNTER,
+    WIDGET_BAR
+} widget_type_t;
+
+typedef struct {
+    widget_type_t type;
+    uint8_t x, y, width, height;
+    bool visible;
+    bool dirty;
+    const char *format;         // Number/counter format
+    float resolution;           // Number display step
+    bool has_value;
+    int32_t shown;              // Quantized value (number), value (counter), fill px (bar)
+    char text[OLED_UI_TEXT_SIZE];
+} widget_t;
+
+static widget_t widgets[OLED_UI_MAX_WIDGETS];
+static int widget_count = 0;
+static uint32_t refresh_interval_ms = 0;
+static uint32_t last_refresh_ms = 0;
+static bool any_dirty = false;
+static oled_ui_stats_t stats;
+static bool is_initialized = false;
+
+static int add_widget(widget_type_t type, uint8_t x, uint8_t y, uint8_t width, uint8_t height)
+{
+    if (!is_initialized || widget_count == OLED_UI_MAX_WIDGETS) {
+        return -1;
+    }
+
+    widget_t *w = &widgets[widget_count];
+    memset(w, 0, sizeof(*w));
+    w->type = type;
+    w->x = x;
+    w->y = y;
+    w->width = width;
+    w->height = height;
+    w->visible = true;
+    w->dirty = true;
+    any_dirty = true;
+    return widget_count++;
+}
+
+static widget_t *get_widget(int id, widget_type_t type)
+{
+    if (id < 0 || id >= widget_count || widgets[id].type != type) {
+        return NULL;
+    }
+    return &widgets[id];
+}
+
+static void mark_dirty(widget_t *w)
+{
+    w->dirty = true;
+    any_dirty = true;
+}
+
+static void draw_widget(const widget_t *w)
+{
+    oled_clear_rect(w->x, w->y, w->width, w->height);
+    if (!w->visible) {
+        return;
+    }
+
+    if (w->type == WIDGET_BAR) {
+        oled_draw_rect(w->x, w->y, w->width, w->height, false);
+        if (w->shown > 0) {
+            oled_draw_rect(w->x + 2, w->y + 2, w->shown, w->height - 4, true);
+        }
+        return;
+    }
+
+    // Clip to the field so an over-long value never draws over its neighbour
+    char clipped[OLED_UI_TEXT_SIZE];
+    snprintf(clipped, sizeof(clipped), "%.*s", w->width / CHAR_WIDTH, w->text);
+    oled_set_text_size(OLED_TEXT_SIZE_SMALL);
+    oled_set_cursor(w->x, w->y);
+    oled_print(clipped);
+}
+
+bool oled_ui_init(uint32_t min_refresh_ms)
+{
+    refresh_interval_ms = min_refresh_ms;
+    last_refresh_ms = 0;
+    widget_count = 0;
+    any_dirty = false;
+    memset(&stats, 0, sizeof(stats));
+    is_initialized = true;
+    return true;
+}
+
+void oled_ui_clear(void)
+{
+    widget_count = 0;
+    any_dirty = false;
+    oled_clear();
+    oled_display();
+}
+
+int oled_ui_add_label(uint8_t x, uint8_t y, uint8_t width, const char *text)
+{
+    int id = add_widget(WIDGET_LABEL, x, y, width, LINE_HEIGHT);
+    if (id >= 0) {
+        snprintf(widgets[id].text, OLED_UI_TEXT_SIZE, "%s", text != NULL ? text : "");
+    }
+    return id;
+}
+
+int oled_ui_add_number(uint8_t x, uint8_t y, uint8_t width, const char *format, float resolution)
+{
+    int id = add_widget(WIDGET_NUMBER, x, y, width, LINE_HEIGHT);
+    if (id >= 0) {
+        widgets[id].format = format;
+        widgets[id].resolution = (resolution > 0.0f) ? resolution : 1.0f;
+    }
+    return id;
+}
+
+int oled_ui_add_counter(uint8_t x, uint8_t y, uint8_t width, const char *format)
+{
+    int id = add_widget(WIDGET_COUNTER, x, y, width, LINE_HEIGHT);
+    if (id >= 0) {
+        widgets[id].format = format;
+    }
+    return id;
+}
+
+int oled_ui_add_bar(uint8_t x, uint8_t y, uint8_t width, uint8_t height)
+{
+    return add_widget(WIDGET_BAR, x, y, width, height);
+}
+
+void oled_ui_set_text(int id, const char *text)
+{
+    widget_t *w = get_widget(id, WIDGET_LABEL);
+    if (w == NULL || text == NULL) {
+        return;
+    }
+
+    stats.updates++;
+    if (strncmp(w->text, text, OLED_UI_TEXT_SIZE - 1) == 0) {
+        stats.updates_unchanged++;
+        return;
+    }
+    snprintf(w->text, OLED_UI_TEXT_SIZE, "%s", text);
+    mark_dirty(w);
+}
+
+void oled_ui_set_number(int id, float value)
+{
+    widget_t *w = get_widget(id, WIDGET_NUMBER);
+    if (w == NULL) {
+        return;
+    }
+
+    // Compare at display precision; format only when the shown digits change
+    stats.updates++;
+    int32_t quantized = (int32_t)lroundf(value / w->resolution);
+    if (w->has_value && quantized == w->shown) {
+        stats.updates_unchanged++;
+        return;
+    }
+    w->shown = quantized;
+    w->has_value = true;
+    snprintf(w->text, OLED_UI_TEXT_SIZE, w->format, quantized * w->resolution);
+    mark_dirty(w);
+}
+
+void oled_ui_set_counter(int id, uint32_t value)
+{
+    widget_t *w = get_widget(id, WIDGET_COUNTER);
+    if (w == NULL) {
+        return;
+    }
+
+    stats.updates++;
+    if (w->has_value && (uint32_t)w->shown == value) {
+        stats.updates_unchanged++;
+        return;
+    }
+    w->shown = (int32_t)value;
+    w->has_value = true;
+    snprintf(w->text, OLED_UI_TEXT_SIZE, w->format, (unsigned long)value);
+    mark_dirty(w);
+}
+
+void oled_ui_set_percent(int id, int percent)
+{
+    widget_t *w = get_widget(id, WIDGET_BAR);
+    if (w == NULL) {
+        return;
+    }
+
+    // Compare filled pixels, not percent
+    stats.updates++;
+    if (percent < 0) percent = 0;
+    if (percent > 100) percent = 100;
+    int32_t fill = (w->width - 4) * percent / 100;
+    if (w->has_value && fill == w->shown) {
+        stats.updates_unchanged++;
+        return;
+    }
+    w->shown = fill;
+    w->has_value = true;
+    mark_dirty(w);
+}
+
+void oled_ui_set_visible(int id, bool visible)
+{
+    if (id < 0 || id >= widget_count || widgets[id].visible == visible) {
+        return;
+    }
+    widgets[id].visible = visible;
+    mark_dirty(&widgets[id]);
+}
+
+bool oled_ui_refresh(uint32_t now_ms)
+{
+    if (!is_initialized || !any_dirty || now_ms - last_refresh_ms < refresh_interval_ms) {
+        return false;
+    }
+
+    for (int i = 0; i < widget_count; i++) {
+        if (widgets[i].dirty) {
+            draw_widget(&widgets[i]);
+            widgets[i].dirty = false;
+            stats.widgets_drawn++;
+        }
+    }
+    oled_display();
+
+    any_dirty = false;
+    last_refresh_ms = now_ms;
+    stats.refreshes++;
+    return true;
+}
+
+void oled_ui_get_stats(oled_ui_stats_t *out)
+{
+    if (out != NULL) {
+        *out = stats;
+    }
+}
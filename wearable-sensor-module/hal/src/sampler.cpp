@@ -0,0 +1,216 @@
+// Sampler Hardware Abstraction Layer - ESP32 Implementation
+#include "hal/sampler.h"
+#include <Arduino.h>
+#include <atomic>
+
+#define RING_MASK (SAMPLER_RING_SIZE - 1)
+static_assert((SAMPLER_RING_SIZE & RING_MASK) == 0, "SAMPLER_RING_SIZE must be a power of two");
+
+#define NO_PROFILE_REQUEST -1
+
+// Single producer (sampling task), single consumer (loop())
+static sampler_sample_t ring[SAMPLER_RING_SIZE];
+static std::atomic<uint32_t> ring_head{0};      // Next slot to write
+static std::atomic<uint32_t> ring_tail{0};      // Next slot to read
+
+static hw_timer_t *timer = NULL;
+static TaskHandle_t task = NULL;
+static volatile uint32_t tick_us = 0;
+static volatile bool running = false;
+static volatile bool task_exited = false;
+static std::atomic<int> profile_request{NO_PROFILE_REQUEST};
+
+static sampler_stats_t stats;
+static mpu6050_scale_t scale;
+static bool is_initialized = false;
+
+static void IRAM_ATTR on_timer(void)
+{
+    tick_us = micros();
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(task, &woken);
+    if (woken) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+static void timer_start(uint32_t rate_hz)
+{
+    uint64_t period_us = 1000000ULL / rate_hz;
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+    timer = timerBegin(1000000);                // 1 MHz tick
+    timerAttachInterrupt(timer, on_timer);
+    timerAlarm(timer, period_us, true, 0);
+#else
+    timer = timerBegin(0, 80, true);            // 80 MHz APB / 80 = 1 MHz tick
+    timerAttachInterrupt(timer, on_timer, true);
+    timerAlarmWrite(timer, period_us, true);
+    timerAlarmEnable(timer);
+#endif
+}
+
+static void timer_set_rate(uint32_t rate_hz)
+{
+    uint64_t period_us = 1000000ULL / rate_hz;
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+    timerAlarm(timer, period_us, true, 0);
+#else
+    timerAlarmWrite(timer, period_us, true);
+#endif
+}
+
+static void apply_profile_request(void)
+{
+    int requested = profile_request.exchange(NO_PROFILE_REQUEST);
+    if (requested == NO_PROFILE_REQUEST ||
+        !mpu6050_set_profile((mpu6050_profile_t)requested)) {
+        return;
+    }
+
+    mpu6050_config_t config;
+    mpu6050_get_config(&config);
+    mpu6050_get_scale(&scale);
+    if (config.rate_hz != stats.rate_hz) {
+        stats.rate_hz = config.rate_hz;
+        timer_set_rate(config.rate_hz);
+    }
+}
+
+static void push(const sampler_sample_t *sample)
+{
+    uint32_t head = ring_head.load(std::memory_order_relaxed);
+    if (head - ring_tail.load(std::memory_order_acquire) == SAMPLER_RING_SIZE) {
+        stats.ring_overruns++;
+        return;
+    }
+    ring[head & RING_MASK] = *sample;
+    ring_head.store(head + 1, std::memory_order_release);
+}
+
+static void sampler_task(void *arg)
+{
+    while (running) {
+        uint32_t ticks = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
+        if (ticks == 0) {
+            continue;
+        }
+        if (ticks > 1) {
+            stats.missed_ticks += ticks - 1;
+        }
+
+        apply_profile_request();
+
+        sampler_sample_t sample;
+        sample.time_us = tick_us;
+
+        mpu6050_raw_t raw;
+        if (!mpu6050_read_raw(&raw)) {
+            stats.read_errors++;
+            continue;
+        }
+        mpu6050_convert(&raw, &sample.data, 1, &scale);
+        push(&sample);
+        stats.samples++;
+
+        uint32_t latency = micros() - sample.time_us;
+        if (latency > stats.max_latency_us) {
+            stats.max_latency_us = latency;
+        }
+    }
+
+    task_exited = true;
+    vTaskDelete(NULL);
+}
+
+bool sampler_start(void)
+{
+    Serial.println("Sampler - Starting");
+
+    if (is_initialized) {
+        Serial.println("Sampler - Already started");
+        return false;
+    }
+
+    mpu6050_config_t config;
+    mpu6050_get_config(&config);
+    if (!mpu6050_get_scale(&scale) || config.rate_hz == 0) {
+        Serial.println("Sampler - MPU6050 not initialized");
+        return false;
+    }
+
+    memset(&stats, 0, sizeof(stats));
+    stats.rate_hz = config.rate_hz;
+    ring_head.store(0);
+    ring_tail.store(0);
+    profile_request.store(NO_PROFILE_REQUEST);
+
+    running = true;
+    task_exited = false;
+    if (xTaskCreatePinnedToCore(sampler_task, "sampler", 4096, NULL, SAMPLER_TASK_PRIORITY,
+                                &task, SAMPLER_TASK_CORE) != pdPASS) {
+        Serial.println("Sampler - Task creation failed");
+        running = false;
+        return false;
+    }
+    timer_start(config.rate_hz);
+
+    is_initialized = true;
+    Serial.printf("Sampler - Sampling at %u Hz\n", (unsigned)config.rate_hz);
+    return true;
+}
+
+void sampler_set_profile(mpu6050_profile_t profile)
+{
+    if (profile < MPU6050_PROFILE_COUNT) {
+        profile_request.store((int)profile);
+    }
+}
+
+int sampler_read(sampler_sample_t *out, int max)
+{
+    if (out == NULL || max <= 0) {
+        return 0;
+    }
+
+    uint32_t tail = ring_tail.load(std::memory_order_relaxed);
+    uint32_t head = ring_head.load(std::memory_order_acquire);
+    int count = min((int)(head - tail), max);
+    for (int i = 0; i < count; i++) {
+        out[i] = ring[(tail + i) & RING_MASK];
+    }
+    ring_tail.store(tail + count, std::memory_order_release);
+    return count;
+}
+
+int sampler_available(void)
+{
+    return (int)(ring_head.load(std::memory_order_acquire) -
+                 ring_tail.load(std::memory_order_relaxed));
+}
+
+void sampler_get_stats(sampler_stats_t *out)
+{
+    if (out != NULL) {
+        *out = stats;
+    }
+}
+
+void sampler_stop(void)
+{
+    Serial.println("Sampler - Stopping");
+    if (!is_initialized) {
+        return;
+    }
+
+    timerEnd(timer);
+    timer = NULL;
+
+    // Let the task finish its current read so the I2C bus is left idle
+    running = false;
+    xTaskNotifyGive(task);
+    while (!task_exited) {
+        vTaskDelay(1);
+    }
+    task = NULL;
+    is_initialized = false;
+}
@@ -0,0 +1,356 @@
+// Wearable Host Runner - Runs the wearable sampling/display loop on Linux
+// Uses the Linux HAL backends: IMU samples come from a trace or the synthetic
+// generator on a virtual clock, so an hour of wearable time runs in seconds.
+// Reports per-iteration loop cost, display traffic, the radio frames the
+// activity gate would send and the impact bursts (decoded back to check the
+// codec), and dumps the final screen as a PBM image. With a link
+// specification the radio frames go through a simulated lossy ESP-NOW link
+// (common/link_sim.h) to a hub-side receiver, which reports delivery,
+// goodput, alert latency and burst completeness.
+#include "hal/host.h"
+#include "hal/mpu6050.h"
+#include "hal/oled.h"
+#include "hal/oled_ui.h"
+#include "activity_gate.h"
+#include "impact_capture.h"
+#include "common/burst_codec.h"
+#include "common/latency_hist.h"
+#include "common/link_sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Wearable loop period and screen refresh limit (ms of sensor time)
+#define LOOP_PERIOD_MS 50
+#define UI_REFRESH_MS 200
+
+// The gyro reads rad/s; the screen shows deg/s
+#define GYRO_DEG_PER_RAD 57.29578f
+
+// Impact burst chunks sent per loop iteration (as in the firmware)
+#define BURST_CHUNKS_PER_LOOP 4
+
+// Hub side of the simulated link
+typedef struct {
+    uint32_t samples;               // SENSOR_DATA received
+    uint32_t summaries;
+    uint32_t alerts;                // FALL_DETECTED received
+    uint32_t chunks;
+    uint32_t duplicates;            // Frames received a second time
+    uint32_t bursts_complete;       // Every chunk up to the last one received
+    uint16_t burst_id;              // Burst being reassembled
+    uint64_t burst_chunks;          // Its chunks received (bit per chunk index)
+    int burst_last;                 // Its last chunk index, -1 until received
+    bool burst_done;
+    latency_hist_t link_latency;    // Send to arrival, every frame
+    latency_hist_t alert_latency;   // Impact to FALL_DETECTED arrival
+} hub_rx_t;
+
+static int ui_accel[3], ui_gyro[3], ui_temp, ui_status, ui_samples;
+static link_sim_t radio;
+static bool radio_enabled = false;
+static hub_rx_t hub;
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// Same layout as the wearable status screen
+static void build_status_screen(void)
+{
+    oled_ui_init(UI_REFRESH_MS);
+    oled_ui_clear();
+
+    oled_ui_add_label(0, 0, 128, "=== WEARABLE ===");
+    oled_ui_add_label(0, 8, 24, "Acc");
+    oled_ui_add_label(0, 16, 24, "Gyr");
+    oled_ui_add_label(0, 24, 24, "Tmp");
+    // Whole m/s^2 and deg/s: up to -157 (16 g) and -2000 (full scale) fit the 5-character fields
+    for (int i = 0; i < 3; i++) {
+        ui_accel[i] = oled_ui_add_number(24 + i * 36, 8, 32, "%5.0f", 1.0f);
+        ui_gyro[i] = oled_ui_add_number(24 + i * 36, 16, 32, "%5.0f", 1.0f);
+    }
+    ui_temp = oled_ui_add_number(24, 24, 48, "%.1f C", 0.1f);
+    oled_ui_add_label(0, 40, 48, "Status:");
+    ui_status = oled_ui_add_label(48, 40, 80, "HOST");
+    ui_samples = oled_ui_add_counter(0, 56, 128, "Samples:%lu");
+}
+
+// Hand one frame to the simulated link (no-op without one)
+static void radio_send(uint64_t now_us, uint8_t type, const void *payload, size_t len)
+{
+    if (!radio_enabled) {
+        return;
+    }
+    uint8_t frame[PROTOCOL_ESPNOW_MAX_FRAME];
+    frame[0] = type;
+    memcpy(frame + 1, payload, len);
+    link_sim_send(&radio, now_us, frame, len + 1);
+}
+
+static void hub_burst_chunk(const impact_burst_t *chunk)
+{
+    if (chunk->burst_id != hub.burst_id) {
+        hub.burst_id = chunk->burst_id;
+        hub.burst_chunks = 0;
+        hub.burst_last = -1;
+        hub.burst_done = false;
+    }
+    if (chunk->chunk < 64) {
+        hub.burst_chunks |= 1ULL << chunk->chunk;
+    }
+    if (chunk->flags & IMPACT_BURST_LAST) {
+        hub.burst_last = chunk->chunk;
+    }
+    if (!hub.burst_done && hub.burst_last >= 0 && hub.burst_last < 63 &&
+        hub.burst_chunks == (2ULL << hub.burst_last) - 1) {
+        hub.burst_done = true;
+        hub.bursts_complete++;
+    }
+}
+
+// Take every frame that has arrived at the hub by now_us
+static void hub_receive(uint64_t now_us)
+{
+    uint8_t frame[PROTOCOL_ESPNOW_MAX_FRAME];
+    link_sim_info_t info;
+    size_t len;
+    while ((len = link_sim_receive(&radio, now_us, frame, &info)) > 0) {
+        latency_hist_add(&hub.link_latency, (int64_t)(info.deliver_us - info.sent_us));
+        if (info.duplicate) {
+            hub.duplicates++;
+            continue;
+        }
+        switch (frame[0]) {
+        case PKT_SENSOR_DATA:
+            hub.samples++;
+            break;
+        case PKT_SENSOR_SUMMARY:
+            hub.summaries++;
+            break;
+        case PKT_FALL_DETECTED: {
+            fall_detected_t fall;
+            memcpy(&fall, frame + 1, sizeof(fall));
+            hub.alerts++;
+            latency_hist_add(&hub.alert_latency, (int64_t)info.deliver_us - (int64_t)fall.timestamp * 1000);
+            break;
+        }
+        case PKT_IMPACT_BURST: {
+            impact_burst_t chunk;
+            memcpy(&chunk, frame + 1, len - 1);
+            hub.chunks++;
+            hub_burst_chunk(&chunk);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const char *source = (argc > 1) ? argv[1] : "synthetic";
+    double seconds = (argc > 2) ? atof(argv[2]) : 3600.0;
+    const char *pbm_path = (argc > 3) ? argv[3] : "wearable.pbm";
+    const char *link_spec = (argc > 4) ? argv[4] : NULL;
+    uint32_t link_seed = (argc > 5) ? (uint32_t)strtoul(argv[5], NULL, 0) : 1;
+
+    if (link_spec != NULL) {
+        link_sim_config_t link_config;
+        link_sim_default_config(&link_config);
+        if (!link_sim_parse(&link_config, link_spec)) {
+            return 1;
+        }
+        link_sim_init(&radio, &link_config, link_seed);
+        radio_enabled = true;
+        hub.burst_last = -1;
+        latency_hist_init(&hub.link_latency);
+        latency_hist_init(&hub.alert_latency);
+    }
+
+    if (strcmp(source, "synthetic") == 0) {
+        mpu6050_host_synthetic(1);
+    } else if (!mpu6050_host_load_trace(source)) {
+        return 1;
+    }
+    mpu6050_host_set_clock(MPU6050_HOST_VIRTUAL);
+
+    if (!mpu6050_init() || !mpu6050_fifo_start(0) || !oled_init()) {
+        return 1;
+    }
+    build_status_screen();
+
+    mpu6050_config_t config;
+    mpu6050_get_config(&config);
+    int per_loop = (int)(config.rate_hz * LOOP_PERIOD_MS / 1000);
+    if (per_loop < 1) per_loop = 1;
+    uint64_t iterations = (uint64_t)(seconds * 1000.0 / LOOP_PERIOD_MS);
+
+    activity_gate_t gate;
+    activity_gate_init(&gate, NULL);
+    static impact_capture_t capture;
+    impact_capture_init(&capture, NULL, (uint16_t)config.rate_hz);
+    uint32_t burst_samples = 0;
+    uint32_t burst_errors = 0;
+    uint32_t alerts_sent = 0;
+
+    mpu6050_sample_t samples[MPU6050_FIFO_MAX_SAMPLES];
+    uint64_t total_samples = 0;
+    uint64_t worst_ns = 0;
+    uint64_t start_ns = now_ns();
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        uint64_t iter_start = now_ns();
+
+        int count = mpu6050_fifo_read(samples, per_loop, NULL);
+        if (count <= 0) {
+            continue;
+        }
+        // Frames leave when the batch is processed, i.e. at its newest sample
+        uint64_t now_us = (total_samples + (uint64_t)count) * 1000000ULL / config.rate_hz;
+        for (int j = 0; j < count; j++) {
+            uint32_t sample_ms = (uint32_t)((total_samples + j) * 1000 / config.rate_hz);
+            impact_capture_update(&capture, &samples[j], sample_ms);
+            switch (activity_gate_update(&gate, &samples[j], sample_ms)) {
+            case ACTIVITY_SEND_SAMPLE: {
+                sensor_data_t packet;
+                packet.accel_x = samples[j].accel.x;
+                packet.accel_y = samples[j].accel.y;
+                packet.accel_z = samples[j].accel.z;
+                packet.gyro_x = samples[j].gyro.x;
+                packet.gyro_y = samples[j].gyro.y;
+                packet.gyro_z = samples[j].gyro.z;
+                packet.temperature = samples[j].temp.celsius;
+                packet.timestamp = sample_ms;
+                radio_send(now_us, PKT_SENSOR_DATA, &packet, sizeof(packet));
+                break;
+            }
+            case ACTIVITY_SEND_SUMMARY: {
+                sensor_summary_t summary;
+                activity_gate_take_summary(&gate, &summary);
+                radio_send(now_us, PKT_SENSOR_SUMMARY, &summary, sizeof(summary));
+                break;
+            }
+            default:
+                break;
+            }
+        }
+        total_samples += (uint64_t)count;
+
+        fall_detected_t fall;
+        if (impact_capture_take_report(&capture, &fall)) {
+            printf("Host - FALL_DETECTED at %.1f s: %.2f g, free fall %u ms, severity %u\n",
+                   fall.timestamp / 1000.0, fall.impact, (unsigned)fall.duration, fall.severity);
+            radio_send(now_us, PKT_FALL_DETECTED, &fall, sizeof(fall));
+            alerts_sent++;
+        }
+        impact_burst_t chunk;
+        size_t chunk_len;
+        for (int c = 0; c < BURST_CHUNKS_PER_LOOP &&
+                        (chunk_len = impact_capture_next_chunk(&capture, &chunk)) > 0; c++) {
+            radio_send(now_us, PKT_IMPACT_BURST, &chunk, chunk_len);
+            int16_t decoded[255][IMPACT_BURST_CHANNELS];
+            int n = burst_decode(&chunk, chunk_len, decoded, 255);
+            if (n < 0) {
+                burst_errors++;
+            } else {
+                burst_samples += (uint32_t)n;
+            }
+        }
+        if (radio_enabled) {
+            hub_receive(now_us);
+        }
+
+        const mpu6050_sample_t *s = &samples[count - 1];
+        oled_ui_set_number(ui_accel[0], s->accel.x);
+        oled_ui_set_number(ui_accel[1], s->accel.y);
+        oled_ui_set_number(ui_accel[2], s->accel.z);
+        oled_ui_set_number(ui_gyro[0], s->gyro.x * GYRO_DEG_PER_RAD);
+        oled_ui_set_number(ui_gyro[1], s->gyro.y * GYRO_DEG_PER_RAD);
+        oled_ui_set_number(ui_gyro[2], s->gyro.z * GYRO_DEG_PER_RAD);
+        oled_ui_set_number(ui_temp, s->temp.celsius);
+        oled_ui_set_text(ui_status, "MONITORING");
+        oled_ui_set_counter(ui_samples, (uint32_t)total_samples);
+        oled_ui_refresh((uint32_t)(i * LOOP_PERIOD_MS));
+
+        uint64_t elapsed = now_ns() - iter_start;
+        if (elapsed > worst_ns) {
+            worst_ns = elapsed;
+        }
+    }
+
+    double wall_s = (double)(now_ns() - start_ns) / 1e9;
+    oled_stats_t os;
+    oled_ui_stats_t us;
+    activity_stats_t as;
+    impact_stats_t is;
+    impact_capture_get_stats(&capture, &is);
+    oled_get_stats(&os);
+    oled_ui_get_stats(&us);
+    activity_gate_get_stats(&gate, &as);
+
+    printf("Host - %.0f s of sensor time at %u Hz in %.3f s wall time\n",
+           seconds, (unsigned)config.rate_hz, wall_s);
+    printf("Host - %llu samples, %.0f samples/s, loop avg %.2f us, worst %.2f us\n",
+           (unsigned long long)total_samples, total_samples / wall_s,
+           iterations > 0 ? wall_s * 1e6 / iterations : 0.0, worst_ns / 1e3);
+    printf("Host - OLED %lu frames, %lu bytes (%.1f per frame, full frame %u)\n",
+           (unsigned long)os.frames, (unsigned long)os.total_bytes,
+           os.frames > 0 ? (double)os.total_bytes / os.frames : 0.0, (unsigned)OLED_BUFFER_SIZE);
+    printf("Host - UI %lu widgets drawn, %lu of %lu updates unchanged\n",
+           (unsigned long)us.widgets_drawn, (unsigned long)us.updates_unchanged,
+           (unsigned long)us.updates);
+    uint32_t frames = as.samples_sent + as.summaries_sent;
+    uint32_t ungated = (uint32_t)(seconds * 1000.0 / 100);
+    printf("Host - Radio %lu frames (%lu samples, %lu summaries), %lu activations, active %lu s; "
+           "%.1f%% of ungated 10 Hz\n",
+           (unsigned long)frames, (unsigned long)as.samples_sent, (unsigned long)as.summaries_sent,
+           (unsigned long)as.activations, (unsigned long)(as.active_ms / 1000),
+           ungated > 0 ? 100.0 * frames / ungated : 0.0);
+    printf("Host - Impacts %lu (%lu missed), %lu chunks, %lu samples decoded (%lu errors), "
+           "%lu -> %lu bytes (%.1fx)\n",
+           (unsigned long)is.impacts, (unsigned long)is.impacts_missed, (unsigned long)is.chunks,
+           (unsigned long)burst_samples, (unsigned long)burst_errors, (unsigned long)is.raw_bytes,
+           (unsigned long)is.burst_bytes,
+           is.burst_bytes > 0 ? (double)is.raw_bytes / is.burst_bytes : 0.0);
+
+    if (radio_enabled) {
+        hub_receive(UINT64_MAX);
+        link_sim_stats_t ls;
+        link_sim_get_stats(&radio, &ls);
+        printf("Host - Link %lu frames sent, %lu lost (%.1f%%), %lu retransmissions, %lu duplicates, "
+               "%lu reordered, %lu refused, %lu attempts in bursts\n",
+               (unsigned long)ls.sent, (unsigned long)ls.lost,
+               ls.sent > 0 ? 100.0 * ls.lost / ls.sent : 0.0, (unsigned long)ls.retransmissions,
+               (unsigned long)ls.duplicates, (unsigned long)ls.reordered, (unsigned long)ls.refused,
+               (unsigned long)ls.burst_attempts);
+        printf("Host - Link goodput %.2f of %.2f kbit/s offered (%.1f%%), latency p50 %.1f ms, p99 %.1f ms, max %.1f ms\n",
+               ls.bytes_delivered * 8.0 / seconds / 1000.0, ls.bytes_sent * 8.0 / seconds / 1000.0,
+               ls.bytes_sent > 0 ? 100.0 * ls.bytes_delivered / ls.bytes_sent : 0.0,
+               latency_hist_percentile(&hub.link_latency, 0.5f) / 1000.0,
+               latency_hist_percentile(&hub.link_latency, 0.99f) / 1000.0,
+               hub.link_latency.max_us / 1000.0);
+        printf("Host - Hub received %lu of %lu samples, %lu of %lu summaries, %lu bursts complete of %lu\n",
+               (unsigned long)hub.samples, (unsigned long)as.samples_sent,
+               (unsigned long)hub.summaries, (unsigned long)as.summaries_sent,
+               (unsigned long)hub.bursts_complete, (unsigned long)is.bursts);
+        printf("Host - Alerts %lu of %lu delivered, impact to hub p50 %.0f ms, p95 %.0f ms, max %.0f ms\n",
+               (unsigned long)hub.alerts, (unsigned long)alerts_sent,
+               latency_hist_percentile(&hub.alert_latency, 0.5f) / 1000.0,
+               latency_hist_percentile(&hub.alert_latency, 0.95f) / 1000.0,
+               hub.alert_latency.max_us / 1000.0);
+    }
+
+    if (oled_host_dump_pbm(pbm_path)) {
+        printf("Host - Final screen written to %s\n", pbm_path);
+    }
+
+    oled_cleanup();
+    mpu6050_cleanup();
+    return 0;
+}
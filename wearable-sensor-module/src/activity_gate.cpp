@@ -0,0 +1,119 @@
+// Activity Gate - Decides when the wearable streams full-rate samples
+#include "activity_gate.h"
+#include <math.h>
+#include <string.h>
+
+#define GRAVITY 9.80665f
+
+static const activity_config_t DEFAULT_CONFIG = {
+    0.5f,       // enter_threshold
+    0.25f,      // exit_threshold
+    3000,       // hold_ms
+    100,        // stream_interval_ms (10 Hz, as before gating)
+    10000       // summary_interval_ms
+};
+
+static void reset_window(activity_gate_t *gate, uint32_t time_ms)
+{
+    gate->window_start_ms = time_ms;
+    gate->window_samples = 0;
+    gate->sq_sum = 0.0f;
+    gate->sq_min = INFINITY;
+    gate->sq_max = 0.0f;
+    gate->energy_sum = 0.0f;
+}
+
+void activity_gate_init(activity_gate_t *gate, const activity_config_t *config)
+{
+    memset(gate, 0, sizeof(*gate));
+    gate->config = (config != NULL) ? *config : DEFAULT_CONFIG;
+    gate->state = ACTIVITY_STILL;
+    reset_window(gate, 0);
+}
+
+activity_action_t activity_gate_update(activity_gate_t *gate, const mpu6050_sample_t *sample,
+                                       uint32_t time_ms)
+{
+    const activity_config_t *cfg = &gate->config;
+
+    // Motion energy: |(|a|^2 - g^2)| / 2g approximates ||a| - g| without sqrt
+    float sq = sample->accel.x * sample->accel.x +
+               sample->accel.y * sample->accel.y +
+               sample->accel.z * sample->accel.z;
+    float motion = fabsf(sq - GRAVITY * GRAVITY) * (0.5f / GRAVITY) +
+                   fabsf(sample->gyro.x) + fabsf(sample->gyro.y) + fabsf(sample->gyro.z);
+    gate->energy += (motion - gate->energy) * (1.0f / (1 << ACTIVITY_EWMA_SHIFT));
+
+    if (gate->stats.samples_seen == 0) {
+        gate->last_time_ms = time_ms;
+        reset_window(gate, time_ms);
+    }
+    gate->stats.samples_seen++;
+    if (gate->state == ACTIVITY_ACTIVE) {
+        gate->stats.active_ms += time_ms - gate->last_time_ms;
+    }
+    gate->last_time_ms = time_ms;
+
+    gate->window_samples++;
+    gate->sq_sum += sq;
+    gate->sq_min = fminf(gate->sq_min, sq);
+    gate->sq_max = fmaxf(gate->sq_max, sq);
+    gate->energy_sum += motion;
+
+    if (gate->energy > cfg->exit_threshold) {
+        gate->last_motion_ms = time_ms;
+    }
+
+    if (gate->state == ACTIVITY_STILL) {
+        if (gate->energy >= cfg->enter_threshold) {
+            gate->state = ACTIVITY_ACTIVE;
+            gate->stats.activations++;
+            gate->last_send_ms = time_ms;
+            gate->stats.samples_sent++;
+            return ACTIVITY_SEND_SAMPLE;
+        }
+        if (time_ms - gate->window_start_ms >= cfg->summary_interval_ms) {
+            return ACTIVITY_SEND_SUMMARY;
+        }
+        return ACTIVITY_SEND_NOTHING;
+    }
+
+    if (time_ms - gate->last_motion_ms >= cfg->hold_ms) {
+        // Still again: summaries cover only the still period
+        gate->state = ACTIVITY_STILL;
+        reset_window(gate, time_ms);
+        return ACTIVITY_SEND_NOTHING;
+    }
+    if (time_ms - gate->last_send_ms >= cfg->stream_interval_ms) {
+        gate->last_send_ms = time_ms;
+        gate->stats.samples_sent++;
+        return ACTIVITY_SEND_SAMPLE;
+    }
+    return ACTIVITY_SEND_NOTHING;
+}
+
+void activity_gate_take_summary(activity_gate_t *gate, sensor_summary_t *out)
+{
+    uint32_t n = (gate->window_samples > 0) ? gate->window_samples : 1;
+    out->accel_rms = sqrtf(gate->sq_sum / n);
+    out->accel_min = (gate->window_samples > 0) ? sqrtf(gate->sq_min) : 0.0f;
+    out->accel_max = sqrtf(gate->sq_max);
+    out->motion_energy = gate->energy_sum / n;
+    out->samples = (uint16_t)(gate->window_samples > 0xFFFF ? 0xFFFF : gate->window_samples);
+    uint32_t window = gate->last_time_ms - gate->window_start_ms;
+    out->window_ms = (uint16_t)(window > 0xFFFF ? 0xFFFF : window);
+    out->timestamp = gate->last_time_ms;
+
+    gate->stats.summaries_sent++;
+    reset_window(gate, gate->last_time_ms);
+}
+
+void activity_gate_set_stream_interval(activity_gate_t *gate, uint32_t interval_ms)
+{
+    gate->config.stream_interval_ms = interval_ms;
+}
+
+void activity_gate_get_stats(const activity_gate_t *gate, activity_stats_t *stats)
+{
+    *stats = gate->stats;
+}
@@ -0,0 +1,106 @@
+// Activity Gate - Decides when the wearable streams full-rate samples
+// Every sample updates a cheap motion-energy measure (deviation of |a|^2 from
+// gravity plus L1 gyro rate, no square root) smoothed by an EWMA. While it
+// stays below the enter threshold the wearer is still and only a
+// SENSOR_SUMMARY is sent every summary interval; above it the gate streams
+// SENSOR_DATA at the stream interval until motion has stayed below the exit
+// threshold for the hold time.
+
+#ifndef _ACTIVITY_GATE_H_
+#define _ACTIVITY_GATE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "hal/mpu6050.h"
+#include "protocol.h"
+
+// EWMA smoothing: energy += (sample - energy) >> ACTIVITY_EWMA_SHIFT
+#define ACTIVITY_EWMA_SHIFT 3
+
+// Gate states
+typedef enum {
+    ACTIVITY_STILL = 0,
+    ACTIVITY_ACTIVE
+} activity_state_t;
+
+// What the caller should transmit for this sample
+typedef enum {
+    ACTIVITY_SEND_NOTHING = 0,
+    ACTIVITY_SEND_SAMPLE,       // SENSOR_DATA with this sample
+    ACTIVITY_SEND_SUMMARY       // SENSOR_SUMMARY from activity_gate_take_summary()
+} activity_action_t;
+
+// Gate tuning
+typedef struct {
+    float enter_threshold;          // Smoothed energy that starts streaming
+    float exit_threshold;           // Smoothed energy considered still again
+    uint32_t hold_ms;               // Keep streaming this long after motion stops
+    uint32_t stream_interval_ms;    // SENSOR_DATA period while active
+    uint32_t summary_interval_ms;   // SENSOR_SUMMARY period while still
+} activity_config_t;
+
+// Transmission counters
+typedef struct {
+    uint32_t samples_seen;
+    uint32_t samples_sent;
+    uint32_t summaries_sent;
+    uint32_t activations;           // STILL -> ACTIVE transitions
+    uint32_t active_ms;             // Time spent streaming
+} activity_stats_t;
+
+typedef struct {
+    activity_config_t config;
+    activity_state_t state;
+    float energy;                   // Smoothed motion energy
+    uint32_t last_time_ms;
+    uint32_t last_motion_ms;        // Last time energy exceeded exit_threshold
+    uint32_t last_send_ms;
+    // Current summary window
+    uint32_t window_start_ms;
+    uint32_t window_samples;
+    float sq_sum;
+    float sq_min;
+    float sq_max;
+    float energy_sum;
+    activity_stats_t stats;
+} activity_gate_t;
+
+/**
+ * Initialize a gate
+ * @param gate Gate to initialize
+ * @param config Tuning, or NULL for defaults (100 ms stream, 10 s summaries)
+ */
+void activity_gate_init(activity_gate_t *gate, const activity_config_t *config);
+
+/**
+ * Feed one sample
+ * @param gate Gate
+ * @param sample Sample in SI units
+ * @param time_ms Sample time (ms)
+ * @return What to transmit now
+ */
+activity_action_t activity_gate_update(activity_gate_t *gate, const mpu6050_sample_t *sample,
+                                       uint32_t time_ms);
+
+/**
+ * Take the summary of the current window and start a new one
+ * @param gate Gate
+ * @param out Summary to send
+ */
+void activity_gate_take_summary(activity_gate_t *gate, sensor_summary_t *out);
+
+/**
+ * Change the streaming period (e.g. from a hub configuration update)
+ * @param gate Gate
+ * @param interval_ms New SENSOR_DATA period while active
+ */
+void activity_gate_set_stream_interval(activity_gate_t *gate, uint32_t interval_ms);
+
+/**
+ * Get transmission counters
+ * @param gate Gate
+ * @param stats Pointer to store the counters
+ */
+void activity_gate_get_stats(const activity_gate_t *gate, activity_stats_t *stats);
+
+#endif // _ACTIVITY_GATE_H_
@@ -0,0 +1,200 @@
+// Impact Capture - Pre-impact history and FALL_DETECTED burst upload
+#include "impact_capture.h"
+#include "common/burst_codec.h"
+#include <math.h>
+#include <string.h>
+
+#define GRAVITY 9.80665f
+
+// A free-fall run ending at most this long before the impact is part of the fall
+#define FREEFALL_GAP_MS 500
+
+// Impact (g) reported as severity 255
+#define SEVERITY_FULL_SCALE_G 8.0f
+
+static const impact_config_t DEFAULT_CONFIG = {
+    2.5f,       // threshold_g
+    0.6f,       // freefall_g
+    2000,       // pre_ms
+    1000        // post_ms
+};
+
+static void reset_history(impact_capture_t *cap)
+{
+    cap->written = 0;
+    cap->in_freefall = false;
+    cap->freefall_start_ms = 0;
+    cap->freefall_end_ms = 0;
+}
+
+void impact_capture_init(impact_capture_t *cap, const impact_config_t *config, uint16_t rate_hz)
+{
+    memset(cap, 0, sizeof(*cap));
+    cap->config = (config != NULL) ? *config : DEFAULT_CONFIG;
+    cap->state = IMPACT_ARMED;
+    cap->rate_hz = rate_hz;
+    reset_history(cap);
+}
+
+void impact_capture_set_rate(impact_capture_t *cap, uint16_t rate_hz)
+{
+    if (rate_hz == cap->rate_hz || rate_hz == 0) {
+        cap->pending_rate_hz = 0;
+        return;
+    }
+    if (cap->state != IMPACT_ARMED) {
+        cap->pending_rate_hz = rate_hz;
+        return;
+    }
+    cap->rate_hz = rate_hz;
+    cap->pending_rate_hz = 0;
+    reset_history(cap);
+}
+
+void impact_capture_set_threshold(impact_capture_t *cap, float threshold_g)
+{
+    cap->config.threshold_g = threshold_g;
+}
+
+// Start a capture at the sample just written
+static void trigger(impact_capture_t *cap, const mpu6050_sample_t *sample, float sq, uint32_t time_ms)
+{
+    uint32_t post = cap->config.post_ms * cap->rate_hz / 1000;
+    uint32_t pre = cap->config.pre_ms * cap->rate_hz / 1000;
+    if (post >= IMPACT_RING_SIZE) {
+        post = IMPACT_RING_SIZE / 2;
+    }
+    if (pre + post + 1 > IMPACT_RING_SIZE) {
+        pre = IMPACT_RING_SIZE - post - 1;
+    }
+
+    cap->impact_index = cap->written - 1;
+    cap->window_start = (cap->impact_index > pre) ? cap->impact_index - pre : 0;
+    cap->window_end = cap->impact_index + post + 1;
+    cap->peak_sq = sq;
+    cap->burst_id++;
+    cap->stats.impacts++;
+    cap->state = IMPACT_POST;
+
+    fall_detected_t *r = &cap->report;
+    memset(r, 0, sizeof(*r));
+    r->pre_impact_x = sample->accel.x;
+    r->pre_impact_y = sample->accel.y;
+    r->pre_impact_z = sample->accel.z;
+    r->timestamp = time_ms;
+    bool recent_freefall = cap->freefall_end_ms > cap->freefall_start_ms &&
+                           time_ms - cap->freefall_end_ms <= FREEFALL_GAP_MS;
+    r->duration = recent_freefall ? time_ms - cap->freefall_start_ms : 0;
+}
+
+bool impact_capture_update(impact_capture_t *cap, const mpu6050_sample_t *sample, uint32_t time_ms)
+{
+    float sq = sample->accel.x * sample->accel.x +
+               sample->accel.y * sample->accel.y +
+               sample->accel.z * sample->accel.z;
+    float threshold = cap->config.threshold_g * GRAVITY;
+    bool above = sq >= threshold * threshold;
+    bool rising = above && !cap->above_threshold;
+    cap->above_threshold = above;
+
+    if (cap->state == IMPACT_READY || cap->state == IMPACT_SENDING) {
+        // History is frozen until the burst is out
+        if (rising) {
+            cap->stats.impacts_missed++;
+        }
+        return false;
+    }
+
+    const float accel[3] = { sample->accel.x, sample->accel.y, sample->accel.z };
+    const float gyro[3] = { sample->gyro.x, sample->gyro.y, sample->gyro.z };
+    burst_quantize(accel, gyro, cap->ring[cap->written % IMPACT_RING_SIZE]);
+    cap->written++;
+
+    if (cap->state == IMPACT_ARMED) {
+        float freefall = cap->config.freefall_g * GRAVITY;
+        bool falling = sq < freefall * freefall;
+        if (falling && !cap->in_freefall) {
+            cap->freefall_start_ms = time_ms;
+        } else if (!falling && cap->in_freefall) {
+            cap->freefall_end_ms = time_ms;
+        }
+        cap->in_freefall = falling;
+
+        if (rising) {
+            trigger(cap, sample, sq, time_ms);
+        }
+        return false;
+    }
+
+    // IMPACT_POST
+    if (sq > cap->peak_sq) {
+        cap->peak_sq = sq;
+    }
+    if (cap->written < cap->window_end) {
+        return false;
+    }
+
+    float impact_g = sqrtf(cap->peak_sq) / GRAVITY;
+    float severity = impact_g * (255.0f / SEVERITY_FULL_SCALE_G);
+    cap->report.impact = impact_g;
+    cap->report.severity = (uint8_t)(severity > 255.0f ? 255.0f : severity);
+    cap->state = IMPACT_READY;
+    return true;
+}
+
+bool impact_capture_take_report(impact_capture_t *cap, fall_detected_t *out)
+{
+    if (cap->state != IMPACT_READY) {
+        return false;
+    }
+    *out = cap->report;
+    cap->next_index = cap->window_start;
+    cap->next_chunk = 0;
+    cap->state = IMPACT_SENDING;
+    return true;
+}
+
+size_t impact_capture_next_chunk(impact_capture_t *cap, impact_burst_t *out)
+{
+    if (cap->state != IMPACT_SENDING) {
+        return 0;
+    }
+
+    // Chunks stop at the ring wrap so the codec always sees contiguous samples
+    uint32_t slot = cap->next_index % IMPACT_RING_SIZE;
+    uint32_t count = cap->window_end - cap->next_index;
+    if (count > IMPACT_RING_SIZE - slot) {
+        count = IMPACT_RING_SIZE - slot;
+    }
+
+    out->burst_id = cap->burst_id;
+    out->chunk = cap->next_chunk++;
+    out->flags = 0;
+    out->rate_hz = cap->rate_hz;
+    out->first_index = (int16_t)((int32_t)cap->next_index - (int32_t)cap->impact_index);
+    int packed = burst_encode(&cap->ring[slot], (int)count, out);
+    cap->next_index += (uint32_t)packed;
+
+    size_t len = BURST_HEADER_SIZE + out->data_len;
+    cap->stats.chunks++;
+    cap->stats.raw_bytes += (uint32_t)packed * IMPACT_BURST_CHANNELS * sizeof(int16_t);
+    cap->stats.burst_bytes += (uint32_t)len;
+
+    if (cap->next_index >= cap->window_end) {
+        // Resume recording; the frozen period left a gap, so start fresh
+        out->flags |= IMPACT_BURST_LAST;
+        cap->stats.bursts++;
+        cap->state = IMPACT_ARMED;
+        if (cap->pending_rate_hz != 0) {
+            cap->rate_hz = cap->pending_rate_hz;
+            cap->pending_rate_hz = 0;
+        }
+        reset_history(cap);
+    }
+    return len;
+}
+
+void impact_capture_get_stats(const impact_capture_t *cap, impact_stats_t *stats)
+{
+    *stats = cap->stats;
+}
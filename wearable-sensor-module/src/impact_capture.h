@@ -0,0 +1,127 @@
+// Impact Capture - Pre-impact history and FALL_DETECTED burst upload
+// Every sample is quantized into a ring covering the last few seconds. When
+// |a| crosses the impact threshold the capture keeps recording for the
+// post-impact window, then freezes the ring and hands out one FALL_DETECTED
+// report followed by IMPACT_BURST chunks of the whole window (see
+// common/burst_codec.h). New impacts while a capture is pending are counted
+// but not captured.
+
+#ifndef _IMPACT_CAPTURE_H_
+#define _IMPACT_CAPTURE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "hal/mpu6050.h"
+#include "protocol.h"
+
+// Ring capacity in samples (12 bytes each); bounds the window at high rates
+#define IMPACT_RING_SIZE 1024
+
+// Capture states
+typedef enum {
+    IMPACT_ARMED = 0,       // Recording history, waiting for an impact
+    IMPACT_POST,            // Impact seen, recording the post-impact window
+    IMPACT_READY,           // Window complete, FALL_DETECTED not yet taken
+    IMPACT_SENDING          // Burst chunks being handed out
+} impact_state_t;
+
+// Capture tuning
+typedef struct {
+    float threshold_g;          // |a| that counts as an impact
+    float freefall_g;           // |a| below this counts as free fall
+    uint32_t pre_ms;            // History kept before the impact
+    uint32_t post_ms;           // Recorded after the impact
+} impact_config_t;
+
+// Capture counters
+typedef struct {
+    uint32_t impacts;           // Captures started
+    uint32_t impacts_missed;    // Impacts while a capture was pending
+    uint32_t bursts;            // Bursts fully handed out
+    uint32_t chunks;
+    uint32_t raw_bytes;         // Samples x 12 bytes
+    uint32_t burst_bytes;       // Encoded chunk payload bytes
+} impact_stats_t;
+
+typedef struct {
+    impact_config_t config;
+    impact_state_t state;
+    uint16_t rate_hz;
+    uint16_t pending_rate_hz;   // Rate change deferred until re-armed
+    int16_t ring[IMPACT_RING_SIZE][IMPACT_BURST_CHANNELS];
+    uint32_t written;           // Samples written since the ring was reset
+    bool above_threshold;       // Previous sample was above the impact threshold
+    // Free-fall run tracking
+    bool in_freefall;
+    uint32_t freefall_start_ms;
+    uint32_t freefall_end_ms;
+    // Current capture
+    uint32_t impact_index;      // Absolute index of the trigger sample
+    uint32_t window_start;      // Absolute index of the first sample to send
+    uint32_t window_end;        // One past the last sample to send
+    uint32_t next_index;        // Next sample to encode
+    uint16_t burst_id;
+    uint8_t next_chunk;
+    float peak_sq;              // Largest |a|^2 in the post window
+    fall_detected_t report;
+    impact_stats_t stats;
+} impact_capture_t;
+
+/**
+ * Initialize a capture
+ * @param cap Capture to initialize
+ * @param config Tuning, or NULL for defaults (2.5 g, 2 s before, 1 s after)
+ * @param rate_hz Current sample rate
+ */
+void impact_capture_init(impact_capture_t *cap, const impact_config_t *config, uint16_t rate_hz);
+
+/**
+ * Track the sample rate; history is discarded on change (deferred while a
+ * capture is pending)
+ * @param cap Capture
+ * @param rate_hz Current sample rate
+ */
+void impact_capture_set_rate(impact_capture_t *cap, uint16_t rate_hz);
+
+/**
+ * Change the impact threshold (e.g. from a hub configuration update)
+ * @param cap Capture
+ * @param threshold_g New threshold (g)
+ */
+void impact_capture_set_threshold(impact_capture_t *cap, float threshold_g);
+
+/**
+ * Feed one sample
+ * @param cap Capture
+ * @param sample Sample in SI units
+ * @param time_ms Sample time (ms)
+ * @return true when a capture window has just completed
+ */
+bool impact_capture_update(impact_capture_t *cap, const mpu6050_sample_t *sample, uint32_t time_ms);
+
+/**
+ * Take the FALL_DETECTED report of a completed capture and start handing
+ * out its burst
+ * @param cap Capture (state IMPACT_READY)
+ * @param out Report to send
+ * @return true if a report was available
+ */
+bool impact_capture_take_report(impact_capture_t *cap, fall_detected_t *out);
+
+/**
+ * Encode the next burst chunk; re-arms after the last one
+ * @param cap Capture (state IMPACT_SENDING)
+ * @param out Chunk to send
+ * @return Payload bytes to send (header + used data), or 0 if none is left
+ */
+size_t impact_capture_next_chunk(impact_capture_t *cap, impact_burst_t *out);
+
+/**
+ * Get capture counters
+ * @param cap Capture
+ * @param stats Pointer to store the counters
+ */
+void impact_capture_get_stats(const impact_capture_t *cap, impact_stats_t *stats);
+
+#endif // _IMPACT_CAPTURE_H_
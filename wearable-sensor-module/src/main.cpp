@@ -18,15 +18,21 @@
 
 #include <Arduino.h>
 #include <Wire.h>
-#include <Adafruit_GFX.h>
-#include <Adafruit_SSD1306.h>
-#include <Adafruit_MPU6050.h>
-#include <Adafruit_Sensor.h>
+#include "hal/mpu6050.h"
+#include "hal/oled.h"
+#include "hal/oled_ui.h"
+#include "hal/sampler.h"
+#include "common/dlog.h"
+#include "protocol.h"
+#include "activity_gate.h"
+#include "impact_capture.h"
+#include "wearable_config.h"
 #include <WiFi.h>
 extern "C" {
   #include <esp_now.h>
   #include <esp_wifi.h>
   #include <esp_wifi_types.h>
+  #include <esp_timer.h>
 }
 
 // Version compatibility for ESP32 Arduino Core
@@ -36,16 +42,47 @@ extern "C" {
 #endif
 
 // ===== OLED Configuration =====
-#define OLED_WIDTH  128
-#define OLED_HEIGHT 64
-#define OLED_ADDR   0x3C
 #define OLED_SDA    21
 #define OLED_SCL    22
 
-Adafruit_SSD1306 display(OLED_WIDTH, OLED_HEIGHT, &Wire, -1);
-
 // ===== MPU-6050 Configuration =====
-Adafruit_MPU6050 mpu;
+// settings.profile (NORMAL unless the hub changes it) while monitoring;
+// IMPACT (+-16g, 500 Hz) once the hub suspects a fall
+const uint8_t IMPACT_PROFILE_STATE = 2;  // FALL_SUSPECTED
+mpu6050_profile_t requestedProfile = MPU6050_PROFILE_NORMAL;
+
+// ===== Runtime Configuration =====
+// CONFIG frames are queued by the receive callback and applied in loop()
+typedef struct {
+  uint8_t len;            // Payload bytes received
+  config_t config;
+} config_frame_t;
+
+const int CONFIG_QUEUE_DEPTH = 4;
+QueueHandle_t configQueue = NULL;
+wearable_settings_t settings;
+unsigned long configCount = 0;
+unsigned long configRejectCount = 0;
+
+// ===== Clock Sync =====
+// TIME_SYNC requests get t1 stamped on arrival and t2 just before the reply
+const int TIME_SYNC_QUEUE_DEPTH = 2;
+QueueHandle_t timeSyncQueue = NULL;
+unsigned long timeSyncCount = 0;
+
+// Samples drained from the sampler ring per loop iteration
+#define SAMPLE_BATCH 32
+sampler_sample_t sampleBatch[SAMPLE_BATCH];
+sampler_sample_t latestSample{};
+
+// Impact capture: FALL_DETECTED first, then the burst a few chunks per loop
+// so the ESP-NOW send queue never overflows
+const int BURST_CHUNKS_PER_LOOP = 4;
+impact_capture_t impactCapture;
+fall_detected_t pendingFall;
+bool fallPending = false;
+impact_burst_t burstChunk;
+size_t burstChunkLen = 0;
 
 // ===== ESP-NOW Configuration =====
 // Communication Hub's MAC address (your friend's ESP32)
@@ -53,39 +90,26 @@ uint8_t HUB_PEER_MAC[6] = {0xEC, 0xE3, 0x34, 0xDA, 0x5D, 0xB4};  // Friend's ESP
 
 const uint8_t WIFI_CHANNEL = 1;  // Must match hub
 
-// ===== Data Structures (matching protocol.h) =====
-
-// RAW sensor data sent TO hub
-typedef struct __attribute__((packed)) {
-  float accel_x;      // m/s²
-  float accel_y;
-  float accel_z;
-  float gyro_x;       // rad/s
-  float gyro_y;
-  float gyro_z;
-  float temperature;  // °C
-  uint32_t timestamp; // milliseconds
-} sensor_data_t;
-
-// Processed data received FROM hub
-typedef struct __attribute__((packed)) {
-  uint8_t state;          // System state (0=IDLE, 1=MONITORING, 2=FALL_SUSPECTED, 3=FALL_CONFIRMED)
-  uint8_t fall_severity;  // 0-255
-  float fall_confidence;  // 0.0-1.0
-  uint32_t timestamp;     // milliseconds
-  uint8_t reserved[6];    // Padding to 16 bytes (1+1+4+4+6=16)
-} fall_status_t;
+// ===== Data Structures =====
+// Frames TO the hub are one PKT_xxx type byte plus a protocol.h payload
+
+// Frames FROM the hub are typed the same way (the type byte is required):
+// FALL_STATUS, CONFIG and TIME_SYNC
 
 static_assert(sizeof(sensor_data_t) == 32, "sensor_data_t must be 32 bytes");
+static_assert(sizeof(sensor_summary_t) == 24, "sensor_summary_t must be 24 bytes");
+static_assert(sizeof(fall_detected_t) == 28, "fall_detected_t must be 28 bytes");
 static_assert(sizeof(fall_status_t) == 16, "fall_status_t must be 16 bytes");
 
 // ===== State Variables =====
 volatile bool haveReply = false;
 volatile fall_status_t lastFallStatus{};
 unsigned long lastReplyMs = 0;
-unsigned long lastSendMs = 0;
+activity_gate_t activityGate;
 unsigned long sensorReadCount = 0;
 unsigned long sendErrorCount = 0;
+unsigned long unknownFrameCount = 0;
+unsigned long lastStatsMs = 0;
 
 // State names for display
 const char* STATE_NAMES[] = {
@@ -98,11 +122,12 @@ const char* STATE_NAMES[] = {
 
 // ===== ESP-NOW Callbacks =====
 
+// Callbacks run on the Wi-Fi task: log through dlog (a ring write), never Serial
 void onDataSent(const uint8_t *mac_addr, esp_now_send_status_t status) {
   if (status == ESP_NOW_SEND_SUCCESS) {
-    Serial.println("[TX] Sensor data sent successfully");
+    DLOG_DEBUG("[TX] Frame delivered");
   } else {
-    Serial.println("[TX] Send failed!");
+    DLOG_WARN("[TX] Delivery failed");
     sendErrorCount++;
   }
 }
@@ -117,19 +142,41 @@ void onDataRecv(const uint8_t *mac, const uint8_t *data, int len) {
   info_compat.src_addr = mac;
   const auto *info = &info_compat;
 #endif
-  if (len >= (int)sizeof(fall_status_t)) {
+  int64_t rxUs = esp_timer_get_time();
+  if (len < 1) {
+    return;
+  }
+  uint8_t type = data[0];  // Always typed (protocol.h)
+  data++;
+  len--;
+  
+  if (type == PKT_TIME_SYNC && len >= (int)sizeof(time_sync_t)) {
+    time_sync_t sync;
+    memcpy(&sync, data, sizeof(sync));
+    sync.t1_us = rxUs;
+    if (xQueueSend(timeSyncQueue, &sync, 0) != pdTRUE) {
+      DLOG_WARN("[RX] Time sync queue full, dropped #%lu", (unsigned long)sync.seq);
+    }
+  } else if (type == PKT_CONFIG) {
+    // Applied in loop(); the Wi-Fi task must not touch the sampler or display
+    config_frame_t frame{};
+    frame.len = (uint8_t)min(len, (int)sizeof(config_t));
+    memcpy(&frame.config, data, frame.len);
+    if (xQueueSend(configQueue, &frame, 0) != pdTRUE) {
+      DLOG_WARN("[RX] Config queue full, dropped config %u", frame.config.config_id);
+    }
+  } else if (type == PKT_FALL_STATUS && len >= (int)sizeof(fall_status_t)) {
     memcpy((void*)&lastFallStatus, data, sizeof(fall_status_t));
     haveReply = true;
     lastReplyMs = millis();
     
     uint8_t state_val = lastFallStatus.state;  // Copy volatile to local
-    Serial.printf("[RX] Fall Status from %02X:%02X:%02X:%02X:%02X:%02X\n",
-      info->src_addr[0], info->src_addr[1], info->src_addr[2],
-      info->src_addr[3], info->src_addr[4], info->src_addr[5]);
-    Serial.printf("     State=%s, Severity=%d, Confidence=%.2f\n",
-      STATE_NAMES[min(state_val, (uint8_t)4)],
-      lastFallStatus.fall_severity,
-      lastFallStatus.fall_confidence);
+    DLOG_INFO("[RX] Fall Status from ..:%02X:%02X:%02X:%02X",
+      info->src_addr[2], info->src_addr[3], info->src_addr[4], info->src_addr[5]);
+    DLOG_INFO("     State=%u, Severity=%d, Confidence=%.2f",
+      state_val, lastFallStatus.fall_severity, lastFallStatus.fall_confidence);
+  } else {
+    unknownFrameCount++;
   }
 }
 
@@ -160,10 +207,10 @@ void initESPNow() {
   // Initialize ESP-NOW
   if (esp_now_init() != ESP_OK) {
     Serial.println("[ERROR] ESP-NOW initialization failed!");
-    display.clearDisplay();
-    display.setCursor(0, 0);
-    display.println("ESP-NOW INIT FAIL");
-    display.display();
+    oled_clear();
+    oled_set_cursor(0, 0);
+    oled_println("ESP-NOW INIT FAIL");
+    oled_display();
     while (1) delay(1000);
   }
   Serial.println("[OK] ESP-NOW initialized");
@@ -190,10 +237,10 @@ void initESPNow() {
   
   if (esp_now_add_peer(&peerInfo) != ESP_OK) {
     Serial.println("[ERROR] Failed to add peer!");
-    display.clearDisplay();
-    display.setCursor(0, 0);
-    display.println("PEER ADD FAIL");
-    display.display();
+    oled_clear();
+    oled_set_cursor(0, 0);
+    oled_println("PEER ADD FAIL");
+    oled_display();
     while (1) delay(1000);
   }
   
@@ -206,12 +253,125 @@ void initESPNow() {
   Serial.println("=== Ready to Send ===\n");
 }
 
-// ===== OLED Helper Functions =====
+// ===== Frame Transmission =====
+
+// Send one frame: PKT_xxx type byte followed by the payload
+bool sendFrame(uint8_t type, const void *payload, size_t len) {
+  uint8_t frame[PROTOCOL_ESPNOW_MAX_FRAME];
+  frame[0] = type;
+  memcpy(frame + 1, payload, len);
+  
+  esp_err_t result = esp_now_send(HUB_PEER_MAC, frame, len + 1);
+  if (result != ESP_OK) {
+    if (result == 12396) {
+      DLOG_WARN("[TX] Send error: %d (ESP_ERR_ESPNOW_NOT_FOUND - Peer not found!)", (int)result);
+    } else if (result == 12389) {
+      DLOG_WARN("[TX] Send error: %d (ESP_ERR_ESPNOW_NOT_INIT - ESP-NOW not initialized!)", (int)result);
+    } else if (result == 12394) {
+      DLOG_WARN("[TX] Send error: %d (ESP_ERR_ESPNOW_ARG - Invalid argument!)", (int)result);
+    } else {
+      DLOG_WARN("[TX] Send error: %d", (int)result);
+    }
+    sendErrorCount++;
+    return false;
+  }
+  return true;
+}
+
+// Echo a TIME_SYNC request with our receive and reply times
+void replyTimeSync(time_sync_t &sync) {
+  sync.t2_us = esp_timer_get_time();
+  if (sendFrame(PKT_TIME_SYNC, &sync, sizeof(sync))) {
+    timeSyncCount++;
+  }
+}
+
+// Sample time on the millis() clock. The sampler stamps samples with 32-bit
+// micros(), which wraps every ~71 minutes; anchoring the stamp to the 64-bit
+// esp_timer keeps packet timestamps continuous and comparable across the
+// hub's clock sync.
+uint32_t sampleMillis(const sampler_sample_t &s, int64_t nowUs) {
+  uint32_t age = (uint32_t)nowUs - s.time_us;
+  return (uint32_t)((nowUs - age) / 1000);
+}
+
+// Validate and apply one CONFIG from the hub, push what changed, and ACK it
+void applyConfig(const config_frame_t &frame) {
+  wearable_settings_t previous = settings;
+  uint8_t status = wearable_config_apply(&settings, &frame.config, frame.len);
+  
+  if (settings.send_interval_ms != previous.send_interval_ms) {
+    activity_gate_set_stream_interval(&activityGate, settings.send_interval_ms);
+  }
+  if (settings.fall_threshold_g != previous.fall_threshold_g) {
+    impact_capture_set_threshold(&impactCapture, settings.fall_threshold_g);
+  }
+  if (settings.brightness != previous.brightness) {
+    oled_set_brightness(settings.brightness);
+  }
+  // settings.profile is picked up by the profile selection in loop()
+  
+  if (status == ACK_STATUS_OK) {
+    configCount++;
+    DLOG_INFO("[CONFIG] Applied config %u", frame.config.config_id);
+  } else {
+    configRejectCount++;
+    DLOG_WARN("[CONFIG] Rejected config %u (status %u, %u bytes)",
+      frame.config.config_id, status, frame.len);
+  }
+  
+  ack_t ack{};
+  ack.ack_type = ACK_CONFIG;
+  ack.seq_num = frame.config.config_id;
+  ack.status = status;
+  sendFrame(PKT_ACK, &ack, sizeof(ack));
+}
 
-void drawProgressBar(int x, int y, int w, int h, int percent) {
-  display.drawRect(x, y, w, h, SSD1306_WHITE);
-  int fillWidth = (w - 4) * constrain(percent, 0, 100) / 100;
-  display.fillRect(x + 2, y + 2, fillWidth, h - 4, SSD1306_WHITE);
+// ===== Deferred Log Output =====
+
+// Records drained per loop iteration (binary frames are 15-31 bytes)
+const int DLOG_FLUSH_PER_LOOP = 16;
+
+void dlogSink(const uint8_t *data, size_t len) {
+  Serial.write(data, len);
+}
+
+// ===== OLED Status Screen =====
+
+// Minimum time between screen refreshes (sampling is unaffected)
+#define UI_REFRESH_MS 200
+
+// The gyro reads rad/s; the screen shows deg/s
+#define GYRO_DEG_PER_RAD 57.29578f
+
+int uiAccel[3], uiGyro[3], uiTemp;
+int uiStatus, uiSeverity, uiSeverityBar;
+int uiSent, uiErrors;
+
+void buildStatusScreen() {
+  oled_ui_init(UI_REFRESH_MS);
+  oled_ui_clear();
+  
+  oled_ui_add_label(0, 0, 128, "=== WEARABLE ===");
+  oled_ui_add_label(0, 8, 24, "Acc");
+  oled_ui_add_label(0, 16, 24, "Gyr");
+  oled_ui_add_label(0, 24, 24, "Tmp");
+  // Whole m/s^2 and deg/s: up to -157 (16 g) and -2000 (full scale) fit the 5-character fields
+  for (int i = 0; i < 3; i++) {
+    uiAccel[i] = oled_ui_add_number(24 + i * 36, 8, 32, "%5.0f", 1.0f);
+    uiGyro[i] = oled_ui_add_number(24 + i * 36, 16, 32, "%5.0f", 1.0f);
+  }
+  uiTemp = oled_ui_add_number(24, 24, 48, "%.1f C", 0.1f);
+  
+  oled_ui_add_label(0, 40, 48, "Status:");
+  uiStatus = oled_ui_add_label(48, 40, 80, "Waiting...");
+  uiSeverity = oled_ui_add_number(0, 48, 68, "Sev: %.0f%%", 1.0f);
+  uiSeverityBar = oled_ui_add_bar(72, 48, 56, 8);
+  oled_ui_set_visible(uiSeverity, false);
+  oled_ui_set_visible(uiSeverityBar, false);
+  
+  uiSent = oled_ui_add_counter(0, 56, 72, "Sent:%lu");
+  uiErrors = oled_ui_add_counter(72, 56, 56, "Err:%lu");
 }
 
 // ===== Setup =====
@@ -225,61 +385,76 @@ void setup() {
   Wire.begin(OLED_SDA, OLED_SCL);
   
   // Initialize OLED
-  if (!display.begin(SSD1306_SWITCHCAPVCC, OLED_ADDR)) {
+  if (!oled_init()) {
     Serial.println("[OLED] Initialization failed!");
     while (1) delay(1000);
   }
   
-  display.clearDisplay();
-  display.setTextSize(1);
-  display.setTextColor(SSD1306_WHITE);
-  display.setCursor(0, 0);
-  display.println("FallGuys Wearable");
-  display.println("Initializing...");
-  display.display();
+  oled_clear();
+  oled_set_text_size(OLED_TEXT_SIZE_SMALL);
+  oled_set_cursor(0, 0);
+  oled_println("FallGuys Wearable");
+  oled_println("Initializing...");
+  oled_display();
   delay(500);
   
   // Initialize MPU-6050
-  if (!mpu.begin()) {
+  if (!mpu6050_init()) {
     Serial.println("[MPU6050] Initialization failed!");
-    display.clearDisplay();
-    display.setCursor(0, 0);
-    display.println("MPU6050 FAIL");
-    display.println("Check wiring:");
-    display.println("SDA -> GPIO21");
-    display.println("SCL -> GPIO22");
-    display.display();
+    oled_clear();
+    oled_set_cursor(0, 0);
+    oled_println("MPU6050 FAIL");
+    oled_println("Check wiring:");
+    oled_println("SDA -> GPIO21");
+    oled_println("SCL -> GPIO22");
+    oled_display();
     while (1) delay(1000);
   }
   
-  // Configure MPU-6050
-  mpu.setAccelerometerRange(MPU6050_RANGE_8_G);
-  mpu.setGyroRange(MPU6050_RANGE_500_DEG);
-  mpu.setFilterBandwidth(MPU6050_BAND_21_HZ);
-  
   Serial.println("[MPU6050] Initialized successfully");
   
+  // Stream only while the wearer moves; summaries while still
+  activity_gate_init(&activityGate, NULL);
+  
+  // Hub-adjustable settings (CONFIG frames are queued before ESP-NOW starts)
+  wearable_config_defaults(&settings);
+  configQueue = xQueueCreate(CONFIG_QUEUE_DEPTH, sizeof(config_frame_t));
+  timeSyncQueue = xQueueCreate(TIME_SYNC_QUEUE_DEPTH, sizeof(time_sync_t));
+  
+  // Keep the last seconds of samples for FALL_DETECTED bursts
+  mpu6050_config_t imuConfig;
+  mpu6050_get_config(&imuConfig);
+  impact_capture_init(&impactCapture, NULL, imuConfig.rate_hz);
+  
+  // Sample at a fixed rate from a timer-driven task, independent of loop()
+  if (!sampler_start()) {
+    Serial.println("[SAMPLER] Start failed!");
+    while (1) delay(1000);
+  }
+  
   // Initialize ESP-NOW
-  display.clearDisplay();
-  display.setCursor(0, 0);
-  display.println("Initializing");
-  display.println("ESP-NOW...");
-  display.display();
+  oled_clear();
+  oled_set_cursor(0, 0);
+  oled_println("Initializing");
+  oled_println("ESP-NOW...");
+  oled_display();
   
   initESPNow();
   
   Serial.println("[ESP-NOW] Initialized successfully");
   
   // Ready screen
-  display.clearDisplay();
-  display.setCursor(0, 0);
-  display.println("System Ready!");
-  display.println();
-  display.print("MAC: ");
-  display.println(WiFi.macAddress());
-  display.display();
+  oled_clear();
+  oled_set_cursor(0, 0);
+  oled_println("System Ready!");
+  oled_println("");
+  oled_print("MAC: ");
+  oled_println(WiFi.macAddress().c_str());
+  oled_display();
   delay(2000);
   
+  buildStatusScreen();
+  
   Serial.println("\n=== System Ready ===\n");
 }
 
@@ -288,86 +463,186 @@ void setup() {
 void loop() {
   unsigned long now = millis();
   
-  // Read sensors
-  sensors_event_t accel, gyro, temp;
-  mpu.getEvent(&accel, &gyro, &temp);
-  
-  sensorReadCount++;
-  
-  // Prepare sensor data packet
-  sensor_data_t packet;
-  packet.accel_x = accel.acceleration.x;
-  packet.accel_y = accel.acceleration.y;
-  packet.accel_z = accel.acceleration.z;
-  packet.gyro_x = gyro.gyro.x;
-  packet.gyro_y = gyro.gyro.y;
-  packet.gyro_z = gyro.gyro.z;
-  packet.temperature = temp.temperature;
-  packet.timestamp = now;
-  
-  // Send data via ESP-NOW (every 100ms = 10Hz)
-  if (now - lastSendMs >= 100) {
-    esp_err_t result = esp_now_send(HUB_PEER_MAC, (const uint8_t*)&packet, sizeof(packet));
-    
-    if (result != ESP_OK) {
-      Serial.printf("[TX] Send error: %d ", (int)result);
-      if (result == 12396) {
-        Serial.println("(ESP_ERR_ESPNOW_NOT_FOUND - Peer not found!)");
-      } else if (result == 12389) {
-        Serial.println("(ESP_ERR_ESPNOW_NOT_INIT - ESP-NOW not initialized!)");
-      } else if (result == 12394) {
-        Serial.println("(ESP_ERR_ESPNOW_ARG - Invalid argument!)");
-      } else {
-        Serial.println("(Unknown error)");
-      }
-      sendErrorCount++;
-    }
-    
-    lastSendMs = now;
+  // Answer clock sync requests first; the hub measures their turnaround
+  time_sync_t sync;
+  while (xQueueReceive(timeSyncQueue, &sync, 0) == pdTRUE) {
+    replyTimeSync(sync);
   }
   
-  // Update OLED display
-  display.clearDisplay();
-  display.setTextSize(1);
-  display.setCursor(0, 0);
+  // Configuration changes from the hub
+  config_frame_t configFrame;
+  while (xQueueReceive(configQueue, &configFrame, 0) == pdTRUE) {
+    applyConfig(configFrame);
+  }
   
-  // Header
-  display.println("=== WEARABLE ===");
+  // Switch IMU profile on hub state or configuration changes (applied by the
+  // sampling task between two reads)
+  uint8_t hubState = haveReply ? lastFallStatus.state : 0;
+  mpu6050_profile_t wanted = (hubState >= IMPACT_PROFILE_STATE) ? MPU6050_PROFILE_IMPACT
+                                                                : settings.profile;
+  if (wanted != requestedProfile) {
+    sampler_set_profile(wanted);
+    requestedProfile = wanted;
+    Serial.printf("[MPU6050] Profile -> %s\n",
+                  wanted == MPU6050_PROFILE_IMPACT ? "IMPACT" :
+                  wanted == MPU6050_PROFILE_NORMAL ? "NORMAL" : "LOW_POWER");
+  }
   
-  // Sensor readings
-  display.setTextSize(1);
-  display.printf("Accel: %.1f %.1f %.1f\n", packet.accel_x, packet.accel_y, packet.accel_z);
-  display.printf("Gyro:  %.1f %.1f %.1f\n", packet.gyro_x, packet.gyro_y, packet.gyro_z);
-  display.printf("Temp:  %.1f C\n", packet.temperature);
+  // Drain samples taken since the last iteration; the activity gate decides
+  // per sample whether to stream it, send a still-period summary, or nothing
+  sampler_stats_t samplerStats;
+  sampler_get_stats(&samplerStats);
+  impact_capture_set_rate(&impactCapture, samplerStats.rate_hz);
+  
+  int count;
+  while ((count = sampler_read(sampleBatch, SAMPLE_BATCH)) > 0) {
+    int64_t nowUs = esp_timer_get_time();
+    for (int i = 0; i < count; i++) {
+      const sampler_sample_t &s = sampleBatch[i];
+      uint32_t sampleMs = sampleMillis(s, nowUs);
+#ifdef CALIBRATION_DUMP
+      // Raw samples for testing/sensor-calibration (trace format)
+      Serial.printf("%.4f,%.4f,%.4f,%.5f,%.5f,%.5f,%.2f\n",
+                    s.data.accel.x, s.data.accel.y, s.data.accel.z,
+                    s.data.gyro.x, s.data.gyro.y, s.data.gyro.z, s.data.temp.celsius);
+#endif
+      impact_capture_update(&impactCapture, &s.data, sampleMs);
+      switch (activity_gate_update(&activityGate, &s.data, sampleMs)) {
+        case ACTIVITY_SEND_SAMPLE: {
+          sensor_data_t packet;
+          packet.accel_x = s.data.accel.x;
+          packet.accel_y = s.data.accel.y;
+          packet.accel_z = s.data.accel.z;
+          packet.gyro_x = s.data.gyro.x;
+          packet.gyro_y = s.data.gyro.y;
+          packet.gyro_z = s.data.gyro.z;
+          packet.temperature = s.data.temp.celsius;
+          packet.timestamp = sampleMs;
+          sendFrame(PKT_SENSOR_DATA, &packet, sizeof(packet));
+          break;
+        }
+        case ACTIVITY_SEND_SUMMARY: {
+          sensor_summary_t summary;
+          activity_gate_take_summary(&activityGate, &summary);
+          sendFrame(PKT_SENSOR_SUMMARY, &summary, sizeof(summary));
+          break;
+        }
+        default:
+          break;
+      }
+    }
+    latestSample = sampleBatch[count - 1];
+    sensorReadCount += count;
+  }
+  const mpu6050_sample_t &sample = latestSample.data;
   
-  display.println();
+  // Report a captured impact, then upload the window around it
+  if (!fallPending && impact_capture_take_report(&impactCapture, &pendingFall)) {
+    fallPending = true;
+    Serial.printf("[IMPACT] %.2f g, free fall %lu ms, severity %u\n",
+                  pendingFall.impact, (unsigned long)pendingFall.duration, pendingFall.severity);
+  }
+  if (fallPending) {
+    fallPending = !sendFrame(PKT_FALL_DETECTED, &pendingFall, sizeof(pendingFall));
+  }
+  for (int i = 0; !fallPending && i < BURST_CHUNKS_PER_LOOP; i++) {
+    if (burstChunkLen == 0) {
+      burstChunkLen = impact_capture_next_chunk(&impactCapture, &burstChunk);
+      if (burstChunkLen == 0) {
+        break;
+      }
+    }
+    if (!sendFrame(PKT_IMPACT_BURST, &burstChunk, burstChunkLen)) {
+      break;  // Retry this chunk next iteration
+    }
+    burstChunkLen = 0;
+  }
+  
+  // Update OLED status screen (only fields whose shown value changed are redrawn)
+  oled_ui_set_number(uiAccel[0], sample.accel.x);
+  oled_ui_set_number(uiAccel[1], sample.accel.y);
+  oled_ui_set_number(uiAccel[2], sample.accel.z);
+  oled_ui_set_number(uiGyro[0], sample.gyro.x * GYRO_DEG_PER_RAD);
+  oled_ui_set_number(uiGyro[1], sample.gyro.y * GYRO_DEG_PER_RAD);
+  oled_ui_set_number(uiGyro[2], sample.gyro.z * GYRO_DEG_PER_RAD);
+  oled_ui_set_number(uiTemp, sample.temp.celsius);
   
   // Fall detection status
+  bool showSeverity = false;
   if (haveReply) {
     unsigned long replyAge = now - lastReplyMs;
     
-    if (replyAge < 5000) {  // Show if reply is fresh (< 5 seconds old)
+    // Fresh if newer than one summary interval (+5 s); a still wearer only gets replies to summaries
+    if (replyAge < activityGate.config.summary_interval_ms + 5000) {
       uint8_t state_val = lastFallStatus.state;  // Copy volatile to local
-      display.print("Status: ");
-      display.println(STATE_NAMES[min(state_val, (uint8_t)4)]);
+      oled_ui_set_text(uiStatus, STATE_NAMES[min(state_val, (uint8_t)4)]);
       
-      if (lastFallStatus.state >= 2) {  // FALL_SUSPECTED or higher
-        display.printf("Severity: %d%%\n", (lastFallStatus.fall_severity * 100) / 255);
-        drawProgressBar(0, 52, 128, 8, (lastFallStatus.fall_severity * 100) / 255);
+      if (state_val >= 2) {  // FALL_SUSPECTED or higher
+        int severity = (lastFallStatus.fall_severity * 100) / 255;
+        oled_ui_set_number(uiSeverity, severity);
+        oled_ui_set_percent(uiSeverityBar, severity);
+        showSeverity = true;
       }
     } else {
-      display.println("Status: No reply");
+      oled_ui_set_text(uiStatus, "No reply");
     }
   } else {
-    display.println("Status: Waiting...");
+    oled_ui_set_text(uiStatus, "Waiting...");
   }
+  oled_ui_set_visible(uiSeverity, showSeverity);
+  oled_ui_set_visible(uiSeverityBar, showSeverity);
   
   // Statistics at bottom
-  display.setCursor(0, 56);
-  display.printf("Sent:%lu Err:%lu", sensorReadCount, sendErrorCount);
+  oled_ui_set_counter(uiSent, sensorReadCount);
+  oled_ui_set_counter(uiErrors, sendErrorCount);
+  
+  oled_ui_refresh(now);
+  
+  // Timing statistics every 10 s
+  if (now - lastStatsMs >= 10000) {
+    sampler_stats_t ss;
+    oled_stats_t os;
+    oled_ui_stats_t us;
+    activity_stats_t as;
+    impact_stats_t is;
+    dlog_stats_t ls;
+    sampler_get_stats(&ss);
+    dlog_get_stats(&ls);
+    impact_capture_get_stats(&impactCapture, &is);
+    activity_gate_get_stats(&activityGate, &as);
+    oled_get_stats(&os);
+    oled_ui_get_stats(&us);
+    Serial.printf("[STATS] Sampler %lu Hz: %lu samples, %lu overruns, %lu missed, max latency %lu us\n",
+                  (unsigned long)ss.rate_hz, (unsigned long)ss.samples, (unsigned long)ss.ring_overruns,
+                  (unsigned long)ss.missed_ticks, (unsigned long)ss.max_latency_us);
+    Serial.printf("[STATS] OLED: %lu bytes last frame (%lu pages, full frame %u), %lu frames dropped\n",
+                  (unsigned long)os.last_frame_bytes, (unsigned long)os.last_dirty_pages,
+                  (unsigned)OLED_BUFFER_SIZE, (unsigned long)os.frames_dropped);
+    Serial.printf("[STATS] UI: %lu refreshes, %lu widgets drawn, %lu of %lu updates unchanged\n",
+                  (unsigned long)us.refreshes, (unsigned long)us.widgets_drawn,
+                  (unsigned long)us.updates_unchanged, (unsigned long)us.updates);
+    Serial.printf("[STATS] Radio: %lu samples sent, %lu summaries, %lu activations, active %lu s\n",
+                  (unsigned long)as.samples_sent, (unsigned long)as.summaries_sent,
+                  (unsigned long)as.activations, (unsigned long)(as.active_ms / 1000));
+    Serial.printf("[STATS] Impacts: %lu captured, %lu missed, %lu bursts, %lu -> %lu bytes\n",
+                  (unsigned long)is.impacts, (unsigned long)is.impacts_missed,
+                  (unsigned long)is.bursts, (unsigned long)is.raw_bytes, (unsigned long)is.burst_bytes);
+    Serial.printf("[STATS] Log: %lu records, %lu dropped\n",
+                  (unsigned long)ls.written, (unsigned long)ls.dropped);
+    Serial.printf("[STATS] Config: %lu applied, %lu rejected, %lu unknown frames, send interval %lu ms\n",
+                  configCount, configRejectCount, unknownFrameCount,
+                  (unsigned long)settings.send_interval_ms);
+    Serial.printf("[STATS] Clock sync: %lu replies\n", timeSyncCount);
+    lastStatsMs = now;
+  }
   
-  display.display();
+  // Binary records for the host decoder, or text with -DDLOG_TEXT_OUTPUT
+#ifdef DLOG_TEXT_OUTPUT
+  dlog_flush_text(dlogSink, DLOG_FLUSH_PER_LOOP);
+#else
+  dlog_flush(dlogSink, DLOG_FLUSH_PER_LOOP);
+#endif
   
-  // Small delay for ~10Hz loop
+  // Display/radio pacing only; sampling runs on its own timer
   delay(50);
 }
@@ -0,0 +1,74 @@
+// Wearable Config - Runtime settings changed by PKT_CONFIG from the hub
+#include "wearable_config.h"
+#include <string.h>
+
+// CONFIG header: config_id and length
+#define CONFIG_HEADER_SIZE 2
+
+void wearable_config_defaults(wearable_settings_t *settings)
+{
+    settings->profile = MPU6050_PROFILE_NORMAL;
+    settings->send_interval_ms = 100;   // Matches the activity gate default
+    settings->brightness = 0xCF;        // SSD1306 power-on contrast (internal VCC)
+    settings->fall_threshold_g = 2.5f;  // Matches the impact capture default
+}
+
+// Copy a value of exactly 'size' bytes; anything else is malformed
+static bool read_value(const config_t *config, void *out, size_t size)
+{
+    if (config->length != size) {
+        return false;
+    }
+    memcpy(out, config->value, size);
+    return true;
+}
+
+uint8_t wearable_config_apply(wearable_settings_t *settings, const config_t *config, size_t len)
+{
+    if (len < CONFIG_HEADER_SIZE || len < CONFIG_HEADER_SIZE + (size_t)config->length) {
+        return ACK_STATUS_INVALID;
+    }
+
+    switch (config->config_id) {
+    case CFG_SAMPLING_RATE: {
+        uint32_t rate_hz;
+        if (!read_value(config, &rate_hz, sizeof(rate_hz)) || rate_hz == 0) {
+            return ACK_STATUS_INVALID;
+        }
+        settings->profile = mpu6050_profile_for_rate(rate_hz);
+        return ACK_STATUS_OK;
+    }
+    case CFG_IMU_PROFILE: {
+        uint8_t profile;
+        if (!read_value(config, &profile, sizeof(profile)) || profile >= MPU6050_PROFILE_COUNT) {
+            return ACK_STATUS_INVALID;
+        }
+        settings->profile = (mpu6050_profile_t)profile;
+        return ACK_STATUS_OK;
+    }
+    case CFG_SEND_INTERVAL: {
+        uint32_t interval_ms;
+        if (!read_value(config, &interval_ms, sizeof(interval_ms)) ||
+            interval_ms < WEARABLE_SEND_INTERVAL_MIN_MS || interval_ms > WEARABLE_SEND_INTERVAL_MAX_MS) {
+            return ACK_STATUS_INVALID;
+        }
+        settings->send_interval_ms = interval_ms;
+        return ACK_STATUS_OK;
+    }
+    case CFG_DISPLAY_BRIGHTNESS:
+        return read_value(config, &settings->brightness, sizeof(settings->brightness))
+                   ? ACK_STATUS_OK : ACK_STATUS_INVALID;
+    case CFG_FALL_THRESHOLD: {
+        float threshold_g;
+        if (!read_value(config, &threshold_g, sizeof(threshold_g)) ||
+            !(threshold_g >= WEARABLE_THRESHOLD_MIN_G && threshold_g <= WEARABLE_THRESHOLD_MAX_G)) {
+            return ACK_STATUS_INVALID;
+        }
+        settings->fall_threshold_g = threshold_g;
+        return ACK_STATUS_OK;
+    }
+    default:
+        // CFG_ALERT_TIMEOUT is enforced by the hub
+        return ACK_STATUS_UNSUPPORTED;
+    }
+}
@@ -0,0 +1,45 @@
+// Wearable Config - Runtime settings changed by PKT_CONFIG from the hub
+// The hub throttles or boosts each wearable by sending CONFIG frames; each
+// one is validated here and answered with an ACK_CONFIG carrying the
+// ACK_STATUS_xxx returned by wearable_config_apply(). The caller compares the
+// settings before and after and pushes changes to the sampler, activity gate,
+// impact capture and display.
+
+#ifndef _WEARABLE_CONFIG_H_
+#define _WEARABLE_CONFIG_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "hal/mpu6050.h"
+#include "protocol.h"
+
+// Accepted ranges
+#define WEARABLE_SEND_INTERVAL_MIN_MS   10
+#define WEARABLE_SEND_INTERVAL_MAX_MS   60000
+#define WEARABLE_THRESHOLD_MIN_G        1.5f
+#define WEARABLE_THRESHOLD_MAX_G        16.0f
+
+// Settings the hub may change
+typedef struct {
+    mpu6050_profile_t profile;      // IMU profile while the hub sees no fall
+    uint32_t send_interval_ms;      // SENSOR_DATA period while active
+    uint8_t brightness;             // OLED contrast
+    float fall_threshold_g;         // Impact capture trigger
+} wearable_settings_t;
+
+/**
+ * Fill in the power-on settings
+ * @param settings Settings to initialize
+ */
+void wearable_config_defaults(wearable_settings_t *settings);
+
+/**
+ * Validate one CONFIG payload and apply it to the settings
+ * @param settings Settings to update (unchanged unless ACK_STATUS_OK)
+ * @param config CONFIG payload
+ * @param len Payload bytes received
+ * @return ACK_STATUS_xxx to send back in the ACK_CONFIG
+ */
+uint8_t wearable_config_apply(wearable_settings_t *settings, const config_t *config, size_t len);
+
+#endif // _WEARABLE_CONFIG_H_